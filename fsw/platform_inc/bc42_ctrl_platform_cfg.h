@@ -46,6 +46,13 @@
 #define BC42_CTRL_PLATFORM_REV   0
 #define BC42_CTRL_INI_FILENAME   "/cf/bc42_ctrl_ini.json"
 
+/*
+** Control cycle messages are built directly in software bus buffers and
+** sent with CFE_SB_TransmitBuffer() when set to 1. Set to 0 to build them
+** in app memory and send copies with CFE_SB_TransmitMsg().
+*/
+#define BC42_CTRL_SB_ZERO_COPY   1
+
 
 #endif /* _bc42_ctrl_platform_cfg_ */
 
@@ -59,10 +59,21 @@
 #define CFG_APP_CMD_PIPE_NAME   APP_CMD_PIPE_NAME
 #define CFG_APP_CMD_PIPE_DEPTH  APP_CMD_PIPE_DEPTH
 
+#define CFG_APP_SENSOR_PIPE_NAME     APP_SENSOR_PIPE_NAME
+#define CFG_APP_SENSOR_PIPE_DEPTH    APP_SENSOR_PIPE_DEPTH
+#define CFG_APP_SENSOR_PIPE_TIMEOUT  APP_SENSOR_PIPE_TIMEOUT   // Milliseconds, bounds command latency when no sensor data is arriving
+
+#define CFG_APP_SENSOR_BACKLOG_POLICY  APP_SENSOR_BACKLOG_POLICY  // SensorBacklogPolicy enumeration label, see bc42_ctrl.xml
+#define CFG_APP_SENSOR_CATCHUP_MAX     APP_SENSOR_CATCHUP_MAX     // Max control cycles per wakeup for BOUNDED_CATCHUP
+
 #define CFG_BC42_CTRL_CMD_TOPICID               BC42_CTRL_CMD_TOPICID
 #define CFG_BC42_CTRL_STATUS_TLM_TOPICID        BC42_CTRL_STATUS_TLM_TOPICID
 #define CFG_BC42_CTRL_CONTROLLER_TLM_TOPICID    BC42_CTRL_CONTROLLER_TLM_TOPICID
 #define CFG_BC42_CTRL_CONTROL_GAINS_TLM_TOPICID BC42_CTRL_CONTROL_GAINS_TLM_TOPICID
+#define CFG_BC42_CTRL_LATENCY_TLM_TOPICID       BC42_CTRL_LATENCY_TLM_TOPICID
+#define CFG_BC42_CTRL_TIMING_TLM_TOPICID        BC42_CTRL_TIMING_TLM_TOPICID
+#define CFG_BC42_CTRL_PERIOD_TLM_TOPICID        BC42_CTRL_PERIOD_TLM_TOPICID
+#define CFG_BC42_CTRL_CONTROLLER_STATS_TLM_TOPICID BC42_CTRL_CONTROLLER_STATS_TLM_TOPICID
 #define CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID   BC42_INTF_SENSOR_DATA_MSG_TOPICID
 #define CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID  BC42_INTF_ACTUATOR_CMD_MSG_TOPICID
 #define CFG_BC42_SEND_STATUS_TLM_TOPICID        BC_SCH_1_HZ_TOPICID                // Use different CFG_ name instead of BC_SCH_*_TOPICID to localize impact if rate changes
@@ -70,27 +81,105 @@
 #define CFG_CTRL42_TAKE_SCI_INIT_CYC  CTRL42_TAKE_SCI_INIT_CYC   // Number of control cycles before start computing take science flag
 #define CFG_CTRL42_TAKE_SCI_TRANS_CYC CTRL42_TAKE_SCI_TRANS_CYC  // Number of control cycles for new value to be considered steady state for a transition
 
+#define CFG_CTRL42_LATENCY_BIN_WIDTH  CTRL42_LATENCY_BIN_WIDTH  // Microseconds per sensor-to-actuator latency histogram bin
+#define CFG_CTRL42_PHASE_PERF_ID_BASE CTRL42_PHASE_PERF_ID_BASE // First of the consecutive control cycle phase performance IDs
+#define CFG_CTRL42_NOMINAL_PERIOD     CTRL42_NOMINAL_PERIOD     // Microseconds between control cycles
+#define CFG_CTRL42_CTRL_TLM_DECIM     CTRL42_CTRL_TLM_DECIM     // Controller telemetry decimation factor, 1 sends every cycle
+#define CFG_CTRL42_INIT_MODE          CTRL42_INIT_MODE          // ControlMode enumeration label, see bc42_ctrl.xml
+#define CFG_CTRL42_CTRL_LAW           CTRL42_CTRL_LAW           // Registered control law name, see ctrl_law.h
+#define CFG_CTRL42_SENSOR_STALE_LIM   CTRL42_SENSOR_STALE_LIM   // Microseconds a sensor data message can age before it's rejected, 0 disables
+#define CFG_CTRL42_SENSOR_RESYNC_LIM  CTRL42_SENSOR_RESYNC_LIM  // Consecutive duplicate or out of order sensor data messages before the next one resyncs the checks, 0 disables
+#define CFG_CTRL42_SENSOR_RESYNC_JUMP CTRL42_SENSOR_RESYNC_JUMP // Seconds a sensor data message time can go backwards before it resyncs the checks, 0 disables
+#define CFG_CTRL42_DEADLINE           CTRL42_DEADLINE           // Microseconds from the start of a control cycle to its actuator command deadline, 0 disables
+#define CFG_CTRL42_DEADLINE_AT_RISK   CTRL42_DEADLINE_AT_RISK   // Microseconds from the start of a control cycle before optional work is shed
+
 #define CFG_CTRL42_DEBUG_FILE      CTRL42_DEBUG_FILE
+
+#define CFG_DEBUG_LOG_CHILD_NAME        DEBUG_LOG_CHILD_NAME
+#define CFG_DEBUG_LOG_CHILD_STACK_SIZE  DEBUG_LOG_CHILD_STACK_SIZE
+#define CFG_DEBUG_LOG_CHILD_PRIORITY    DEBUG_LOG_CHILD_PRIORITY   // Should be lower than the app's priority
+#define CFG_DEBUG_LOG_CHILD_PERF_ID     DEBUG_LOG_CHILD_PERF_ID
+#define CFG_DEBUG_LOG_FLUSH_PERIOD      DEBUG_LOG_FLUSH_PERIOD     // Milliseconds between debug log record buffer flushes
+
+#define CFG_DEADLINE_MON_CHILD_NAME        DEADLINE_MON_CHILD_NAME
+#define CFG_DEADLINE_MON_CHILD_STACK_SIZE  DEADLINE_MON_CHILD_STACK_SIZE
+#define CFG_DEADLINE_MON_CHILD_PRIORITY    DEADLINE_MON_CHILD_PRIORITY   // Must be higher than the app's priority, i.e. a lower number than bc42_ctrl.json's, see deadline_mon.h
+#define CFG_DEADLINE_MON_CHILD_PERF_ID     DEADLINE_MON_CHILD_PERF_ID
+
+#define CFG_TRACE_REC_FILE              TRACE_REC_FILE             // Default sensor trace file
+#define CFG_TRACE_REC_CHILD_NAME        TRACE_REC_CHILD_NAME
+#define CFG_TRACE_REC_CHILD_STACK_SIZE  TRACE_REC_CHILD_STACK_SIZE
+#define CFG_TRACE_REC_CHILD_PRIORITY    TRACE_REC_CHILD_PRIORITY   // Should be lower than the app's priority
+#define CFG_TRACE_REC_CHILD_PERF_ID     TRACE_REC_CHILD_PERF_ID
+#define CFG_TRACE_REC_FLUSH_PERIOD      TRACE_REC_FLUSH_PERIOD     // Milliseconds between sensor trace record buffer flushes
+
+#define CFG_TBL_CHILD_NAME         TBL_CHILD_NAME
+#define CFG_TBL_CHILD_STACK_SIZE   TBL_CHILD_STACK_SIZE
+#define CFG_TBL_CHILD_PRIORITY     TBL_CHILD_PRIORITY   // Should be lower than the app's priority
+#define CFG_TBL_CHILD_PERF_ID      TBL_CHILD_PERF_ID
 #define CFG_CTRL42_TBL_LOAD_FILE   CTRL42_TBL_LOAD_FILE
 #define CFG_CTRL42_TBL_DUMP_FILE   CTRL42_TBL_DUMP_FILE
+#define CFG_FAULT_INJ_TBL_LOAD_FILE  FAULT_INJ_TBL_LOAD_FILE
+#define CFG_FAULT_INJ_TBL_DUMP_FILE  FAULT_INJ_TBL_DUMP_FILE
 
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
    XX(APP_PERF_ID,uint32) \
    XX(APP_CMD_PIPE_NAME,char*) \
    XX(APP_CMD_PIPE_DEPTH,uint32) \
+   XX(APP_SENSOR_PIPE_NAME,char*) \
+   XX(APP_SENSOR_PIPE_DEPTH,uint32) \
+   XX(APP_SENSOR_PIPE_TIMEOUT,uint32) \
+   XX(APP_SENSOR_BACKLOG_POLICY,char*) \
+   XX(APP_SENSOR_CATCHUP_MAX,uint32) \
    XX(BC42_CTRL_CMD_TOPICID,uint32) \
    XX(BC42_CTRL_STATUS_TLM_TOPICID,uint32) \
    XX(BC42_CTRL_CONTROLLER_TLM_TOPICID,uint32) \
    XX(BC42_CTRL_CONTROL_GAINS_TLM_TOPICID,uint32) \
+   XX(BC42_CTRL_LATENCY_TLM_TOPICID,uint32) \
+   XX(BC42_CTRL_TIMING_TLM_TOPICID,uint32) \
+   XX(BC42_CTRL_PERIOD_TLM_TOPICID,uint32) \
+   XX(BC42_CTRL_CONTROLLER_STATS_TLM_TOPICID,uint32) \
    XX(BC42_INTF_SENSOR_DATA_MSG_TOPICID,uint32) \
    XX(BC42_INTF_ACTUATOR_CMD_MSG_TOPICID,uint32) \
    XX(BC_SCH_1_HZ_TOPICID,uint32) \
    XX(CTRL42_TAKE_SCI_INIT_CYC,uint32) \
    XX(CTRL42_TAKE_SCI_TRANS_CYC,uint32) \
+   XX(CTRL42_LATENCY_BIN_WIDTH,uint32) \
+   XX(CTRL42_PHASE_PERF_ID_BASE,uint32) \
+   XX(CTRL42_NOMINAL_PERIOD,uint32) \
+   XX(CTRL42_CTRL_TLM_DECIM,uint32) \
+   XX(CTRL42_INIT_MODE,char*) \
+   XX(CTRL42_CTRL_LAW,char*) \
+   XX(CTRL42_SENSOR_STALE_LIM,uint32) \
+   XX(CTRL42_SENSOR_RESYNC_LIM,uint32) \
+   XX(CTRL42_SENSOR_RESYNC_JUMP,uint32) \
+   XX(CTRL42_DEADLINE,uint32) \
+   XX(CTRL42_DEADLINE_AT_RISK,uint32) \
    XX(CTRL42_DEBUG_FILE,char*) \
+   XX(DEBUG_LOG_CHILD_NAME,char*) \
+   XX(DEBUG_LOG_CHILD_STACK_SIZE,uint32) \
+   XX(DEBUG_LOG_CHILD_PRIORITY,uint32) \
+   XX(DEBUG_LOG_CHILD_PERF_ID,uint32) \
+   XX(DEBUG_LOG_FLUSH_PERIOD,uint32) \
+   XX(DEADLINE_MON_CHILD_NAME,char*) \
+   XX(DEADLINE_MON_CHILD_STACK_SIZE,uint32) \
+   XX(DEADLINE_MON_CHILD_PRIORITY,uint32) \
+   XX(DEADLINE_MON_CHILD_PERF_ID,uint32) \
+   XX(TRACE_REC_FILE,char*) \
+   XX(TRACE_REC_CHILD_NAME,char*) \
+   XX(TRACE_REC_CHILD_STACK_SIZE,uint32) \
+   XX(TRACE_REC_CHILD_PRIORITY,uint32) \
+   XX(TRACE_REC_CHILD_PERF_ID,uint32) \
+   XX(TRACE_REC_FLUSH_PERIOD,uint32) \
+   XX(TBL_CHILD_NAME,char*) \
+   XX(TBL_CHILD_STACK_SIZE,uint32) \
+   XX(TBL_CHILD_PRIORITY,uint32) \
+   XX(TBL_CHILD_PERF_ID,uint32) \
    XX(CTRL42_TBL_LOAD_FILE,char*) \
    XX(CTRL42_TBL_DUMP_FILE,char*) \
+   XX(FAULT_INJ_TBL_LOAD_FILE,char*) \
+   XX(FAULT_INJ_TBL_DUMP_FILE,char*) \
     
 
 DECLARE_ENUM(Config,APP_CONFIG)
@@ -107,6 +196,15 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define BC42_CTRL_BASE_EID   (APP_C_FW_APP_BASE_EID +  0)
 #define CTRL42_BASE_EID      (APP_C_FW_APP_BASE_EID + 20)
 #define CTRL42_TBL_BASE_EID  (APP_C_FW_APP_BASE_EID + 40)
+#define LATENCY_MON_BASE_EID (APP_C_FW_APP_BASE_EID + 60)
+#define CTRL_STATS_BASE_EID  (APP_C_FW_APP_BASE_EID + 80)
+#define DEBUG_LOG_BASE_EID   (APP_C_FW_APP_BASE_EID + 100)
+#define TRACE_REC_BASE_EID   (APP_C_FW_APP_BASE_EID + 120)
+#define JSON_STREAM_BASE_EID (APP_C_FW_APP_BASE_EID + 140)
+#define CTRL_LAW_BASE_EID    (APP_C_FW_APP_BASE_EID + 160)
+#define FAULT_INJ_BASE_EID   (APP_C_FW_APP_BASE_EID + 180)
+#define SENSOR_CHK_BASE_EID  (APP_C_FW_APP_BASE_EID + 200)
+#define DEADLINE_MON_BASE_EID (APP_C_FW_APP_BASE_EID + 220)
 
 
 /*
@@ -121,16 +219,90 @@ DECLARE_ENUM(Config,APP_CONFIG)
 //#define BC42_CTRL_INIT_EVS_TYPE CFE_EVS_INFORMATION
 
 
+/******************************************************************************
+** BC42_CTRL App Configurations
+*/
+
+#define BC42_CTRL_TBL_STATUS_CNT  4   /* Power of 2. Table command results the table child task can queue for the app */
+
+
 /******************************************************************************
 ** CTRL42 Configurations
 */
 
+#define BC42_NWHL  4  // TODO: Figure out good way to use 42 configuration that is defined in 42 text script
+
+
+/******************************************************************************
+** CTRL_LAW Configurations
+*/
+
+#define CTRL_LAW_DOUBLE   1   /* 1 runs the control laws in double precision, 0 in float */
+#define CTRL_LAW_REG_MAX  8   /* Registered control laws including the built-in laws */
+
+/* Body frame spin axis of each of the BC42_NWHL wheels */
+#define CTRL_LAW_WHL_AXES  { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 }, { 0.57735, 0.57735, 0.57735 } }
+
+
+/******************************************************************************
+** LATENCY_MON Configurations
+*/
+
+#define LATENCY_MON_BIN_CNT  16   /* Must match LatencyBins dimension in bc42_ctrl.xml */
+
+
+/******************************************************************************
+** PERIOD_MON Configurations
+*/
+
+#define PERIOD_MON_WORST_CNT  4   /* Must match PeriodEvents dimension in bc42_ctrl.xml */
+
+
+/******************************************************************************
+** DEBUG_LOG Configurations
+*/
+
+#define DEBUG_LOG_REC_CNT  256   /* Power of 2. Must hold more than one flush period of control cycles */
+
+
+/******************************************************************************
+** DEADLINE_MON Configurations
+*/
+
+#define DEADLINE_MON_RECOVER_CYC  50   /* Consecutive cycles that aren't at risk before the shed level is lowered */
+
+
+/******************************************************************************
+** TRACE_REC Configurations
+*/
+
+#define TRACE_REC_REC_CNT        64    /* Power of 2. Must hold more than one flush period of sensor messages */
+#define TRACE_REC_CHUNK_REC_CNT  100   /* Records per trace file chunk, one time index entry per chunk */
+
+
+/******************************************************************************
+** JSON_STREAM Configurations
+*/
+
+#define JSON_STREAM_READ_LEN   256   /* Bytes read from a table file at a time */
+#define JSON_STREAM_PATH_LEN   96    /* Longest dotted key path plus the terminator */
+#define JSON_STREAM_TOKEN_LEN  128   /* Longest string or number value plus the terminator */
+#define JSON_STREAM_DEPTH_MAX  8     /* Nested objects and arrays */
+
 
 /******************************************************************************
 ** CTRL42 Table Configurations
 */
 
-#define CTRL42_TBL_JSON_FILE_MAX_CHAR  4090 
 #define CTRL42_TBL_NAME                "Control Parameters" 
+#define CTRL42_TBL_SCHED_PT_MAX        64   /* Gain schedule breakpoints */
+
+
+/******************************************************************************
+** FAULT_INJ Configurations
+*/
+
+#define FAULT_INJ_TBL_NAME        "Fault Injection Script"
+#define FAULT_INJ_ENTRY_MAX       256   /* Script entries */
 
 #endif /* _app_cfg_ */
@@ -38,7 +38,16 @@
 #define  INITBL_OBJ   (&(Bc42Ctrl.IniTbl))
 #define  CMDMGR_OBJ   (&(Bc42Ctrl.CmdMgr))
 #define  TBLMGR_OBJ   (&(Bc42Ctrl.TblMgr))
-#define  CTRL42_OBJ   (&(Bc42Ctrl.Ctrl42))
+#define  TBL_CHILDMGR_OBJ (&(Bc42Ctrl.TblChildMgr))
+#define  TBL_CHILD_TBLMGR_OBJ (&(Bc42Ctrl.TblChildTblMgr))
+#define  CTRL42_OBJ       (&(Bc42Ctrl.Ctrl42))
+#define  LATENCY_MON_OBJ  (&(Bc42Ctrl.Ctrl42.LatencyMon))
+#define  CYCLE_PROF_OBJ   (&(Bc42Ctrl.Ctrl42.CycleProf))
+#define  PERIOD_MON_OBJ   (&(Bc42Ctrl.Ctrl42.PeriodMon))
+#define  CTRL_STATS_OBJ   (&(Bc42Ctrl.Ctrl42.CtrlStats))
+#define  DEBUG_LOG_OBJ    (&(Bc42Ctrl.DebugLog))
+#define  TRACE_REC_OBJ    (&(Bc42Ctrl.TraceRec))
+#define  DEADLINE_WATCHDOG_OBJ (&(Bc42Ctrl.DeadlineWatchdog))
 
 
 /*******************************/
@@ -46,7 +55,13 @@
 /*******************************/
 
 static int32 InitApp(void);
+static bool  ChildDumpTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+static bool  ChildLoadTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+static void  PushTblStatus(const TBLMGR_Class_t *TblMgr);
+static void  ProcessTblStatus(void);
 static int32 ProcessCmdPipe(void);
+static bool ProcessSensorPipe(int32 Timeout);
+static void SetSensorBacklogPolicy(const char *PolicyStr, uint32 CatchupMax);
 static void SendStatusTlmMsg(void);
 
 
@@ -60,6 +75,12 @@ static void SendStatusTlmMsg(void);
 */
 DEFINE_ENUM(Config,APP_CONFIG)  
 
+/* Must match SensorBacklogPolicy enumeration order in bc42_ctrl.xml */
+static const char *SensorBacklogPolicyStr[] =
+{
+   "PROCESS_ALL", "NEWEST_ONLY", "BOUNDED_CATCHUP"
+};
+
 static CFE_EVS_BinFilter_t  EventFilters[] =
 {  
    /* Event ID                           Mask */
@@ -140,14 +161,56 @@ bool BC42_CTRL_ResetAppCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 
    CMDMGR_ResetStatus(CMDMGR_OBJ);
    TBLMGR_ResetStatus(TBLMGR_OBJ);
+   CHILDMGR_ResetStatus(TBL_CHILDMGR_OBJ);
 
-   CTRL42_ResetStatus();
+   Bc42Ctrl.SensorDroppedCnt   = 0;
+   Bc42Ctrl.SensorCoalescedCnt = 0;
+
+   CTRL42_ResetStatus(CTRL42_OBJ);
 	  
    return true;
 
 } /* End BC42_CTRL_ResetAppCmd() */
 
 
+/******************************************************************************
+** Function: ChildDumpTblCmd
+**
+** Table child task wrapper for TBLMGR_DumpTblCmd(). ObjDataPtr is the table
+** child task's table manager.
+**
+*/
+static bool ChildDumpTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool RetStatus = TBLMGR_DumpTblCmd(ObjDataPtr, MsgPtr);
+
+   PushTblStatus((const TBLMGR_Class_t *)ObjDataPtr);
+
+   return RetStatus;
+
+} /* End ChildDumpTblCmd() */
+
+
+/******************************************************************************
+** Function: ChildLoadTblCmd
+**
+** Table child task wrapper for TBLMGR_LoadTblCmd(). ObjDataPtr is the table
+** child task's table manager.
+**
+*/
+static bool ChildLoadTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool RetStatus = TBLMGR_LoadTblCmd(ObjDataPtr, MsgPtr);
+
+   PushTblStatus((const TBLMGR_Class_t *)ObjDataPtr);
+
+   return RetStatus;
+
+} /* End ChildLoadTblCmd() */
+
+
 /******************************************************************************
 ** Function: InitApp
 **
@@ -156,6 +219,8 @@ static int32 InitApp(void)
 {
 
    int32 RetStatus = APP_C_FW_CFS_ERROR;
+   int32  CfeStatus;
+   CHILDMGR_TaskInit_t TblChildTaskInit;
 
    CFE_PSP_MemSet((void*)&Bc42Ctrl, 0, sizeof(BC42_CTRL_APP_Class_t));
  
@@ -167,6 +232,9 @@ static int32 InitApp(void)
    {
       
       Bc42Ctrl.PerfId = INITBL_GetIntConfig(INITBL_OBJ, APP_PERF_ID);  
+      Bc42Ctrl.SensorPipeTimeout = INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_SENSOR_PIPE_TIMEOUT);
+      SetSensorBacklogPolicy(INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_SENSOR_BACKLOG_POLICY),
+                             INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_SENSOR_CATCHUP_MAX));
 
       Bc42Ctrl.CmdMid            = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_CTRL_CMD_TOPICID));
       Bc42Ctrl.StatusTlmMid      = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_CTRL_STATUS_TLM_TOPICID));
@@ -179,7 +247,11 @@ static int32 InitApp(void)
       /*
       ** Initialize objects 
       */
-      CTRL42_Constructor(CTRL42_OBJ, INITBL_OBJ, TBLMGR_OBJ);
+      DEBUG_LOG_Constructor(DEBUG_LOG_OBJ, INITBL_OBJ);
+      DEADLINE_MON_WatchdogConstructor(DEADLINE_WATCHDOG_OBJ, INITBL_OBJ);
+      CTRL42_Constructor(CTRL42_OBJ, INITBL_OBJ, TBLMGR_OBJ, DEBUG_LOG_OBJ);
+      FAULT_INJ_Register(TBLMGR_OBJ, INITBL_GetStrConfig(INITBL_OBJ, CFG_FAULT_INJ_TBL_LOAD_FILE));
+      TRACE_REC_Constructor(TRACE_REC_OBJ, INITBL_OBJ);
  
       /*
       ** Initialize app level interfaces
@@ -187,20 +259,63 @@ static int32 InitApp(void)
       CFE_SB_CreatePipe(&Bc42Ctrl.CmdPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_DEPTH), INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_CMD_PIPE_NAME));
       CFE_SB_Subscribe(Bc42Ctrl.CmdMid, Bc42Ctrl.CmdPipe);
       CFE_SB_Subscribe(Bc42Ctrl.SendStatusTlmMid, Bc42Ctrl.CmdPipe);
-      CFE_SB_Subscribe(Bc42Ctrl.SensorDataMsgMid, Bc42Ctrl.CmdPipe);
+
+      CFE_SB_CreatePipe(&Bc42Ctrl.SensorPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_APP_SENSOR_PIPE_DEPTH), INITBL_GetStrConfig(INITBL_OBJ, CFG_APP_SENSOR_PIPE_NAME));
+      CFE_SB_Subscribe(Bc42Ctrl.SensorDataMsgMid, Bc42Ctrl.SensorPipe);
          
       CMDMGR_Constructor(CMDMGR_OBJ);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_NOOP_CC,           NULL, BC42_CTRL_NoOpCmd,     0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_RESET_CC,          NULL, BC42_CTRL_ResetAppCmd, 0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_LOAD_TBL_CC, TBLMGR_OBJ, TBLMGR_LoadTblCmd,     sizeof(BC42_CTRL_LoadTbl_CmdPayload_t));
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_DUMP_TBL_CC, TBLMGR_OBJ, TBLMGR_DumpTblCmd,     sizeof(BC42_CTRL_DumpTbl_CmdPayload_t));
+
+      /*
+      ** Table file I/O, JSON parsing and dump formatting run in a low priority
+      ** child task so a table command never delays a control cycle. Accepted
+      ** loads are committed by the controller at its next cycle boundary. If
+      ** the child task can't be created the commands run in the app task.
+      **
+      ** The child task runs the TBLMGR commands on its own copy of the table
+      ** manager, made after every table is registered, so it never writes
+      ** the app's table status. Each command's result is queued and the app
+      ** task copies it into TBLMGR_OBJ between control cycles.
+      */
+      TblChildTaskInit.TaskName  = INITBL_GetStrConfig(INITBL_OBJ, CFG_TBL_CHILD_NAME);
+      TblChildTaskInit.StackSize = INITBL_GetIntConfig(INITBL_OBJ, CFG_TBL_CHILD_STACK_SIZE);
+      TblChildTaskInit.Priority  = INITBL_GetIntConfig(INITBL_OBJ, CFG_TBL_CHILD_PRIORITY);
+      TblChildTaskInit.PerfId    = INITBL_GetIntConfig(INITBL_OBJ, CFG_TBL_CHILD_PERF_ID);
+
+      memcpy(TBL_CHILD_TBLMGR_OBJ, TBLMGR_OBJ, sizeof(TBLMGR_Class_t));
+      SPSC_RING_Constructor(&Bc42Ctrl.TblStatusRing, Bc42Ctrl.TblStatusBuf,
+                            sizeof(BC42_CTRL_TblStatus_t), BC42_CTRL_TBL_STATUS_CNT);
+
+      CfeStatus = CHILDMGR_Constructor(TBL_CHILDMGR_OBJ, ChildMgr_TaskMainCmdDispatch, NULL, &TblChildTaskInit);
+
+      if (CfeStatus == CFE_SUCCESS)
+      {
+         CHILDMGR_RegisterFunc(TBL_CHILDMGR_OBJ, BC42_CTRL_LOAD_TBL_CC, TBL_CHILD_TBLMGR_OBJ, ChildLoadTblCmd);
+         CHILDMGR_RegisterFunc(TBL_CHILDMGR_OBJ, BC42_CTRL_DUMP_TBL_CC, TBL_CHILD_TBLMGR_OBJ, ChildDumpTblCmd);
+         CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_LOAD_TBL_CC, TBL_CHILDMGR_OBJ, CHILDMGR_InvokeChildCmd, sizeof(BC42_CTRL_LoadTbl_CmdPayload_t));
+         CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_DUMP_TBL_CC, TBL_CHILDMGR_OBJ, CHILDMGR_InvokeChildCmd, sizeof(BC42_CTRL_DumpTbl_CmdPayload_t));
+      }
+      else
+      {
+         CFE_EVS_SendEvent(BC42_CTRL_TBL_CHILD_TASK_EID, CFE_EVS_EventType_ERROR,
+                           "Table child task %s creation failed, status 0x%08X. Table commands will run in the app task",
+                           TblChildTaskInit.TaskName, (unsigned int)CfeStatus);
+         CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_LOAD_TBL_CC, TBLMGR_OBJ, TBLMGR_LoadTblCmd, sizeof(BC42_CTRL_LoadTbl_CmdPayload_t));
+         CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_DUMP_TBL_CC, TBLMGR_OBJ, TBLMGR_DumpTblCmd, sizeof(BC42_CTRL_DumpTbl_CmdPayload_t));
+      }
       
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SEND_CTRL_GAINS_TLM_CC,  CTRL42_OBJ, CTRL42_SendCtrlGainsTlmCmd,  0);
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SET_CTRL_MODE_CC,        CTRL42_OBJ, CTRL42_SetCtrlModeCmd,       sizeof(BC42_CTRL_SetCtrlMode_CmdPayload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SET_BOOL_OVR_STATE_CC,   CTRL42_OBJ, CTRL42_SetBoolOvrStateCmd,   sizeof(BC42_CTRL_SetBoolOvrState_CmdPayload_t));
       CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SET_WHEEL_TARGET_MOM_CC, CTRL42_OBJ, CTRL42_SetWheelTargetMomCmd, sizeof(BC42_CTRL_SetWheelTargetMom_CmdPayload_t));
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_ENABLE_DEBUG_LOG_CC,     CTRL42_OBJ, CTRL42_EnableDebugLogCmd,    0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_DISABLE_DEBUG_LOG_CC,    CTRL42_OBJ, CTRL42_DisableDebugLogCmd,   0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_RESET_LATENCY_STATS_CC,  LATENCY_MON_OBJ, LATENCY_MON_ResetCmd,  0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SEND_TIMING_TLM_CC,      CYCLE_PROF_OBJ,  CYCLE_PROF_SendTimingTlmCmd, 0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_SET_CTRL_TLM_DECIM_CC,   CTRL_STATS_OBJ,  CTRL_STATS_SetDecimCmd,      sizeof(BC42_CTRL_SetCtrlTlmDecim_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_ENABLE_DEBUG_LOG_CC,     DEBUG_LOG_OBJ, DEBUG_LOG_EnableCmd,   0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_DISABLE_DEBUG_LOG_CC,    DEBUG_LOG_OBJ, DEBUG_LOG_DisableCmd,  0);
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_START_SENSOR_TRACE_CC,   TRACE_REC_OBJ, TRACE_REC_StartCmd,    sizeof(BC42_CTRL_StartSensorTrace_CmdPayload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, BC42_CTRL_STOP_SENSOR_TRACE_CC,    TRACE_REC_OBJ, TRACE_REC_StopCmd,     0);
 
       CFE_MSG_Init(CFE_MSG_PTR(Bc42Ctrl.StatusTlm.TelemetryHeader), CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_BC42_CTRL_STATUS_TLM_TOPICID)), sizeof(BC42_CTRL_StatusTlm_t));
       
@@ -224,7 +339,14 @@ static int32 InitApp(void)
 ** Function: ProcessCmdPipe
 **
 ** Notes:
-**   None
+**   1. The sensor pipe paces the app. It is drained before any command or
+**      housekeeping request is processed and it is polled again after each
+**      command so a burst of commands can't delay a control cycle.
+**   2. The sensor pipe pend times out so commands are still serviced when
+**      42 is not running.
+**   3. Table command results from the table child task are applied after
+**      the sensor pipe is drained, before any command or housekeeping
+**      request reads the table status.
 */
 static int32 ProcessCmdPipe(void)
 {
@@ -232,67 +354,259 @@ static int32 ProcessCmdPipe(void)
    int32   RetStatus = CFE_ES_RunStatus_APP_RUN;
    int32   SbStatus;
    int32   MsgStatus;
-   int32   SensorMsgCnt = 0;
+   bool    SensorPipeValid;
    
    CFE_SB_Buffer_t  *SbBufPtr;
    CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
    
 
+   SensorPipeValid = ProcessSensorPipe(Bc42Ctrl.SensorPipeTimeout);
+   ProcessTblStatus();
+   
+   SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.CmdPipe, CFE_SB_POLL);
+   
+   while (SensorPipeValid && SbStatus == CFE_SUCCESS)
+   {
+    
+      MsgStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+
+      if (MsgStatus == CFE_SUCCESS)
+      {
+         if (CFE_SB_MsgId_Equal(MsgId, Bc42Ctrl.CmdMid))
+         {
+            CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+         }
+         else if (CFE_SB_MsgId_Equal(MsgId, Bc42Ctrl.SendStatusTlmMid))
+         {
+            SendStatusTlmMsg();
+         }
+         else
+         {            
+            CFE_EVS_SendEvent(BC42_CTRL_PROCESS_CMD_PIPE_EID, CFE_EVS_EventType_ERROR,
+                              "Received invalid command packet, MID = 0x%04X(%d)", 
+                              CFE_SB_MsgIdToValue(MsgId), CFE_SB_MsgIdToValue(MsgId));
+         }
+      } /* End valid message ID */
+      
+      SensorPipeValid = ProcessSensorPipe(CFE_SB_POLL);
+      
+      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.CmdPipe, CFE_SB_POLL);
+
+   } /* End command pipe loop */
+
+   if (!SensorPipeValid || SbStatus != CFE_SB_NO_MESSAGE)
+   {
+      RetStatus = CFE_ES_RunStatus_APP_ERROR;
+   }
+
+   return RetStatus;
+   
+} /* End ProcessCmdPipe() */
+
+
+/******************************************************************************
+** Function: ProcessSensorPipe
+**
+** Run control cycles for the sensor data messages in the sensor pipe.
+**
+** Notes:
+**   1. Only the sensor data message is subscribed to the sensor pipe.
+**   2. The sensor backlog policy limits the number of control cycles. Once
+**      the limit is reached, each newer sample replaces the held sample and
+**      the last control cycle uses the newest sample. A software bus buffer
+**      is released by the next receive, including one that returns
+**      CFE_SB_NO_MESSAGE, and the software bus can't report whether a newer
+**      message is queued, so held samples are copied. PROCESS_ALL, the INI
+**      default, never holds a sample and runs every cycle from its software
+**      bus buffer.
+**   3. Every received message is recorded when sensor tracing is active,
+**      including messages the backlog policy drops.
+**   4. Every received message is checked by the controller's sensor checks
+**      before the backlog policy, so messages the policy drops aren't
+**      counted as sequence count gaps. Rejected messages aren't counted
+**      against the policy's cycle limit.
+**   5. Returns false if a software bus error occurred.
+*/
+static bool ProcessSensorPipe(int32 Timeout)
+{
+   
+   int32   SbStatus;
+   uint32  TotalMsgCnt = 0;
+   uint32  SensorMsgCnt = 0;
+   bool    SensorMsgHeld = false;
+   
+   CFE_SB_Buffer_t  *SbBufPtr;
+   
+
    CFE_ES_PerfLogExit(Bc42Ctrl.PerfId);
-   SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.CmdPipe, CFE_SB_PEND_FOREVER);
+   SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.SensorPipe, Timeout);
    CFE_ES_PerfLogEntry(Bc42Ctrl.PerfId);
    
-   do
+   while (SbStatus == CFE_SUCCESS)
    {
     
-      if (SbStatus == CFE_SUCCESS)
-      {
-         MsgStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+      TotalMsgCnt++;
+      TRACE_REC_AddMsg(TRACE_REC_OBJ, (BC42_INTF_SensorDataMsg_t *)&SbBufPtr->Msg);
 
-         if (MsgStatus == CFE_SUCCESS)
+      if (CTRL42_CheckSensorMsg(CTRL42_OBJ, (BC42_INTF_SensorDataMsg_t *)&SbBufPtr->Msg))
+      {
+         SensorMsgCnt++;
+         if (SensorMsgCnt < Bc42Ctrl.SensorCycleLim)
          {
-            if (CFE_SB_MsgId_Equal(MsgId, Bc42Ctrl.CmdMid))
-            {
-               CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
-            }
-            else if (CFE_SB_MsgId_Equal(MsgId, Bc42Ctrl.SendStatusTlmMid))
-            {
-               SendStatusTlmMsg();
-            }
-            else if (CFE_SB_MsgId_Equal(MsgId, Bc42Ctrl.SensorDataMsgMid))
+            CTRL42_Run42Fsw(CTRL42_OBJ, (BC42_INTF_SensorDataMsg_t *)&SbBufPtr->Msg);
+         }
+         else
+         {
+            if (SensorMsgHeld)
             {
-               SensorMsgCnt++;
-               CTRL42_Run42Fsw((BC42_INTF_SensorDataMsg_t *)&SbBufPtr->Msg);
+               Bc42Ctrl.SensorDroppedCnt++;
             }
-            else
-            {            
-               CFE_EVS_SendEvent(BC42_CTRL_PROCESS_CMD_PIPE_EID, CFE_EVS_EventType_ERROR,
-                                 "Received invalid command packet, MID = 0x%04X(%d)", 
-                                 CFE_SB_MsgIdToValue(MsgId), CFE_SB_MsgIdToValue(MsgId));
-            }
-         } /* End valid message ID */
-      } /* End if SB received a packet */
-      
-      CFE_ES_PerfLogExit(Bc42Ctrl.PerfId);
-      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.CmdPipe, CFE_SB_POLL);
-      CFE_ES_PerfLogEntry(Bc42Ctrl.PerfId);      
+            memcpy(&Bc42Ctrl.SensorDataMsg, SbBufPtr, sizeof(BC42_INTF_SensorDataMsg_t));
+            SensorMsgHeld = true;
+         }
+      }
+
+      SbStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, Bc42Ctrl.SensorPipe, CFE_SB_POLL);
 
-   } while (SbStatus == CFE_SUCCESS);
+   }
 
-   if (SbStatus != CFE_SB_NO_MESSAGE)
+   if (SensorMsgHeld)
    {
-      RetStatus = CFE_ES_RunStatus_APP_ERROR;
+      if (SensorMsgCnt > Bc42Ctrl.SensorCycleLim)
+      {
+         Bc42Ctrl.SensorCoalescedCnt++;
+      }
+      CTRL42_Run42Fsw(CTRL42_OBJ, &Bc42Ctrl.SensorDataMsg);
    }
 
-   if (SensorMsgCnt > 1)
+   if (TotalMsgCnt > 1)
    {
       CFE_EVS_SendEvent(BC42_CTRL_PROCESS_CMD_PIPE_EID, CFE_EVS_EventType_INFORMATION,
-                        "Processed %d sensor data messages in one execution cycle",SensorMsgCnt);      
+                        "Processed %d sensor data messages in one execution cycle",(int)TotalMsgCnt);      
    }
 
-   return RetStatus;
+   return (SbStatus == CFE_SB_NO_MESSAGE || SbStatus == CFE_SB_TIME_OUT);
    
-} /* End ProcessCmdPipe() */
+} /* End ProcessSensorPipe() */
+
+
+/******************************************************************************
+** Function: ProcessTblStatus
+**
+** Copy the table command results queued by the table child task into the
+** app's table manager.
+**
+*/
+static void ProcessTblStatus(void)
+{
+
+   const BC42_CTRL_TblStatus_t *TblStatus;
+   TBLMGR_Tbl_t *Tbl;
+   uint32 StatusCnt;
+   uint32 i;
+
+   StatusCnt = SPSC_RING_GetReadSpan(&Bc42Ctrl.TblStatusRing, (const void **)&TblStatus);
+   while (StatusCnt > 0)
+   {
+      for (i=0; i < StatusCnt; i++)
+      {
+         Tbl = &Bc42Ctrl.TblMgr.Tbl[TblStatus[i].TblId];
+         Tbl->LastAction       = TblStatus[i].LastAction;
+         Tbl->LastActionStatus = TblStatus[i].LastActionStatus;
+         Tbl->Loaded           = TblStatus[i].Loaded;
+         Bc42Ctrl.TblMgr.LastActionTblId = TblStatus[i].TblId;
+      }
+      SPSC_RING_Release(&Bc42Ctrl.TblStatusRing, StatusCnt);
+      StatusCnt = SPSC_RING_GetReadSpan(&Bc42Ctrl.TblStatusRing, (const void **)&TblStatus);
+   }
+
+} /* End ProcessTblStatus() */
+
+
+/******************************************************************************
+** Function: PushTblStatus
+**
+** Queue the table child task's most recent table command result for the
+** app task.
+**
+** Notes:
+**   1. A command rejected before a table was selected, e.g. an invalid
+**      table ID, leaves the table manager's last table unchanged so that
+**      table's status is queued again.
+**   2. The app task drains the queue every wakeup and the child task runs
+**      one command at a time so the queue only fills when the app task is
+**      stalled. The result is then lost and an event is sent.
+**
+*/
+static void PushTblStatus(const TBLMGR_Class_t *TblMgr)
+{
+
+   const TBLMGR_Tbl_t *Tbl = &TblMgr->Tbl[TblMgr->LastActionTblId];
+   BC42_CTRL_TblStatus_t TblStatus;
+
+   TblStatus.TblId            = TblMgr->LastActionTblId;
+   TblStatus.LastAction       = Tbl->LastAction;
+   TblStatus.LastActionStatus = Tbl->LastActionStatus;
+   TblStatus.Loaded           = Tbl->Loaded;
+
+   if (!SPSC_RING_Push(&Bc42Ctrl.TblStatusRing, &TblStatus))
+   {
+      CFE_EVS_SendEvent(BC42_CTRL_TBL_STATUS_EID, CFE_EVS_EventType_ERROR,
+                        "Table %s status not reported, %d results are waiting for the app task",
+                        Tbl->Name, BC42_CTRL_TBL_STATUS_CNT);
+   }
+
+} /* End PushTblStatus() */
+
+
+/******************************************************************************
+** Function: SetSensorBacklogPolicy
+**
+** Notes:
+**   1. An invalid INI policy defaults to PROCESS_ALL which is the behavior
+**      prior to policies being introduced.
+*/
+static void SetSensorBacklogPolicy(const char *PolicyStr, uint32 CatchupMax)
+{
+
+   int i;
+   
+   Bc42Ctrl.SensorBacklogPolicy = BC42_CTRL_SensorBacklogPolicy_PROCESS_ALL;
+   
+   for (i=BC42_CTRL_SensorBacklogPolicy_Enum_t_MIN; i <= BC42_CTRL_SensorBacklogPolicy_Enum_t_MAX; i++)
+   {
+      if (strcmp(PolicyStr, SensorBacklogPolicyStr[i]) == 0)
+      {
+         Bc42Ctrl.SensorBacklogPolicy = i;
+         break;
+      }
+   }
+   
+   if (i > BC42_CTRL_SensorBacklogPolicy_Enum_t_MAX)
+   {
+      CFE_EVS_SendEvent(BC42_CTRL_SENSOR_BACKLOG_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid sensor backlog policy %s, using %s", 
+                        PolicyStr, SensorBacklogPolicyStr[Bc42Ctrl.SensorBacklogPolicy]);
+   }
+   
+   switch (Bc42Ctrl.SensorBacklogPolicy)
+   {
+      case BC42_CTRL_SensorBacklogPolicy_NEWEST_ONLY:
+         Bc42Ctrl.SensorCycleLim = 1;
+         break;
+      case BC42_CTRL_SensorBacklogPolicy_BOUNDED_CATCHUP:
+         Bc42Ctrl.SensorCycleLim = (CatchupMax > 0) ? CatchupMax : 1;
+         break;
+      default:
+         Bc42Ctrl.SensorCycleLim = UINT32_MAX;
+         break;
+   }
+   
+   CFE_EVS_SendEvent(BC42_CTRL_SENSOR_BACKLOG_EID, CFE_EVS_EventType_INFORMATION,
+                     "Sensor backlog policy %s, max control cycles per wakeup %u", 
+                     SensorBacklogPolicyStr[Bc42Ctrl.SensorBacklogPolicy], (unsigned int)Bc42Ctrl.SensorCycleLim);
+
+} /* End SetSensorBacklogPolicy() */
 
 
 /***********************************3*******************************************
@@ -321,11 +635,39 @@ static void SendStatusTlmMsg(void)
    ** CTRL42 Data
    */
 
-   Payload->ControlExecutionCnt = Bc42Ctrl.Ctrl42.CtrlExeCnt;
-   Payload->ControlMode         = Bc42Ctrl.Ctrl42.CtrlMode;
-   Payload->OverrideSunValid    = Bc42Ctrl.Ctrl42.BoolOverride[BC42_CTRL_Bool42Id_Sun_VALID];
+   Payload->ControlExecutionCnt = CTRL42_OBJ->CtrlExeCnt;
+   Payload->ControlMode         = CTRL42_OBJ->CtrlMode;
+   Payload->ModeTransitionCnt   = CTRL42_OBJ->ModeTransCnt;
+   Payload->ModeRejectedCnt     = CTRL42_OBJ->ModeRejectCnt;
+   Payload->OverrideSunValid    = BOOL_OVR_GetState(&CTRL42_OBJ->BoolOvr, BC42_CTRL_Bool42Id_Sun_VALID);
+   Payload->OverrideSetMask     = CTRL42_OBJ->BoolOvr.SetMask;
+   Payload->OverrideClearMask   = CTRL42_OBJ->BoolOvr.ClrMask;
+   Payload->FaultExeCnt         = CTRL42_OBJ->FaultInj.ExeCnt;
+   Payload->FaultDropCnt        = CTRL42_OBJ->FaultInj.DroppedCnt;
+   Payload->DeadlineMissCnt     = CTRL42_OBJ->DeadlineMon.MissCnt;
+   Payload->DeadlineLateCmdCnt  = CTRL42_OBJ->DeadlineMon.LateCmdCnt;
+   Payload->ShedCycleCnt        = CTRL42_OBJ->DeadlineMon.ShedCycleCnt;
+   Payload->ShedLevel           = CTRL42_OBJ->DeadlineMon.ShedLevel;
+
+   /*
+   ** Sensor Pipe Data
+   */
+   
+   Payload->SensorBacklogPolicy = Bc42Ctrl.SensorBacklogPolicy;
+   Payload->SensorDroppedCnt    = Bc42Ctrl.SensorDroppedCnt;
+   Payload->SensorCoalescedCnt  = Bc42Ctrl.SensorCoalescedCnt;
+   Payload->SensorDuplicateCnt  = CTRL42_OBJ->SensorChk.DuplicateCnt;
+   Payload->SensorOutOfOrderCnt = CTRL42_OBJ->SensorChk.OutOfOrderCnt;
+   Payload->SensorStaleCnt      = CTRL42_OBJ->SensorChk.StaleCnt;
+   Payload->SensorMissingCnt    = CTRL42_OBJ->SensorChk.MissingCnt;
+   Payload->SensorLastGap       = CTRL42_OBJ->SensorChk.LastGap;
+   Payload->SensorResyncCnt     = CTRL42_OBJ->SensorChk.ResyncCnt;
+   Payload->CtrlTlmDecim        = CTRL42_OBJ->CtrlStats.DecimFactor;
 
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(Bc42Ctrl.StatusTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(Bc42Ctrl.StatusTlm.TelemetryHeader), true);
 
+   LATENCY_MON_SendTlm(LATENCY_MON_OBJ);
+   PERIOD_MON_SendTlm(PERIOD_MON_OBJ);
+
 } /* End SendStatusTlmMsg() */
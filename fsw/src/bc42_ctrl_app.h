@@ -30,6 +30,8 @@
 
 #include "app_cfg.h"
 #include "ctrl42.h"
+#include "spsc_ring.h"
+#include "trace_rec.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -43,6 +45,9 @@
 #define BC42_CTRL_EXIT_EID              (BC42_CTRL_BASE_EID + 1)
 #define BC42_CTRL_NOOP_EID              (BC42_CTRL_BASE_EID + 2)
 #define BC42_CTRL_PROCESS_CMD_PIPE_EID  (BC42_CTRL_BASE_EID + 3)
+#define BC42_CTRL_SENSOR_BACKLOG_EID    (BC42_CTRL_BASE_EID + 4)
+#define BC42_CTRL_TBL_CHILD_TASK_EID    (BC42_CTRL_BASE_EID + 5)
+#define BC42_CTRL_TBL_STATUS_EID        (BC42_CTRL_BASE_EID + 6)
 
 
 /**********************/
@@ -60,6 +65,21 @@
 */
 
 
+/******************************************************************************
+** Table command result passed from the table child task to the app task
+*/
+
+typedef struct
+{
+
+   uint8   TblId;
+   uint8   LastAction;         /* APP_C_FW_TblActions */
+   uint8   LastActionStatus;   /* APP_C_FW_TblActionStatus */
+   bool    Loaded;
+
+} BC42_CTRL_TblStatus_t;
+
+
 /******************************************************************************
 ** BC42_CTRL_APP Class
 */
@@ -73,14 +93,25 @@ typedef struct
 
    INITBL_Class_t    IniTbl; 
    CFE_SB_PipeId_t   CmdPipe;
+   CFE_SB_PipeId_t   SensorPipe;
    CMDMGR_Class_t    CmdMgr;
    TBLMGR_Class_t    TblMgr;
+   CHILDMGR_Class_t  TblChildMgr;       /* Runs table load and dump commands */
+   TBLMGR_Class_t    TblChildTblMgr;    /* Table child task only, see InitApp() */
+   SPSC_RING_Class_t TblStatusRing;     /* Table child task to app task */
+   BC42_CTRL_TblStatus_t TblStatusBuf[BC42_CTRL_TBL_STATUS_CNT];
 
    /*
    ** App State
    */
 
    uint32          PerfId;
+   int32           SensorPipeTimeout;
+   
+   BC42_CTRL_SensorBacklogPolicy_Enum_t  SensorBacklogPolicy;
+   uint32          SensorCycleLim;      /* Max control cycles per sensor pipe read, derived from policy */
+   uint32          SensorDroppedCnt;
+   uint32          SensorCoalescedCnt;
    CFE_SB_MsgId_t  CmdMid;
    CFE_SB_MsgId_t  SendStatusTlmMid;
    CFE_SB_MsgId_t  StatusTlmMid;
@@ -92,11 +123,20 @@ typedef struct
    
    BC42_CTRL_StatusTlm_t  StatusTlm;
    
+   /*
+   ** Newest sensor sample held when the backlog policy limits control cycles
+   */
+   
+   BC42_INTF_SensorDataMsg_t  SensorDataMsg;
+   
    /*
    ** App Objects
    */
 
-   CTRL42_Class_t  Ctrl42;
+   CTRL42_Class_t     Ctrl42;
+   DEBUG_LOG_Class_t  DebugLog;
+   TRACE_REC_Class_t  TraceRec;
+   DEADLINE_MON_Watchdog_t  DeadlineWatchdog;
 
 
 } BC42_CTRL_APP_Class_t;
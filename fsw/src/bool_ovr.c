@@ -0,0 +1,89 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the sensor validity flag overrides
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "bool_ovr.h"
+
+
+/******************************************************************************
+** Function: BOOL_OVR_Constructor
+**
+*/
+void BOOL_OVR_Constructor(BOOL_OVR_Class_t *BoolOvr)
+{
+
+   BoolOvr->SetMask = 0;
+   BoolOvr->ClrMask = 0;
+
+} /* End BOOL_OVR_Constructor() */
+
+
+/******************************************************************************
+** Function: BOOL_OVR_GetState
+**
+*/
+BC42_CTRL_Bool42State_Enum_t BOOL_OVR_GetState(const BOOL_OVR_Class_t *BoolOvr, 
+                                               BC42_CTRL_Bool42Id_Enum_t Id)
+{
+
+   BC42_CTRL_Bool42State_Enum_t State = BC42_CTRL_Bool42State_USE_SIM;
+
+   if (BoolOvr->SetMask & BOOL_OVR_BIT(Id))
+   {
+      State = BC42_CTRL_Bool42State_TRUE;
+   }
+   else if (BoolOvr->ClrMask & BOOL_OVR_BIT(Id))
+   {
+      State = BC42_CTRL_Bool42State_FALSE;
+   }
+
+   return State;
+
+} /* End BOOL_OVR_GetState() */
+
+
+/******************************************************************************
+** Function: BOOL_OVR_SetState
+**
+*/
+void BOOL_OVR_SetState(BOOL_OVR_Class_t *BoolOvr, BC42_CTRL_Bool42Id_Enum_t Id,
+                       BC42_CTRL_Bool42State_Enum_t State)
+{
+
+   uint32 Bit = BOOL_OVR_BIT(Id);
+
+   BoolOvr->SetMask &= ~Bit;
+   BoolOvr->ClrMask &= ~Bit;
+
+   if (State == BC42_CTRL_Bool42State_TRUE)
+   {
+      BoolOvr->SetMask |= Bit;
+   }
+   else if (State == BC42_CTRL_Bool42State_FALSE)
+   {
+      BoolOvr->ClrMask |= Bit;
+   }
+
+} /* End BOOL_OVR_SetState() */
@@ -0,0 +1,141 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Override the validity flags of ingested sensor data
+**
+**  Notes:
+**    1. Each BC42_CTRL_Bool42Id_Enum_t value is a bit in a packed flag word.
+**       The overrides are kept as a set mask of the flags forced TRUE and a
+**       clear mask of the flags forced FALSE. A flag is never in both masks.
+**    2. BOOL_OVR_Apply() applies every override with one OR and one AND so
+**       the cost doesn't depend on which overrides are active.
+**    3. BOOL_OVR_PackSensor() converts the sensor data validity flags to a
+**       flag word without branching. BOOL_OVR_UnpackSensor() writes a flag
+**       word back to sensor data.
+**
+*/
+#ifndef _bool_ovr_
+#define _bool_ovr_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42_intf_eds_typedefs.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BOOL_OVR_BIT(Id)  ((uint32)1 << (Id))
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** BOOL_OVR Class
+*/
+
+typedef struct
+{
+
+   uint32  SetMask;
+   uint32  ClrMask;
+
+} BOOL_OVR_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: BOOL_OVR_Constructor
+**
+** Initialize a boolean override object with every flag using the simulator
+** value.
+**
+*/
+void BOOL_OVR_Constructor(BOOL_OVR_Class_t *BoolOvr);
+
+
+/******************************************************************************
+** Function: BOOL_OVR_Apply
+**
+** Return Flags with the overrides applied.
+**
+*/
+static inline uint32 BOOL_OVR_Apply(const BOOL_OVR_Class_t *BoolOvr, uint32 Flags)
+{
+   return (Flags | BoolOvr->SetMask) & ~BoolOvr->ClrMask;
+}
+
+
+/******************************************************************************
+** Function: BOOL_OVR_GetState
+**
+** Return the override state of a flag. Id must be less than
+** BC42_CTRL_Bool42Id_COUNT.
+**
+*/
+BC42_CTRL_Bool42State_Enum_t BOOL_OVR_GetState(const BOOL_OVR_Class_t *BoolOvr, 
+                                               BC42_CTRL_Bool42Id_Enum_t Id);
+
+
+/******************************************************************************
+** Function: BOOL_OVR_PackSensor
+**
+** Return the sensor data validity flags as a flag word.
+**
+*/
+static inline uint32 BOOL_OVR_PackSensor(const BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+   return ((uint32)(Sensor->SunValid != 0) << BC42_CTRL_Bool42Id_Sun_VALID) |
+          ((uint32)(Sensor->StValid  != 0) << BC42_CTRL_Bool42Id_St_VALID)  |
+          ((uint32)(Sensor->GpsValid != 0) << BC42_CTRL_Bool42Id_Gps_VALID);
+}
+
+
+/******************************************************************************
+** Function: BOOL_OVR_SetState
+**
+** Set the override state of a flag. Id must be less than
+** BC42_CTRL_Bool42Id_COUNT and State less than BC42_CTRL_Bool42State_COUNT.
+**
+*/
+void BOOL_OVR_SetState(BOOL_OVR_Class_t *BoolOvr, BC42_CTRL_Bool42Id_Enum_t Id,
+                       BC42_CTRL_Bool42State_Enum_t State);
+
+
+/******************************************************************************
+** Function: BOOL_OVR_UnpackSensor
+**
+** Set the sensor data validity flags from a flag word.
+**
+*/
+static inline void BOOL_OVR_UnpackSensor(BC42_INTF_SensorDataMsg_Payload_t *Sensor, uint32 Flags)
+{
+   Sensor->SunValid = (Flags >> BC42_CTRL_Bool42Id_Sun_VALID) & 1;
+   Sensor->StValid  = (Flags >> BC42_CTRL_Bool42Id_St_VALID)  & 1;
+   Sensor->GpsValid = (Flags >> BC42_CTRL_Bool42Id_Gps_VALID) & 1;
+}
+
+
+#endif /* _bool_ovr_ */
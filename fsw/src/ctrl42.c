@@ -28,11 +28,18 @@
 **       object will need to change.
 **    4. Since this is an educational app many events are defined as informational. A
 **       flight app should minimize "event clutter" and define some of these as debug.
-**    5. TODO - Fix partial & full table load/commit process. Right now a quick & dirty
-**       copy to local structure and then update 42's FSW structure. Get rid of
-**       local adapter table copy and add a commit function that is called from
-**       the control table load function. Think through initial values from a
-**       table or use #defines
+**    5. Table loads are parsed and validated outside the control task.
+**       CommitTbl() makes the newest accepted load active at the start of
+**       the next control cycle and the cycle's gains are then loaded into
+**       BC42_LIB by UpdateGains(). See ctrl42_tbl.h.
+**    6. When the table has a gain schedule the gains are interpolated each
+**       cycle from the momentum magnitude |Hvb| computed by the previous
+**       cycle. BC42_LIB only gets new gains when the interpolated values
+**       change. See ctrl42_tbl.h for the schedule definition.
+**    7. BC42_LIB runs one control law with one attitude reference, so the
+**       SUN_POINT, INERTIAL_HOLD and SCIENCE modes fly the same law. They
+**       differ in their guards and TakeSci evaluation. SAFE idles the
+**       wheels and keeps the magnetic torquer commands.
 */
 
 /*
@@ -45,25 +52,78 @@
 /** Macro Definitions **/
 /***********************/
 
+#define MODE_BIT(Mode)  (1 << (Mode))
 
-/*
-** Global File Data
-*/
+#define FROM_SAFE   MODE_BIT(BC42_CTRL_ControlMode_SAFE)
+#define FROM_SUN    MODE_BIT(BC42_CTRL_ControlMode_SUN_POINT)
+#define FROM_INRTL  MODE_BIT(BC42_CTRL_ControlMode_INERTIAL_HOLD)
+#define FROM_SCI    MODE_BIT(BC42_CTRL_ControlMode_SCIENCE)
+
+/* Mode transition guards */
+#define MODE_REQ_SUN_VALID  BOOL_OVR_BIT(BC42_CTRL_Bool42Id_Sun_VALID)
+#define MODE_REQ_ST_VALID   BOOL_OVR_BIT(BC42_CTRL_Bool42Id_St_VALID)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
 
-static CTRL42_Class_t *Ctrl42 = NULL;
+struct CTRL42_ModeDef
+{
+
+   const char *Name;
+   uint8   EnterFrom;   /* MODE_BIT() of each mode this mode can be commanded from */
+   uint8   Requires;    /* MODE_REQ_ guards checked when the transition is applied */
+
+   void  (*SendActuatorCmd)(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+   void  (*SendControllerTlm)(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+   void  (*SetTakeSci)(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+
+};
 
 
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
-static bool AcceptNewTbl(const CTRL42_TBL_Data_t *TblData);
-static void SendActuatorCmdMsg(const BC42_Ac_t *Ac42);
-static void SendControllerTlm(const BC42_Ac_t *Ac42);
-static void SetTakeSci(void);
+static void ApplyPendingMode(CTRL42_Class_t *Ctrl42);
+static void ClearTakeSci(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void CommitTbl(CTRL42_Class_t *Ctrl42);
+static void InterpSchedGains(CTRL42_Class_t *Ctrl42, const CTRL42_TBL_Sched_t *Sched,
+                             BC42_CtrlGains_t *Gains);
+static void RunCycle(CTRL42_Class_t *Ctrl42, BC42_INTF_SensorDataMsg_t *SensorDataMsg);
+static void UpdateGains(CTRL42_Class_t *Ctrl42);
+static bool ValidateNewTbl(const CTRL42_TBL_Data_t *TblData);
+static void SendActuatorCmdMsg(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void SendControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void SendRawControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void SendSafeActuatorCmd(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void SetTakeSci(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
+static void TransmitActuatorCmd(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42, const double Tcmd[3]);
+static void TransmitControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42);
 static const char *BoolOverrideStr(BC42_CTRL_Bool42State_Enum_t State);
 
 
+/**********************/
+/** Global File Data **/
+/**********************/
+
+/*
+** Mode function sets, indexed by BC42_CTRL_ControlMode_Enum_t. SAFE sends
+** every controller telemetry sample so safing isn't hidden by decimation.
+*/
+static const CTRL42_ModeDef_t ModeDef[BC42_CTRL_ControlMode_COUNT] =
+{
+
+   /* Name             EnterFrom                          Requires            Actuator command      Controller telemetry   TakeSci      */
+   { "SAFE",           FROM_SUN  | FROM_INRTL | FROM_SCI, 0,                  SendSafeActuatorCmd,  SendRawControllerTlm,  ClearTakeSci },
+   { "SUN_POINT",      FROM_SAFE | FROM_INRTL | FROM_SCI, MODE_REQ_SUN_VALID, SendActuatorCmdMsg,   SendControllerTlm,     ClearTakeSci },
+   { "INERTIAL_HOLD",  FROM_SUN  | FROM_SCI,              MODE_REQ_ST_VALID,  SendActuatorCmdMsg,   SendControllerTlm,     ClearTakeSci },
+   { "SCIENCE",        FROM_INRTL,                        MODE_REQ_ST_VALID,  SendActuatorCmdMsg,   SendControllerTlm,     SetTakeSci   }
+
+};
+
+
 /******************************************************************************
 ** Function: CTRL42_Constructor
 **
@@ -74,33 +134,73 @@ static const char *BoolOverrideStr(BC42_CTRL_Bool42State_Enum_t State);
 **   2. Assumes IF42 has constructed osk_42_lib's AC42 shared data structure 
 **
 */
-void CTRL42_Constructor(CTRL42_Class_t *Ctrl42Obj, const INITBL_Class_t *IniTbl,
-                        TBLMGR_Class_t *TblMgr)
+void CTRL42_Constructor(CTRL42_Class_t *Ctrl42, const INITBL_Class_t *IniTbl,
+                        TBLMGR_Class_t *TblMgr, DEBUG_LOG_Class_t *DebugLog)
 {
 
    int i;
+   const char *InitMode = INITBL_GetStrConfig(IniTbl, CFG_CTRL42_INIT_MODE);
    
-   Ctrl42 = Ctrl42Obj;
-
    /* If a class state variable can't default to zero then must be set after this */
    CFE_PSP_MemSet((void*)Ctrl42, 0, sizeof(CTRL42_Class_t));
    
+   Ctrl42->DebugLog = DebugLog;
+   
    /* Down counters */
    Ctrl42->TakeSciInitCyc  = INITBL_GetIntConfig(IniTbl, CFG_CTRL42_TAKE_SCI_INIT_CYC);
    Ctrl42->TakeSciTransCyc = INITBL_GetIntConfig(IniTbl, CFG_CTRL42_TAKE_SCI_TRANS_CYC);
    
-   for (i=BC42_CTRL_Bool42State_Enum_t_MIN; i<=BC42_CTRL_Bool42State_Enum_t_MAX; i++)
+   BOOL_OVR_Constructor(&(Ctrl42->BoolOvr));
+   FAULT_INJ_Constructor(&(Ctrl42->FaultInj), &(Ctrl42->BoolOvr));
+   SENSOR_CHK_Constructor(&(Ctrl42->SensorChk), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_SENSOR_STALE_LIM),
+                          INITBL_GetIntConfig(IniTbl, CFG_CTRL42_SENSOR_RESYNC_LIM),
+                          INITBL_GetIntConfig(IniTbl, CFG_CTRL42_SENSOR_RESYNC_JUMP));
+   DEADLINE_MON_Constructor(&(Ctrl42->DeadlineMon), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_DEADLINE),
+                            INITBL_GetIntConfig(IniTbl, CFG_CTRL42_DEADLINE_AT_RISK),
+                            CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID)));
+   
+   /* An invalid INI mode defaults to SAFE */
+   for (i=0; i < BC42_CTRL_ControlMode_COUNT && strcmp(InitMode, ModeDef[i].Name) != 0; i++);
+   if (i == BC42_CTRL_ControlMode_COUNT)
    {
-      Ctrl42->BoolOverride[i] = BC42_CTRL_Bool42State_USE_SIM;
+      CFE_EVS_SendEvent(CTRL42_MODE_TRANS_EID, CFE_EVS_EventType_ERROR,
+                        "CTRL42 invalid initial mode %s, using %s", InitMode,
+                        ModeDef[BC42_CTRL_ControlMode_SAFE].Name);
+      i = BC42_CTRL_ControlMode_SAFE;
    }
-   
-   strncpy (Ctrl42->DebugFilename, INITBL_GetStrConfig(IniTbl, CFG_CTRL42_DEBUG_FILE),OS_MAX_PATH_LEN);
-   Ctrl42->DebugFilename[OS_MAX_PATH_LEN-1] = '\0';
-   
-   CTRL42_TBL_Constructor(&(Ctrl42->Tbl), AcceptNewTbl);
-   TBLMGR_RegisterTblWithDef(TblMgr, CTRL42_TBL_NAME, CTRL42_TBL_LoadCmd, CTRL42_TBL_DumpCmd,  
-                             INITBL_GetStrConfig(IniTbl, CFG_CTRL42_TBL_LOAD_FILE));
+   Ctrl42->CtrlMode    = i;
+   Ctrl42->ModeDef     = &ModeDef[i];
+   Ctrl42->PendingMode = BC42_CTRL_ControlMode_COUNT;
+
+   LATENCY_MON_Constructor(&(Ctrl42->LatencyMon), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_LATENCY_BIN_WIDTH),
+                           CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_LATENCY_TLM_TOPICID)));
+
+   CYCLE_PROF_Constructor(&(Ctrl42->CycleProf), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_PHASE_PERF_ID_BASE),
+                          CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_TIMING_TLM_TOPICID)));
+
+   PERIOD_MON_Constructor(&(Ctrl42->PeriodMon), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_NOMINAL_PERIOD),
+                          CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_PERIOD_TLM_TOPICID)));
 
+   CTRL_STATS_Constructor(&(Ctrl42->CtrlStats), INITBL_GetIntConfig(IniTbl, CFG_CTRL42_CTRL_TLM_DECIM),
+                          CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_CONTROLLER_STATS_TLM_TOPICID)));
+
+   CTRL_LAW_Constructor(&(Ctrl42->CtrlLaw), INITBL_GetStrConfig(IniTbl, CFG_CTRL42_CTRL_LAW),
+                        INITBL_GetIntConfig(IniTbl, CFG_CTRL42_NOMINAL_PERIOD) * 1.0E-6);
+
+   /* Until a table is loaded the controller uses BC42_LIB's default gains */
+   BC42_GetControlGains(&Ctrl42->Gains);
+   CTRL_LAW_SetGains(&Ctrl42->CtrlLaw, &Ctrl42->Gains);
+   Ctrl42->GainsValid = true;
+
+   CTRL42_TBL_Constructor(&(Ctrl42->Tbl), ValidateNewTbl);
+   CTRL42_TBL_Register(&(Ctrl42->Tbl), TblMgr, INITBL_GetStrConfig(IniTbl, CFG_CTRL42_TBL_LOAD_FILE));
+   CommitTbl(Ctrl42);
+   UpdateGains(Ctrl42);
+
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+   Ctrl42->ActuatorCmdMsgMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID));
+   Ctrl42->ControllerTlmMid  = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_CONTROLLER_TLM_TOPICID));
+#else
    CFE_MSG_Init(CFE_MSG_PTR(Ctrl42->ActuatorCmdMsg.TelemetryHeader), 
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID)),
                 sizeof(BC42_INTF_ActuatorCmdMsg_t));
@@ -108,6 +208,7 @@ void CTRL42_Constructor(CTRL42_Class_t *Ctrl42Obj, const INITBL_Class_t *IniTbl,
    CFE_MSG_Init(CFE_MSG_PTR(Ctrl42->ControllerTlm.TelemetryHeader), 
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_CONTROLLER_TLM_TOPICID)),
                 sizeof(BC42_CTRL_ControllerTlm_t));
+#endif
                 
    CFE_MSG_Init(CFE_MSG_PTR(Ctrl42->ControlGainsTlm.TelemetryHeader), 
                 CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_BC42_CTRL_CONTROL_GAINS_TLM_TOPICID)),
@@ -118,88 +219,41 @@ void CTRL42_Constructor(CTRL42_Class_t *Ctrl42Obj, const INITBL_Class_t *IniTbl,
 
 
 /******************************************************************************
-** Function: CTRL42_DisableDebugLogCmd
+** Function:  CTRL42_ResetStatus
 **
 */
-bool CTRL42_DisableDebugLogCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+void CTRL42_ResetStatus(CTRL42_Class_t *Ctrl42)
 {
+  
+   CTRL42_TBL_ResetStatus(&Ctrl42->Tbl);
+   CYCLE_PROF_ResetStatus(&Ctrl42->CycleProf);
+   PERIOD_MON_ResetStatus(&Ctrl42->PeriodMon);
+   FAULT_INJ_ResetStatus(&Ctrl42->FaultInj);
+   SENSOR_CHK_ResetStatus(&Ctrl42->SensorChk);
+   DEADLINE_MON_ResetStatus(&Ctrl42->DeadlineMon);
+  
+   Ctrl42->CtrlExeCnt    = 0;
+   Ctrl42->ModeTransCnt  = 0;
+   Ctrl42->ModeRejectCnt = 0;
 
-   bool  RetStatus = true;
-
-   if (Ctrl42->DebugEnabled)
-   {
-      Ctrl42->DebugEnabled = false;
-      OS_close(Ctrl42->DebugFileHandle);
-      CFE_EVS_SendEvent(CTRL42_DIS_DEBUG_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                        "Debug log file %s closed", Ctrl42->DebugFilename);
-   }
-   else
-   {
-      CFE_EVS_SendEvent(CTRL42_DIS_DEBUG_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                        "Disable debug command had no effect, debug log not currently enabled.");
-   }
-              
-   return RetStatus;
-
-} /* End CTRL42_DisableDebugLogCmd() */
+} /* End CTRL42_ResetStatus() */
 
 
 /******************************************************************************
-** Function: CTRL42_EnableDebugLogCmd
+** Function: CTRL42_CheckSensorMsg
 **
-** TODO - Add file command parameter
 */
-bool CTRL42_EnableDebugLogCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+bool CTRL42_CheckSensorMsg(CTRL42_Class_t *Ctrl42, const BC42_INTF_SensorDataMsg_t *SensorDataMsg)
 {
 
-   bool          RetStatus = true;
-   int32         SysStatus;
-   os_err_name_t OsErrStr;
+   CFE_TIME_SysTime_t SensorTime;
 
-   if (Ctrl42->DebugEnabled == true)
-   {
-      CFE_EVS_SendEvent(CTRL42_ENA_DEBUG_CMD_EID, CFE_EVS_EventType_ERROR, 
-                        "Enable debug command had no effect, debug log already enabled");
-   }
-   else
-   {
-      
-      SysStatus = OS_OpenCreate(&Ctrl42->DebugFileHandle, Ctrl42->DebugFilename, 
-                                OS_FILE_FLAG_CREATE, OS_READ_WRITE);
-      
-      if (SysStatus == OS_SUCCESS)
-      {   
-         Ctrl42->DebugEnabled = true;
-         CFE_EVS_SendEvent(CTRL42_ENA_DEBUG_CMD_EID, CFE_EVS_EventType_INFORMATION,
-                           "Created debug log file %s",Ctrl42->DebugFilename);
-         RetStatus = true;
-      }
-      else 
-      {
-         OS_GetErrorName(SysStatus, &OsErrStr);
-         CFE_EVS_SendEvent(CTRL42_ENA_DEBUG_CMD_EID, CFE_EVS_EventType_ERROR, 
-         "Error creating debug log file %s. Status = %s", Ctrl42->DebugFilename, OsErrStr);
-      
-      } /* End if error creating file */
-   } /* End if debug not enabled */
+   CFE_MSG_GetMsgTime(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), &SensorTime);
 
-   return RetStatus;
+   return (SENSOR_CHK_Check(&Ctrl42->SensorChk, CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), SensorTime) ==
+           SENSOR_CHK_ACCEPTED);
 
-} /* End CTRL42_EnableDebugLogCmd() */
-
-
-/******************************************************************************
-** Function:  CTRL42_ResetStatus
-**
-*/
-void CTRL42_ResetStatus(void)
-{
-  
-   CTRL42_TBL_ResetStatus();
-  
-   Ctrl42->CtrlExeCnt = 0;
-
-} /* End CTRL42_ResetStatus() */
+} /* End CTRL42_CheckSensorMsg() */
 
 
 /******************************************************************************
@@ -208,20 +262,41 @@ void CTRL42_ResetStatus(void)
 ** Run the 42 simulator's FSW control law. 42's Ac structure is used for
 ** all sensor/actuator data I/O. 
 **
+** Notes:
+**   1. Each phase is timed by the cycle profiler. See cycle_prof.h.
+**   2. The period monitor brackets the entire cycle. See period_mon.h.
+**   3. The debug log records the cycle after all outputs are computed.
+**   4. BC42_LIB's gains are replaced when the cycle's gains changed. See
+**      file prologue.
+**   5. A table load accepted since the previous cycle is committed before
+**      the controller runs so the whole cycle uses one table.
+**   6. A commanded mode transition is applied before the controller runs.
+**      Its guard is checked against the validity flags of the sensor data
+**      message being processed, not the previous cycle's flags. The cycle's
+**      outputs use the mode's function set. See file prologue.
+**   7. Boolean overrides are applied to the sensor validity flags as soon
+**      as the message is ingested so mode guards see the overridden flags.
+**   8. A message dropped by fault injection isn't processed, as if it never
+**      arrived. The message has already passed CTRL42_CheckSensorMsg() so
+**      the drop isn't counted as a sequence count gap.
+**   9. The actuator command is sent before controller telemetry, TakeSci
+**      and the debug log record so optional work never delays it. The
+**      optional work is skipped when the deadline monitor is shedding it.
+**
 */
-void CTRL42_Run42Fsw(BC42_INTF_SensorDataMsg_t *SensorDataMsg)
+void CTRL42_Run42Fsw(CTRL42_Class_t *Ctrl42, BC42_INTF_SensorDataMsg_t *SensorDataMsg)
 {
 
-   const BC42_Ac_t *Ac42;
+   CFE_TIME_SysTime_t SensorTime;
    
    CFE_EVS_SendEvent(CTRL42_DEBUG_CONTROLLER_EID, CFE_EVS_EventType_DEBUG,
                      "**** CTRL42_Run42Fsw(%d) ****", (int)Ctrl42->CtrlExeCnt);
     
-   if (BC42_RunController(&Ac42))
+   CFE_MSG_GetMsgTime(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), &SensorTime);
+   if (FAULT_INJ_Ingest(&Ctrl42->FaultInj, SensorTime, &SensorDataMsg->Payload, &Ctrl42->Sensor))
    {
-      SendControllerTlm(Ac42);
-      SendActuatorCmdMsg(Ac42);   
-      SetTakeSci();
+      Ctrl42->SensorTime = SensorTime;
+      RunCycle(Ctrl42, SensorDataMsg);
    }
    
 } /* End CTRL42_Run42Fsw() */
@@ -232,10 +307,12 @@ void CTRL42_Run42Fsw(BC42_INTF_SensorDataMsg_t *SensorDataMsg)
 **
 ** Send the control gains telemetry packet containing the gains from the
 ** control table.
+**
 */
 bool CTRL42_SendCtrlGainsTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   CTRL42_Class_t *Ctrl42 = (CTRL42_Class_t *)ObjDataPtr;
    int32  CfeStatus;
    BC42_CtrlGains_t CtrlGains;
    BC42_CTRL_ControlGainsTlm_Payload_t *TlmPayload = &Ctrl42->ControlGainsTlm.Payload;
@@ -275,7 +352,7 @@ bool CTRL42_SendCtrlGainsTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
 /******************************************************************************
 ** Function: CTRL42_SetBoolOvrStateCmd
 **
-** Set/Clear the command specified boolean overrride
+** Set the command specified sensor validity flag override
 **
 ** Notes:
 **   1. This is useful for fault testing.
@@ -283,40 +360,36 @@ bool CTRL42_SendCtrlGainsTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
 bool CTRL42_SetBoolOvrStateCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   CTRL42_Class_t *Ctrl42 = (CTRL42_Class_t *)ObjDataPtr;
    const BC42_CTRL_SetBoolOvrState_CmdPayload_t *CmdPayload = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_CTRL_SetBoolOvrState_t);
    bool  RetStatus = false;
-   int   i;
    
-   for (i=BC42_CTRL_Bool42Id_Enum_t_MIN; i < BC42_CTRL_Bool42State_Enum_t_MAX; i++)
-   {
-      Ctrl42->BoolOverride[i] = BC42_CTRL_Bool42State_USE_SIM;
-   }
-
-   if (CmdPayload->Id <= BC42_CTRL_Bool42Id_Enum_t_MAX)
+   if (CmdPayload->Id < BC42_CTRL_Bool42Id_COUNT)
    {
      
-      if (CmdPayload->State >= BC42_CTRL_Bool42State_Enum_t_MIN && CmdPayload->State <= BC42_CTRL_Bool42State_Enum_t_MAX)
+      if (CmdPayload->State < BC42_CTRL_Bool42State_COUNT)
       {
-         Ctrl42->BoolOverride[CmdPayload->Id] = CmdPayload->State;
+         BOOL_OVR_SetState(&Ctrl42->BoolOvr, CmdPayload->Id, CmdPayload->State);
          RetStatus = true;
          CFE_EVS_SendEvent(CTRL42_SET_BOOL_OVR_EID, CFE_EVS_EventType_INFORMATION,
-                           "Set override identifier %d to state %s", CmdPayload->Id, BoolOverrideStr(CmdPayload->State));
-         CFE_EVS_SendEvent(CTRL42_SET_BOOL_OVR_EID, CFE_EVS_EventType_INFORMATION,
-                           "Currently this command does not effect the 42 controller ported to this app"); 
-	  }
-	  else {
+                           "Set override identifier %d to state %s. Set mask 0x%02X, clear mask 0x%02X",
+                           CmdPayload->Id, BoolOverrideStr(CmdPayload->State),
+                           (unsigned int)Ctrl42->BoolOvr.SetMask, (unsigned int)Ctrl42->BoolOvr.ClrMask);
+      }
+      else
+      {
          CFE_EVS_SendEvent(CTRL42_SET_BOOL_OVR_EID, CFE_EVS_EventType_ERROR,
-                           "Invalid commanded override state %d. Must be between %d and %d inclusively",\
-                           CmdPayload->State,BC42_CTRL_Bool42State_Enum_t_MIN,BC42_CTRL_Bool42State_Enum_t_MAX);
-	  } /* End if valid state */
+                           "Invalid commanded override state %d. Must be less than %d",
+                           CmdPayload->State, BC42_CTRL_Bool42State_COUNT);
+      } /* End if valid state */
 	  
    } /* End if valid ID */
    
    else
    {
       CFE_EVS_SendEvent(CTRL42_SET_BOOL_OVR_EID, CFE_EVS_EventType_ERROR,
-                        "Invalid commanded override identifier %d is greater than max ID %d",
-                        CmdPayload->Id, BC42_CTRL_Bool42Id_Enum_t_MAX); 
+                        "Invalid commanded override identifier %d. Must be less than %d",
+                        CmdPayload->Id, BC42_CTRL_Bool42Id_COUNT); 
    }
 
    return RetStatus;
@@ -327,17 +400,45 @@ bool CTRL42_SetBoolOvrStateCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 /******************************************************************************
 ** Function: CTRL42_SetCtrlModeCmd
 **
-** Currently controller doesn't have modes so this command only lets the
-** user force a controller initialization.
+** Notes:
+**   1. A later command replaces a transition that hasn't been applied.
+**      Commanding the current mode cancels a pending transition.
 */
 bool CTRL42_SetCtrlModeCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   CTRL42_Class_t *Ctrl42 = (CTRL42_Class_t *)ObjDataPtr;
    const BC42_CTRL_SetCtrlMode_CmdPayload_t *CmdPayload = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_CTRL_SetCtrlMode_t);
-   bool  RetStatus = true;
+   bool  RetStatus = false;
 
-   CFE_EVS_SendEvent(CTRL42_SET_CTRL_MODE_EID, CFE_EVS_EventType_INFORMATION,
-                    "Received set controler mode %d", CmdPayload->NewMode);
+   if (CmdPayload->NewMode >= BC42_CTRL_ControlMode_COUNT)
+   {
+      CFE_EVS_SendEvent(CTRL42_SET_CTRL_MODE_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid commanded controller mode %d. Must be less than %d",
+                        CmdPayload->NewMode, BC42_CTRL_ControlMode_COUNT);
+   }
+   else if (CmdPayload->NewMode == Ctrl42->CtrlMode)
+   {
+      Ctrl42->PendingMode = BC42_CTRL_ControlMode_COUNT;
+      RetStatus = true;
+      CFE_EVS_SendEvent(CTRL42_SET_CTRL_MODE_EID, CFE_EVS_EventType_INFORMATION,
+                        "CTRL42 already in mode %s", Ctrl42->ModeDef->Name);
+   }
+   else if ((ModeDef[CmdPayload->NewMode].EnterFrom & MODE_BIT(Ctrl42->CtrlMode)) == 0)
+   {
+      Ctrl42->ModeRejectCnt++;
+      CFE_EVS_SendEvent(CTRL42_SET_CTRL_MODE_EID, CFE_EVS_EventType_ERROR,
+                        "CTRL42 mode %s can't be entered from mode %s",
+                        ModeDef[CmdPayload->NewMode].Name, Ctrl42->ModeDef->Name);
+   }
+   else
+   {
+      Ctrl42->PendingMode = CmdPayload->NewMode;
+      RetStatus = true;
+      CFE_EVS_SendEvent(CTRL42_SET_CTRL_MODE_EID, CFE_EVS_EventType_INFORMATION,
+                        "CTRL42 transition from %s to %s requested for the next control cycle",
+                        Ctrl42->ModeDef->Name, ModeDef[CmdPayload->NewMode].Name);
+   }
 
    return RetStatus;
 
@@ -353,15 +454,17 @@ bool CTRL42_SetCtrlModeCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 bool CTRL42_SetWheelTargetMomCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   CTRL42_Class_t *Ctrl42 = (CTRL42_Class_t *)ObjDataPtr;
    const BC42_CTRL_SetWheelTargetMom_CmdPayload_t *CmdPayload = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_CTRL_SetWheelTargetMom_t);
+   const CTRL42_TBL_Data_t *TblData = CTRL42_TBL_GetData(&Ctrl42->Tbl);
    bool   RetStatus = false;
    uint8  ValidWheels = 0, i;   
 
    for (i=0; i < BC42_NWHL; i++)
    {
    
-      if ( CmdPayload->Wheel[i] >= Ctrl42->Tbl.Data.HcmdLim.Lower &&
-           CmdPayload->Wheel[i] <= Ctrl42->Tbl.Data.HcmdLim.Upper )
+      if ( CmdPayload->Wheel[i] >= TblData->HcmdLim.Lower &&
+           CmdPayload->Wheel[i] <= TblData->HcmdLim.Upper )
       {
          Ctrl42->Hcmd[i] = CmdPayload->Wheel[i];
          ValidWheels++;
@@ -370,7 +473,7 @@ bool CTRL42_SetWheelTargetMomCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgP
       {   
          CFE_EVS_SendEvent(CTRL42_WHL_TARGET_MOM_CMD_EID, CFE_EVS_EventType_ERROR,
                            "Commanded target wheel %d momentum %0.6e exceeds (lower,upper) limits (%0.6e,%0.6e)",
-                           i, CmdPayload->Wheel[i], Ctrl42->Tbl.Data.HcmdLim.Lower, Ctrl42->Tbl.Data.HcmdLim.Upper);
+                           i, CmdPayload->Wheel[i], TblData->HcmdLim.Lower, TblData->HcmdLim.Upper);
       }
       
    } /* End wheel loop */ 
@@ -395,36 +498,379 @@ bool CTRL42_SetWheelTargetMomCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgP
 
 
 /******************************************************************************
-** Function: AcceptNewTbl
+** Function: ApplyPendingMode
+**
+** Apply a commanded mode transition if the new mode's guards are satisfied
+** by the sensor data being processed.
+**
+*/
+static void ApplyPendingMode(CTRL42_Class_t *Ctrl42)
+{
+
+   const CTRL42_ModeDef_t *NewModeDef;
+   const char *Guard = NULL;
+
+   if (Ctrl42->PendingMode != BC42_CTRL_ControlMode_COUNT)
+   {
+
+      NewModeDef = &ModeDef[Ctrl42->PendingMode];
+
+      if ((NewModeDef->Requires & MODE_REQ_SUN_VALID) & ~Ctrl42->SensorValid)
+      {
+         Guard = "sun sensor data isn't valid";
+      }
+      else if ((NewModeDef->Requires & MODE_REQ_ST_VALID) & ~Ctrl42->SensorValid)
+      {
+         Guard = "star tracker data isn't valid";
+      }
+
+      if (Guard == NULL)
+      {
+         CFE_EVS_SendEvent(CTRL42_MODE_TRANS_EID, CFE_EVS_EventType_INFORMATION,
+                           "CTRL42 mode changed from %s to %s after control cycle %u",
+                           Ctrl42->ModeDef->Name, NewModeDef->Name,
+                           (unsigned int)Ctrl42->CtrlExeCnt);
+         Ctrl42->CtrlMode = Ctrl42->PendingMode;
+         Ctrl42->ModeDef  = NewModeDef;
+         Ctrl42->ModeTransCnt++;
+         CTRL_LAW_Reset(&Ctrl42->CtrlLaw);
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CTRL42_MODE_TRANS_EID, CFE_EVS_EventType_ERROR,
+                           "CTRL42 transition from %s to %s rejected, %s",
+                           Ctrl42->ModeDef->Name, NewModeDef->Name, Guard);
+         Ctrl42->ModeRejectCnt++;
+      }
+
+      Ctrl42->PendingMode = BC42_CTRL_ControlMode_COUNT;
+
+   } /* End if pending transition */
+
+} /* End ApplyPendingMode() */
+
+
+/******************************************************************************
+** Function: ClearTakeSci
+**
+** TakeSci function for modes that don't take science. The init cycle
+** counter restarts so science waits for the controller to settle after
+** SCIENCE is entered.
+**
+*/
+static void ClearTakeSci(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
+{
+
+   Ctrl42->TakeSci = false;
+   Ctrl42->TakeSciInitCycCtr = Ctrl42->TakeSciInitCyc;
+
+} /* End ClearTakeSci() */
+
+
+/******************************************************************************
+** Function: CommitTbl
+**
+** Make a newly accepted table active. Its gains are loaded by UpdateGains().
+**
+*/
+static void CommitTbl(CTRL42_Class_t *Ctrl42)
+{
+
+   if (CTRL42_TBL_Commit(&Ctrl42->Tbl))
+   {
+
+      Ctrl42->GainsValid = false;
+      Ctrl42->SchedSeg   = 0;
+      CTRL_LAW_SetCfg(&Ctrl42->CtrlLaw, &CTRL42_TBL_GetData(&Ctrl42->Tbl)->Law);
+
+      CFE_EVS_SendEvent(CTRL42_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_INFORMATION,
+                        "CTRL42 table committed after control cycle %u",
+                        (unsigned int)Ctrl42->CtrlExeCnt);
+   }
+
+} /* End CommitTbl() */
+
+
+/******************************************************************************
+** Function: InterpSchedGains
+**
+** Interpolate the gain schedule at Ctrl42->HvbMag. Gains are held at the
+** end breakpoints outside the schedule's range.
 **
 ** Notes:
-**   1. This is an example table load callback function to illustrate how table
-**      load paramaters can be validated as part of the table load process.
-**   2. Setting gains here assumes the table load function doesn't perform any 
-**      additional checks that could reject the table. If the table later gets
-**      rejected then the controller gains being used won't reflect the gains in
-**      the table. 
+**   1. |Hvb| changes slowly so the previous segment or one of its
+**      neighbours almost always brackets it. Otherwise the segment is
+**      found with a binary search of the breakpoints.
+**   2. Sched->PtCnt must be at least one.
+**
 */
-static bool AcceptNewTbl(const CTRL42_TBL_Data_t *TblData)
+static void InterpSchedGains(CTRL42_Class_t *Ctrl42, const CTRL42_TBL_Sched_t *Sched,
+                             BC42_CtrlGains_t *Gains)
 {
-   int i;
-   BC42_CtrlGains_t CtrlGains;
-   
-   for(i=0; i < 3; i++)
+
+   const float *Brk = Sched->HvbMag;
+   const CTRL42_TBL_Gains_t *G0, *G1;
+   double X = Ctrl42->HvbMag;
+   double T = 0.0;
+   uint32 Last = Sched->PtCnt - 1;
+   uint32 Seg  = Ctrl42->SchedSeg;
+   uint32 Lo, Hi, Mid;
+   int    i;
+
+   if (!(X > Brk[0]))
    {
-      CtrlGains.Kp[i] = TblData->Kp[i];
-      CtrlGains.Kr[i] = TblData->Kr[i];
+      Seg = 0;
+      G0 = G1 = &Sched->Gains[0];
    }
-   CtrlGains.Kunl = TblData->Kunl;
+   else if (X >= Brk[Last])
+   {
+      Seg = Last;
+      G0 = G1 = &Sched->Gains[Last];
+   }
+   else
+   {
+      if (Seg >= Last || X < Brk[Seg] || X >= Brk[Seg+1])
+      {
+         if (Seg+1 < Last && X >= Brk[Seg+1] && X < Brk[Seg+2])
+         {
+            Seg++;
+         }
+         else if (Seg > 0 && X >= Brk[Seg-1] && X < Brk[Seg])
+         {
+            Seg--;
+         }
+         else
+         {
+            /* Brk[Lo] <= X < Brk[Hi] */
+            Lo = 0;
+            Hi = Last;
+            while (Hi - Lo > 1)
+            {
+               Mid = (Lo + Hi) / 2;
+               if (X >= Brk[Mid])
+               {
+                  Lo = Mid;
+               }
+               else
+               {
+                  Hi = Mid;
+               }
+            }
+            Seg = Lo;
+         }
+      }
+      G0 = &Sched->Gains[Seg];
+      G1 = &Sched->Gains[Seg+1];
+      T  = (X - Brk[Seg]) / (Brk[Seg+1] - Brk[Seg]);
+   }
+
+   for (i=0; i < 3; i++)
+   {
+      Gains->Kp[i] = G0->Kp[i] + T*(G1->Kp[i] - G0->Kp[i]);
+      Gains->Kr[i] = G0->Kr[i] + T*(G1->Kr[i] - G0->Kr[i]);
+   }
+   Gains->Kunl = G0->Kunl + T*(G1->Kunl - G0->Kunl);
+
+   Ctrl42->SchedSeg = Seg;
+
+} /* End InterpSchedGains() */
+
+
+/******************************************************************************
+** Function: RunCycle
+**
+** Process an ingested sensor data message. See CTRL42_Run42Fsw() notes.
+**
+*/
+static void RunCycle(CTRL42_Class_t *Ctrl42, BC42_INTF_SensorDataMsg_t *SensorDataMsg)
+{
+
+   const BC42_Ac_t *Ac42;
+   bool  ControllerRan;
    
-   BC42_SetControlGains(&CtrlGains);
+   PERIOD_MON_StartCycle(&Ctrl42->PeriodMon);
+   CYCLE_PROF_StartCycle(&Ctrl42->CycleProf);
+   DEADLINE_MON_StartCycle(&Ctrl42->DeadlineMon);
    
-   CFE_EVS_SendEvent (CTRL42_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_INFORMATION, 
-                      "New CTRL42 table accepted");
+   Ctrl42->SensorValid = BOOL_OVR_Apply(&Ctrl42->BoolOvr, BOOL_OVR_PackSensor(&Ctrl42->Sensor));
+   BOOL_OVR_UnpackSensor(&Ctrl42->Sensor, Ctrl42->SensorValid);
+    
+   CommitTbl(Ctrl42);
+   UpdateGains(Ctrl42);
+   ApplyPendingMode(Ctrl42);
 
-   return true;
+   CYCLE_PROF_StartPhase(&Ctrl42->CycleProf, CYCLE_PROF_RUN_CONTROLLER);
+   ControllerRan = BC42_RunController(&Ac42);
+   if (ControllerRan)
+   {
+      CTRL_LAW_Run(&Ctrl42->CtrlLaw, Ac42, Ctrl42->Tcmd);
+   }
+   CYCLE_PROF_EndPhase(&Ctrl42->CycleProf, CYCLE_PROF_RUN_CONTROLLER);
    
-} /* End AcceptNewTbl() */
+   if (ControllerRan)
+   {
+      
+      Ctrl42->CtrlExeCnt++;
+      Ctrl42->HvbMag = sqrt(Ac42->Hvb[0]*Ac42->Hvb[0] + Ac42->Hvb[1]*Ac42->Hvb[1] +
+                            Ac42->Hvb[2]*Ac42->Hvb[2]);
+      
+      CYCLE_PROF_StartPhase(&Ctrl42->CycleProf, CYCLE_PROF_SEND_ACTUATOR_CMD);
+      Ctrl42->ModeDef->SendActuatorCmd(Ctrl42, Ac42);   
+      CYCLE_PROF_EndPhase(&Ctrl42->CycleProf, CYCLE_PROF_SEND_ACTUATOR_CMD);
+      
+      DEADLINE_MON_CheckRisk(&Ctrl42->DeadlineMon);
+
+      if (!DEADLINE_MON_Shed(&Ctrl42->DeadlineMon, DEADLINE_MON_SHED_CTRL_TLM))
+      {
+         CYCLE_PROF_StartPhase(&Ctrl42->CycleProf, CYCLE_PROF_SEND_CONTROLLER_TLM);
+         Ctrl42->ModeDef->SendControllerTlm(Ctrl42, Ac42);
+         CYCLE_PROF_EndPhase(&Ctrl42->CycleProf, CYCLE_PROF_SEND_CONTROLLER_TLM);
+      }
+      
+      if (!DEADLINE_MON_Shed(&Ctrl42->DeadlineMon, DEADLINE_MON_SHED_TAKE_SCI))
+      {
+         CYCLE_PROF_StartPhase(&Ctrl42->CycleProf, CYCLE_PROF_SET_TAKE_SCI);
+         Ctrl42->ModeDef->SetTakeSci(Ctrl42, Ac42);
+         CYCLE_PROF_EndPhase(&Ctrl42->CycleProf, CYCLE_PROF_SET_TAKE_SCI);
+      }
+      
+      if (!DEADLINE_MON_Shed(&Ctrl42->DeadlineMon, DEADLINE_MON_SHED_DEBUG_LOG))
+      {
+         DEBUG_LOG_AddRec(Ctrl42->DebugLog, SensorDataMsg, Ac42, Ctrl42->TcmdSent,
+                          Ctrl42->SensorValid, Ctrl42->TakeSci, Ctrl42->CycleProf.CycleStart);
+      }
+   
+   }
+   
+   DEADLINE_MON_EndCycle(&Ctrl42->DeadlineMon);
+   CYCLE_PROF_EndCycle(&Ctrl42->CycleProf);
+   PERIOD_MON_EndCycle(&Ctrl42->PeriodMon);
+   
+} /* End RunCycle() */
+
+
+/******************************************************************************
+** Function: UpdateGains
+**
+** Recompute the cycle's gains and load them into BC42_LIB if they
+** changed.
+**
+** Notes:
+**   1. Fixed gains are only recomputed after a table commit and scheduled
+**      gains only when the schedule variable changes.
+**
+*/
+static void UpdateGains(CTRL42_Class_t *Ctrl42)
+{
+
+   const CTRL42_TBL_Data_t *TblData = CTRL42_TBL_GetData(&Ctrl42->Tbl);
+   BC42_CtrlGains_t Gains;
+   bool   Changed = false;
+   int    i;
+
+   if (!Ctrl42->GainsValid ||
+       (TblData->GainSched.PtCnt > 0 && Ctrl42->HvbMag != Ctrl42->GainsHvbMag))
+   {
+
+      if (TblData->GainSched.PtCnt > 0)
+      {
+         InterpSchedGains(Ctrl42, &TblData->GainSched, &Gains);
+      }
+      else
+      {
+         for (i=0; i < 3; i++)
+         {
+            Gains.Kp[i] = TblData->Kp[i];
+            Gains.Kr[i] = TblData->Kr[i];
+         }
+         Gains.Kunl = TblData->Kunl;
+      }
+
+      Changed = !Ctrl42->GainsValid || (memcmp(&Gains, &Ctrl42->Gains, sizeof(BC42_CtrlGains_t)) != 0);
+      if (Changed)
+      {
+         Ctrl42->Gains = Gains;
+         CTRL_LAW_SetGains(&Ctrl42->CtrlLaw, &Gains);
+         BC42_SetControlGains(&Ctrl42->Gains);
+      }
+      Ctrl42->GainsHvbMag = Ctrl42->HvbMag;
+      Ctrl42->GainsValid  = true;
+
+   } /* End if recompute */
+
+} /* End UpdateGains() */
+
+
+/******************************************************************************
+** Function: ValidateNewTbl
+**
+** Notes:
+**   1. Only validates. Accepted data is committed at the start of the next
+**      control cycle by CommitTbl().
+**   2. The negated comparisons also reject NaNs.
+*/
+static bool ValidateNewTbl(const CTRL42_TBL_Data_t *TblData)
+{
+
+   const CTRL42_TBL_Sched_t *Sched = &TblData->GainSched;
+   bool   RetStatus = true;
+   bool   SchedValid;
+   uint32 Pt;
+   int    i;
+
+   for (i=0; i < 3; i++)
+   {
+      if (!(TblData->Kp[i] >= 0.0) || !(TblData->Kr[i] >= 0.0) || !(TblData->SciThetaLim[i] > 0.0) ||
+          !(TblData->Law.Ki[i] >= 0.0))
+      {
+         RetStatus = false;
+      }
+   }
+   if (!(TblData->Kunl >= 0.0) || !(TblData->HcmdLim.Lower <= TblData->HcmdLim.Upper))
+   {
+      RetStatus = false;
+   }
+   if (!(TblData->Law.IntLim > 0.0) || !(TblData->Law.TcmdLim > 0.0) ||
+       !(TblData->Law.WhlTcmdLim > 0.0) || !(TblData->Law.SrLambda >= 0.0))
+   {
+      RetStatus = false;
+   }
+
+   SchedValid = (Sched->PtCnt <= CTRL42_TBL_SCHED_PT_MAX);
+   for (Pt=0; SchedValid && Pt < Sched->PtCnt; Pt++)
+   {
+      SchedValid = (Pt == 0) ? (Sched->HvbMag[0] >= 0.0) : (Sched->HvbMag[Pt] > Sched->HvbMag[Pt-1]);
+      for (i=0; i < 3; i++)
+      {
+         SchedValid &= (Sched->Gains[Pt].Kp[i] >= 0.0) && (Sched->Gains[Pt].Kr[i] >= 0.0);
+      }
+      SchedValid &= (Sched->Gains[Pt].Kunl >= 0.0);
+   }
+   if (!SchedValid)
+   {
+      CFE_EVS_SendEvent(CTRL42_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_ERROR,
+                        "New CTRL42 gain schedule invalid at breakpoint %u. Breakpoints must be "
+                        "non-negative and increasing and gains non-negative",
+                        (unsigned int)((Pt > 0) ? Pt-1 : 0));
+      RetStatus = false;
+   }
+
+   if (RetStatus)
+   {
+      CFE_EVS_SendEvent(CTRL42_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_INFORMATION,
+                        "New CTRL42 table accepted, commit at next control cycle");
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CTRL42_ACCEPT_NEW_TBL_EID, CFE_EVS_EventType_ERROR,
+                        "New CTRL42 table rejected. Gains and sr-lambda must be non-negative, "
+                        "science and control law limits positive and the wheel momentum lower limit "
+                        "at most the upper");
+   }
+
+   return RetStatus;
+
+} /* End ValidateNewTbl() */
 
 
 /******************************************************************************
@@ -444,7 +890,7 @@ static const char *BoolOverrideStr(BC42_CTRL_Bool42State_Enum_t State)
       "USE 42 SIM", "TRUE", "FALSE", "UNDEFINED"
    };
    
-   if (State >= BC42_CTRL_Bool42State_Enum_t_MIN && State <= BC42_CTRL_Bool42State_Enum_t_MAX)
+   if (State >= BC42_CTRL_Bool42State_Enum_t_MIN && State < BC42_CTRL_Bool42State_COUNT)
 
       return OverrideStr[State];
  
@@ -462,18 +908,18 @@ static const char *BoolOverrideStr(BC42_CTRL_Bool42State_Enum_t State)
 **   1. Checks whether control errors within science instrument accuracy needs
 **
 */
-static void SetTakeSci(void)
+static void SetTakeSci(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
 {
 
+   const CTRL42_TBL_Data_t *TblData = CTRL42_TBL_GetData(&Ctrl42->Tbl);
    bool TakeSci;
-   BC42_CTRL_ControllerTlm_Payload_t *ControllerTlm = &Ctrl42->ControllerTlm.Payload;
 
    if (Ctrl42->TakeSciInitCycCtr <= 0)
    {
    
-      TakeSci = ((fabs(ControllerTlm->therr[0]) < Ctrl42->Tbl.Data.SciThetaLim[0]) &&
-                 (fabs(ControllerTlm->therr[1]) < Ctrl42->Tbl.Data.SciThetaLim[1]) &&
-                 (fabs(ControllerTlm->therr[2]) < Ctrl42->Tbl.Data.SciThetaLim[2]));
+      TakeSci = ((fabs(Ac42->CmgCtrl.therr[0]) < TblData->SciThetaLim[0]) &&
+                 (fabs(Ac42->CmgCtrl.therr[1]) < TblData->SciThetaLim[1]) &&
+                 (fabs(Ac42->CmgCtrl.therr[2]) < TblData->SciThetaLim[2]));
 
       if (TakeSci == Ctrl42->TakeSci)
       {
@@ -505,67 +951,214 @@ static void SetTakeSci(void)
 /******************************************************************************
 ** Function: SendActuatorCmdMsg
 **
+** Send the controller's actuator commands.
+**
+*/ 
+static void SendActuatorCmdMsg(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
+{
+
+   TransmitActuatorCmd(Ctrl42, Ac42, Ctrl42->Tcmd);
+
+} /* End SendActuatorCmdMsg() */
+
+
+/******************************************************************************
+** Function: SendSafeActuatorCmd
+**
+** SAFE mode actuator command. The wheel torque command is zero and the
+** controller's magnetic torquer and solar array commands are sent.
+**
+*/ 
+static void SendSafeActuatorCmd(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
+{
+
+   static const double ZeroTcmd[3] = { 0.0, 0.0, 0.0 };
+
+   TransmitActuatorCmd(Ctrl42, Ac42, ZeroTcmd);
+
+} /* End SendSafeActuatorCmd() */
+
+
+/******************************************************************************
+** Function: TransmitActuatorCmd
+**
 ** Notes:
-**   None
+**   1. See BC42_CTRL_SB_ZERO_COPY in bc42_ctrl_platform_cfg.h. In zero copy
+**      mode the message is built in a software bus buffer and ownership of
+**      the buffer passes to the software bus when it is transmitted.
+**   2. The actuator command time stamp closes the sensor-to-actuator
+**      latency measurement so it's read before the message is transmitted.
+**   3. A command that missed the cycle's deadline isn't sent because the
+**      deadline watchdog has sent the safe actuator command. See
+**      deadline_mon.h.
+**   4. TcmdSent records the torque command the actuators were sent this
+**      cycle, which is zero in SAFE mode and after a missed deadline, for
+**      controller telemetry.
 **
 */ 
-static void SendActuatorCmdMsg(const BC42_Ac_t *Ac42)
+static void TransmitActuatorCmd(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42, const double Tcmd[3])
 {
 
    int i;
-   BC42_INTF_ActuatorCmdMsg_Payload_t *ActuatorCmdPayload = &Ctrl42->ActuatorCmdMsg.Payload;
+   BC42_INTF_ActuatorCmdMsg_t *ActuatorCmdMsg;
+   CFE_TIME_SysTime_t ActuatorTime;
    
-   for (i=0; i < 3; i++)
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+   ActuatorCmdMsg = (BC42_INTF_ActuatorCmdMsg_t *)CFE_SB_AllocateMessageBuffer(sizeof(BC42_INTF_ActuatorCmdMsg_t));
+#else
+   ActuatorCmdMsg = &Ctrl42->ActuatorCmdMsg;
+#endif
+   
+   if (ActuatorCmdMsg != NULL)
    {
-      ActuatorCmdPayload->Tcmd[i] = Ac42->Tcmd[i];
-      ActuatorCmdPayload->Mcmd[i] = Ac42->Mcmd[i];
-   }
-   ActuatorCmdPayload->SaGcmd = Ac42->G[0].GCmd.AngRate[0];
 
-   CFE_EVS_SendEvent(CTRL42_DEBUG_CONTROLLER_EID, CFE_EVS_EventType_DEBUG, "**** SendActuatorPkt()\n");
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+      CFE_MSG_Init(CFE_MSG_PTR(ActuatorCmdMsg->TelemetryHeader), Ctrl42->ActuatorCmdMsgMid, sizeof(BC42_INTF_ActuatorCmdMsg_t));
+#endif
+
+      for (i=0; i < 3; i++)
+      {
+         ActuatorCmdMsg->Payload.Tcmd[i] = Tcmd[i];
+         ActuatorCmdMsg->Payload.Mcmd[i] = Ac42->Mcmd[i];
+      }
+      ActuatorCmdMsg->Payload.SaGcmd = Ac42->G[0].GCmd.AngRate[0];
+
+      CFE_EVS_SendEvent(CTRL42_DEBUG_CONTROLLER_EID, CFE_EVS_EventType_DEBUG, "**** SendActuatorPkt()\n");
+      
+      if (DEADLINE_MON_ClaimActuator(&Ctrl42->DeadlineMon))
+      {
       
-   CFE_SB_TimeStampMsg(CFE_MSG_PTR(Ctrl42->ActuatorCmdMsg.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(Ctrl42->ActuatorCmdMsg.TelemetryHeader), true);
+         for (i=0; i < 3; i++)
+         {
+            Ctrl42->TcmdSent[i] = Tcmd[i];
+         }
+         CFE_SB_TimeStampMsg(CFE_MSG_PTR(ActuatorCmdMsg->TelemetryHeader));
+         CFE_MSG_GetMsgTime(CFE_MSG_PTR(ActuatorCmdMsg->TelemetryHeader), &ActuatorTime);
+         LATENCY_MON_AddSample(&Ctrl42->LatencyMon, Ctrl42->SensorTime, ActuatorTime);
+   
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+         if (CFE_SB_TransmitBuffer((CFE_SB_Buffer_t *)ActuatorCmdMsg, true) != CFE_SUCCESS)
+         {
+            CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)ActuatorCmdMsg);
+         }
+#else
+         CFE_SB_TransmitMsg(CFE_MSG_PTR(ActuatorCmdMsg->TelemetryHeader), true);
+#endif
+      }
+      else
+      {
+         CFE_PSP_MemSet((void*)Ctrl42->TcmdSent, 0, sizeof(Ctrl42->TcmdSent));
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+         CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)ActuatorCmdMsg);
+#endif
+      }
 
-} // End SendActuatorCmdMsg() */
+   } /* End if message buffer */
+   
+} // End TransmitActuatorCmd() */
 
 
 /******************************************************************************
 ** Function: SendControllerTlm
 **
 ** Notes:
-**   None
+**   1. When controller telemetry is decimated the sample is accumulated
+**      by CtrlStats instead. See ctrl_stats.h.
+**
+*/ 
+static void SendControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
+{
+
+   if (CTRL_STATS_Decimated(&Ctrl42->CtrlStats))
+   {
+      CTRL_STATS_AddSample(&Ctrl42->CtrlStats, Ac42, Ctrl42->Tcmd);
+   }
+   else
+   {
+      TransmitControllerTlm(Ctrl42, Ac42);
+   }
+
+} /* End SendControllerTlm() */
+
+
+/******************************************************************************
+** Function: SendRawControllerTlm
+**
+** Send controller telemetry every cycle regardless of decimation.
+**
+*/ 
+static void SendRawControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
+{
+
+   TransmitControllerTlm(Ctrl42, Ac42);
+
+} /* End SendRawControllerTlm() */
+
+
+/******************************************************************************
+** Function: TransmitControllerTlm
+**
+** Notes:
+**   1. See TransmitActuatorCmd() zero copy note.
+**   2. Tcmd is the torque command sent to the actuators, not the control
+**      law's, so SAFE mode reports zero. See TransmitActuatorCmd().
 **
 */ 
-static void SendControllerTlm(const BC42_Ac_t *Ac42)
+static void TransmitControllerTlm(CTRL42_Class_t *Ctrl42, const BC42_Ac_t *Ac42)
 {
 
    int i;
-   BC42_CTRL_ControllerTlm_Payload_t *ControllerTlmPayload = &Ctrl42->ControllerTlm.Payload;
+   BC42_CTRL_ControllerTlm_t *ControllerTlm;
+   BC42_CTRL_ControllerTlm_Payload_t *ControllerTlmPayload;
  
-   for (i=0; i < 3; i++)
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+   ControllerTlm = (BC42_CTRL_ControllerTlm_t *)CFE_SB_AllocateMessageBuffer(sizeof(BC42_CTRL_ControllerTlm_t));
+#else
+   ControllerTlm = &Ctrl42->ControllerTlm;
+#endif
+   
+   if (ControllerTlm != NULL)
    {
-      ControllerTlmPayload->wbn[i]   = Ac42->wbn[i];
-      ControllerTlmPayload->wln[i]   = Ac42->wln[i];
-      ControllerTlmPayload->qbr[i]   = Ac42->qbr[i];
-      ControllerTlmPayload->therr[i] = Ac42->CmgCtrl.therr[i];  //TODO: Assumes AcApp.c uses AcCmgCtrlType
-      ControllerTlmPayload->werr[i]  = Ac42->CmgCtrl.werr[i];   //TODO: Assumes AcApp.c uses AcCmgCtrlType
-      ControllerTlmPayload->Hvb[i]   = Ac42->Hvb[i];
-      ControllerTlmPayload->svb[i]   = Ac42->svb[i];
-      ControllerTlmPayload->Tcmd[i]  = Ac42->Tcmd[i];           //TODO: Should AcCmgCtrlType's Tcmd[] be used? 
-      ControllerTlmPayload->Mcmd[i]  = Ac42->Mcmd[i];
-   }
-   ControllerTlmPayload->qbr[3] = Ac42->qbr[3];
+
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+      CFE_MSG_Init(CFE_MSG_PTR(ControllerTlm->TelemetryHeader), Ctrl42->ControllerTlmMid, sizeof(BC42_CTRL_ControllerTlm_t));
+#endif
+
+      ControllerTlmPayload = &ControllerTlm->Payload;
+   
+      for (i=0; i < 3; i++)
+      {
+         ControllerTlmPayload->wbn[i]   = Ac42->wbn[i];
+         ControllerTlmPayload->wln[i]   = Ac42->wln[i];
+         ControllerTlmPayload->qbr[i]   = Ac42->qbr[i];
+         ControllerTlmPayload->therr[i] = Ac42->CmgCtrl.therr[i];  //TODO: Assumes AcApp.c uses AcCmgCtrlType
+         ControllerTlmPayload->werr[i]  = Ac42->CmgCtrl.werr[i];   //TODO: Assumes AcApp.c uses AcCmgCtrlType
+         ControllerTlmPayload->Hvb[i]   = Ac42->Hvb[i];
+         ControllerTlmPayload->svb[i]   = Ac42->svb[i];
+         ControllerTlmPayload->Tcmd[i]  = Ctrl42->TcmdSent[i];
+         ControllerTlmPayload->Mcmd[i]  = Ac42->Mcmd[i];
+      }
+      ControllerTlmPayload->qbr[3] = Ac42->qbr[3];
    
-   ControllerTlmPayload->SaGcmd   = Ac42->G[0].GCmd.AngRate[0]; //TODO: Don't like the [0] assumptions, but AcApp.c has them
-   ControllerTlmPayload->GpsValid = false;                      //TODO: Resolve where to get this 
-   ControllerTlmPayload->StValid  = Ac42->StValid;
-   ControllerTlmPayload->SunValid = Ac42->SunValid;
-   ControllerTlmPayload->TakeSci  = Ctrl42->TakeSci;
+      ControllerTlmPayload->SaGcmd   = Ac42->G[0].GCmd.AngRate[0]; //TODO: Don't like the [0] assumptions, but AcApp.c has them
+      ControllerTlmPayload->GpsValid = (Ctrl42->SensorValid & BOOL_OVR_BIT(BC42_CTRL_Bool42Id_Gps_VALID)) != 0;
+      ControllerTlmPayload->StValid  = (Ctrl42->SensorValid & BOOL_OVR_BIT(BC42_CTRL_Bool42Id_St_VALID)) != 0;
+      ControllerTlmPayload->SunValid = (Ctrl42->SensorValid & BOOL_OVR_BIT(BC42_CTRL_Bool42Id_Sun_VALID)) != 0;
+      ControllerTlmPayload->TakeSci  = Ctrl42->TakeSci;
    
-   CFE_EVS_SendEvent(CTRL42_DEBUG_CONTROLLER_EID, CFE_EVS_EventType_DEBUG, "**** SendControllerTlmMsg()\n");
+      CFE_EVS_SendEvent(CTRL42_DEBUG_CONTROLLER_EID, CFE_EVS_EventType_DEBUG, "**** SendControllerTlmMsg()\n");
       
-   CFE_SB_TimeStampMsg(CFE_MSG_PTR(Ctrl42->ControllerTlm.TelemetryHeader));
-   CFE_SB_TransmitMsg(CFE_MSG_PTR(Ctrl42->ControllerTlm.TelemetryHeader), true);
+      CFE_SB_TimeStampMsg(CFE_MSG_PTR(ControllerTlm->TelemetryHeader));
+   
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+      if (CFE_SB_TransmitBuffer((CFE_SB_Buffer_t *)ControllerTlm, true) != CFE_SUCCESS)
+      {
+         CFE_SB_ReleaseMessageBuffer((CFE_SB_Buffer_t *)ControllerTlm);
+      }
+#else
+      CFE_SB_TransmitMsg(CFE_MSG_PTR(ControllerTlm->TelemetryHeader), true);
+#endif
 
-} // End SendControllerTlm() */
+   } /* End if message buffer */
+   
+} // End TransmitControllerTlm() */
@@ -23,6 +23,38 @@
 **      42 interface. 
 **   3. In a more complex design individual objects should be created for
 **      sensors and actuators.
+**   4. The app has one CTRL42 object. BC42_LIB holds a single 42 AcType
+**      and one set of control gains, so more than one controller needs
+**      BC42_LIB to provide a context per controller.
+**   5. Each controller mode has a function set that sends the actuator
+**      command and controller telemetry and evaluates TakeSci. The set is
+**      selected when a mode transition is applied so the control cycle
+**      doesn't branch on the mode. Commanded transitions are checked
+**      against the mode's allowed source modes when commanded. At the start
+**      of the next control cycle they're checked against the mode's sensor
+**      validity guard using that cycle's overridden validity flags.
+**   6. The control law selected in the INI file computes the body torque
+**      command from BC42_LIB's control errors after BC42_LIB runs. The
+**      default BC42 law uses BC42_LIB's torque. See ctrl_law.h.
+**   7. Boolean overrides are applied to the sensor data validity flags when
+**      a sensor data message is ingested. The overridden flags are used by
+**      the mode guards and reported in controller telemetry. BC42_LIB reads
+**      its sensor validity from the AcType filled by BC42_INTF so its
+**      internal use of the flags isn't overridden. See bool_ovr.h.
+**   8. Each sensor data message is passed through the fault injection
+**      object, which may drop it or fault its values. The controller uses
+**      the faulted copy in Sensor. BC42_LIB reads its own AcType so
+**      scripted sensor value faults only reach the controller in builds
+**      where BC42_LIB's inputs come from Sensor, e.g. the host build. See
+**      fault_inj.h.
+**   9. The app checks every sensor data message it receives with
+**      CTRL42_CheckSensorMsg() before its sensor backlog policy and before
+**      fault injection. Duplicate, out of order and stale messages are
+**      rejected and never reach CTRL42_Run42Fsw(). See sensor_chk.h.
+**  10. The actuator command is sent as soon as the controller runs and
+**      before any optional work. A watchdog sends a safe actuator command
+**      if the cycle misses its deadline and optional work is shed when a
+**      cycle is at risk. See deadline_mon.h.
 */
 #ifndef _ctrl42_
 #define _ctrl42_
@@ -36,13 +68,21 @@
 #include "app_cfg.h"
 #include "bc42_lib.h"
 #include "ctrl42_tbl.h"
+#include "latency_mon.h"
+#include "cycle_prof.h"
+#include "period_mon.h"
+#include "ctrl_stats.h"
+#include "ctrl_law.h"
+#include "bool_ovr.h"
+#include "fault_inj.h"
+#include "sensor_chk.h"
+#include "deadline_mon.h"
+#include "debug_log.h"
 
 /***********************/
 /** Macro Definitions **/
 /***********************/
 
-#define BC42_NWHL  4  // TODO: Figure out good way to use 42 configuration that is defined in 42 text script
-
 
 /*
 ** Event Message IDs
@@ -51,12 +91,11 @@
 
 #define CTRL42_SET_BOOL_OVR_EID         (CTRL42_BASE_EID + 0)
 #define CTRL42_SET_CTRL_MODE_EID        (CTRL42_BASE_EID + 1)
-#define CTRL42_ENA_DEBUG_CMD_EID        (CTRL42_BASE_EID + 2)
-#define CTRL42_DIS_DEBUG_CMD_EID        (CTRL42_BASE_EID + 3)
 #define CTRL42_WHL_TARGET_MOM_CMD_EID   (CTRL42_BASE_EID + 4)
 #define CTRL42_INIT_CONTROLLER_EID      (CTRL42_BASE_EID + 5)
 #define CTRL42_DEBUG_CONTROLLER_EID     (CTRL42_BASE_EID + 6)
 #define CTRL42_ACCEPT_NEW_TBL_EID       (CTRL42_BASE_EID + 7)
+#define CTRL42_MODE_TRANS_EID           (CTRL42_BASE_EID + 8)
 
 
 /**********************/
@@ -73,6 +112,13 @@
 ** - See bc42_ctrl.xml EDS definitions
 */
 
+/******************************************************************************
+** Controller mode function set, defined in ctrl42.c
+*/
+
+typedef struct CTRL42_ModeDef CTRL42_ModeDef_t;
+
+
 /******************************************************************************
 ** BC42_CTRL Class
 */
@@ -87,12 +133,34 @@ typedef struct
    
    BC42_Class_t      *Bc42;
    CTRL42_TBL_Class_t Tbl;
+   
+   LATENCY_MON_Class_t  LatencyMon;
+   CYCLE_PROF_Class_t   CycleProf;
+   PERIOD_MON_Class_t   PeriodMon;
+   CTRL_STATS_Class_t   CtrlStats;
+   CTRL_LAW_Class_t     CtrlLaw;
+   BOOL_OVR_Class_t     BoolOvr;
+   FAULT_INJ_Class_t    FaultInj;
+   SENSOR_CHK_Class_t   SensorChk;
+   DEADLINE_MON_Class_t DeadlineMon;
+   DEBUG_LOG_Class_t   *DebugLog;    /* Owned by the app */
 
    /*
    ** CTRL42 Data 
    */
    
    uint32  CtrlExeCnt;
+   
+   BC42_CtrlGains_t    Gains;        /* Loaded into BC42_LIB when they change */
+   bool                GainsValid;   /* Cleared when a table commit requires Gains to be recomputed */
+   double              HvbMag;       /* Gain schedule variable, |Hvb| from the previous cycle */
+   double              GainsHvbMag;  /* HvbMag that Gains were interpolated for */
+   uint32              SchedSeg;     /* Gain schedule segment found by the previous lookup */
+   double              Tcmd[3];      /* Body torque command computed by CtrlLaw */
+   double              TcmdSent[3];  /* Body torque command in the last actuator command sent */
+   
+   CFE_TIME_SysTime_t  SensorTime;   /* Time stamp of the sensor data message being processed */
+   BC42_INTF_SensorDataMsg_Payload_t Sensor;  /* Ingested sensor data, faults and overrides applied */
 
    bool    TakeSci;
    int16   TakeSciInitCyc;
@@ -100,22 +168,30 @@ typedef struct
    int16   TakeSciTransCyc;
    int16   TakeSciTransCycCtr;
 
-   BC42_CTRL_Bool42State_Enum_t  BoolOverride[BC42_CTRL_Bool42State_COUNT];
-   uint16  CtrlMode;
+   BC42_CTRL_ControlMode_Enum_t  CtrlMode;
+   BC42_CTRL_ControlMode_Enum_t  PendingMode;  /* Applied at the next cycle start, COUNT if none */
+   const CTRL42_ModeDef_t       *ModeDef;      /* CtrlMode's function set */
+   uint16  ModeTransCnt;
+   uint16  ModeRejectCnt;
+   uint32  SensorValid;   /* BOOL_OVR flags of the sensor data being processed, overrides applied */
    
    float   Hcmd[BC42_NWHL]; /* TODO - 42 controller command interface */
    
-   bool      DebugEnabled;
-   osal_id_t DebugFileHandle;
-   char      DebugFilename[OS_MAX_PATH_LEN];
-   
    /*
    ** Messages
+   ** - Control cycle messages only have persistent storage when they are
+   **   not built in software bus buffers
    */
    
-   BC42_CTRL_ControllerTlm_t     ControllerTlm;
    BC42_CTRL_ControlGainsTlm_t   ControlGainsTlm;
+
+#if (BC42_CTRL_SB_ZERO_COPY == 1)
+   CFE_SB_MsgId_t  ControllerTlmMid;
+   CFE_SB_MsgId_t  ActuatorCmdMsgMid;
+#else
+   BC42_CTRL_ControllerTlm_t     ControllerTlm;
    BC42_INTF_ActuatorCmdMsg_t    ActuatorCmdMsg;
+#endif
    
 } CTRL42_Class_t;
 
@@ -133,31 +209,30 @@ typedef struct
 **   1. This must be called prior to any other function.
 **
 */
-void CTRL42_Constructor(CTRL42_Class_t *Ctrl42Obj, const INITBL_Class_t *IniTbl,
-                        TBLMGR_Class_t *TblMgr);
+void CTRL42_Constructor(CTRL42_Class_t *Ctrl42, const INITBL_Class_t *IniTbl,
+                        TBLMGR_Class_t *TblMgr, DEBUG_LOG_Class_t *DebugLog);
 
 
 /******************************************************************************
-** Function: CTRL42_DisableDebugLogCmd
+** Function:  CTRL42_ResetStatus
 **
-** TODO - Add file command parameter
 */
-bool CTRL42_DisableDebugLogCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+void CTRL42_ResetStatus(CTRL42_Class_t *Ctrl42);
 
 
 /******************************************************************************
-** Function: CTRL42_EnableDebugLogCmd
+** Function: CTRL42_CheckSensorMsg
 **
-** TODO - Add file command parameter
-*/
-bool CTRL42_EnableDebugLogCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
-
-
-/******************************************************************************
-** Function:  CTRL42_ResetStatus
+** Check a received sensor data message's sequence count and time stamp.
+** Returns true if the message can be passed to CTRL42_Run42Fsw().
+**
+** Notes:
+**   1. Must be called once for each received message, including messages
+**      the sensor backlog policy discards, so the sequence count gaps only
+**      count messages that never arrived. See sensor_chk.h.
 **
 */
-void CTRL42_ResetStatus(void);
+bool CTRL42_CheckSensorMsg(CTRL42_Class_t *Ctrl42, const BC42_INTF_SensorDataMsg_t *SensorDataMsg);
 
 
 /******************************************************************************
@@ -166,7 +241,7 @@ void CTRL42_ResetStatus(void);
 ** Run the 42 simulator's FSW algorithms
 **
 */
-void CTRL42_Run42Fsw(BC42_INTF_SensorDataMsg_t *SensorDataMsg);
+void CTRL42_Run42Fsw(CTRL42_Class_t *Ctrl42, BC42_INTF_SensorDataMsg_t *SensorDataMsg);
 
 
 /******************************************************************************
@@ -181,10 +256,12 @@ bool CTRL42_SendCtrlGainsTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPt
 /******************************************************************************
 ** Function: CTRL42_SetBoolOvrStateCmd
 **
-** Set/Clear the command specified 
+** Set the override state of the command specified sensor validity flag.
+** Other flags keep their state.
 **
 ** Notes:
-**   1. This is useful for fault testing.
+**   1. This is useful for fault testing. The override applies from the next
+**      sensor data message.
 */
 bool CTRL42_SetBoolOvrStateCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
@@ -192,8 +269,13 @@ bool CTRL42_SetBoolOvrStateCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr
 /******************************************************************************
 ** Function: CTRL42_SetCtrlModeCmd
 **
-** Currently controller doesn't have modes so this command only lets the
-** user force a controller initialization.
+** Request a controller mode transition. The transition is applied at the
+** start of the next control cycle if that cycle's sensor data satisfies the
+** mode's guard.
+**
+** Notes:
+**   1. The command is rejected if the new mode can't be entered from the
+**      current mode. See the mode definitions in ctrl42.c.
 */
 bool CTRL42_SetCtrlModeCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
 
@@ -16,8 +16,22 @@
 **    Implement the Controller parameter table
 **
 **  Notes:
-**    1. The static "TblData" serves as a table load buffer. Table dump data is
-**       read directly from table owner's table storage.
+**    1. The static "TblData" serves as a table load buffer. It starts as a
+**       copy of the loaded table's newest data and the JSON parser updates
+**       it as the file is read, so a partial load only changes the values
+**       in the file. Accepted loads are copied to the table's free copy,
+**       which StageData() makes the pending copy. Table dumps use the
+**       newest copy.
+**    2. Table files are parsed by JSON_STREAM while they're read so the
+**       file size isn't limited by a load buffer.
+**    3. A load reads the start of the file into "ImgBuf" with one read. If
+**       it's a binary table image the read holds the complete image,
+**       otherwise the file is parsed as JSON. ImgBuf has one spare byte so
+**       an image file with trailing data is detected.
+**    4. Gain schedule values are array elements so JSON_STREAM passes them
+**       to SchedValue() rather than matching them with JsonTblObjs. The
+**       values loaded for each breakpoint are tracked in "SchedLoad" and a
+**       schedule with a missing value is rejected.
 **
 */
 
@@ -25,6 +39,7 @@
 ** Include Files:
 */
 
+#include <stddef.h>
 #include <string.h>
 #include "ctrl42_tbl.h"
 
@@ -33,6 +48,14 @@
 /** Macro Definitions **/
 /***********************/
 
+/*
+** Gain schedule JSON keys. Breakpoint values are "gain-schedule.<field>"
+** where the fields are SCHED_MAG_KEY and the SchedGainKeys.
+*/
+#define SCHED_KEY        "gain-schedule"
+#define SCHED_MAG_KEY    "hvb-mag"
+#define SCHED_FIELD_CNT  (1 + (sizeof(SchedGainKeys)/sizeof(SchedGainKeys[0])))
+#define SCHED_FIELD_ALL  ((1 << SCHED_FIELD_CNT) - 1)
 
 /**********************/
 /** Type Definitions **/
@@ -43,16 +66,40 @@
 /** Local File Function Prototypes **/
 /************************************/
 
-static bool LoadJsonData(size_t JsonFileLen);
+static bool   AcceptTblData(CTRL42_TBL_Class_t *Ctrl42Tbl, size_t ObjLoadCnt);
+static bool   CheckSchedLoad(CTRL42_TBL_Class_t *Ctrl42Tbl, APP_C_FW_TblLoadOptions_Enum_t LoadType);
+static uint32 Crc32(uint32 Crc, const void *Data, size_t DataLen);
+static bool   DumpCmd(osal_id_t FileHandle);
+static bool   DumpTblFile(CTRL42_TBL_Class_t *Ctrl42Tbl, osal_id_t FileHandle);
+static bool   LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename);
+static bool   LoadImg(CTRL42_TBL_Class_t *Ctrl42Tbl, const char *Filename, int32 ImgLen);
+static bool   LoadTblFile(CTRL42_TBL_Class_t *Ctrl42Tbl, APP_C_FW_TblLoadOptions_Enum_t LoadType,
+                          const char *Filename);
+static uint32 SchemaHash(void);
+static bool   SchedValue(void *UserObj, const JSON_STREAM_Value_t *Value);
+static void   StageData(CTRL42_TBL_Class_t *Ctrl42Tbl, const CTRL42_TBL_Data_t *Data);
 
 
 /**********************/
 /** Global File Data **/
 /**********************/
 
-static CTRL42_TBL_Class_t *Ctrl42Tbl = NULL;
+static CTRL42_TBL_Class_t *Ctrl42TblObj = NULL;  /* Table manager callbacks don't identify a table */
 
-static CTRL42_TBL_Data_t TblData; /* Working buffer for loads */
+static CTRL42_TBL_Data_t   TblData;      /* Working buffer for loads */
+static JSON_STREAM_Class_t JsonStream;
+
+static struct
+{
+   CTRL42_TBL_Img_t  Img;
+   uint8             Extra;
+} ImgBuf;
+
+static struct
+{
+   bool   InFile;                          /* Load file contains a gain schedule */
+   uint8  Field[CTRL42_TBL_SCHED_PT_MAX];  /* Bit mask of each breakpoint's loaded fields */
+} SchedLoad;
 
 static CJSON_Obj_t JsonTblObjs[] = 
 {
@@ -70,7 +117,29 @@ static CJSON_Obj_t JsonTblObjs[] =
    { &TblData.SciThetaLim[1],   sizeof(float),      false,   JSONNumber, true,   { "sci-theta-lim.y",     (sizeof("sci-theta-lim.y")-1)}  },
    { &TblData.SciThetaLim[2],   sizeof(float),      false,   JSONNumber, true,   { "sci-theta-lim.z",     (sizeof("sci-theta-lim.z")-1)}  },
    { &TblData.HcmdLim.Lower,    sizeof(float),      false,   JSONNumber, true,   { "hcmd-lim.lower",      (sizeof("hcmd-lim.lower")-1)}   },
-   { &TblData.HcmdLim.Upper,    sizeof(float),      false,   JSONNumber, true,   { "hcmd-lim.upper",      (sizeof("hcmd-lim.upper")-1)}   }
+   { &TblData.HcmdLim.Upper,    sizeof(float),      false,   JSONNumber, true,   { "hcmd-lim.upper",      (sizeof("hcmd-lim.upper")-1)}   },
+   { &TblData.Law.Ki[0],        sizeof(float),      false,   JSONNumber, true,   { "pid.ki.x",            (sizeof("pid.ki.x")-1)}         },
+   { &TblData.Law.Ki[1],        sizeof(float),      false,   JSONNumber, true,   { "pid.ki.y",            (sizeof("pid.ki.y")-1)}         },
+   { &TblData.Law.Ki[2],        sizeof(float),      false,   JSONNumber, true,   { "pid.ki.z",            (sizeof("pid.ki.z")-1)}         },
+   { &TblData.Law.IntLim,       sizeof(float),      false,   JSONNumber, true,   { "pid.int-lim",         (sizeof("pid.int-lim")-1)}      },
+   { &TblData.Law.TcmdLim,      sizeof(float),      false,   JSONNumber, true,   { "pid.tcmd-lim",        (sizeof("pid.tcmd-lim")-1)}     },
+   { &TblData.Law.WhlTcmdLim,   sizeof(float),      false,   JSONNumber, true,   { "steer.whl-tcmd-lim",  (sizeof("steer.whl-tcmd-lim")-1)} },
+   { &TblData.Law.SrLambda,     sizeof(float),      false,   JSONNumber, true,   { "steer.sr-lambda",     (sizeof("steer.sr-lambda")-1)}  }
+};
+
+static const struct
+{
+   const char *Key;
+   size_t      Offset;  /* In CTRL42_TBL_Gains_t */
+} SchedGainKeys[] =
+{
+   { "kp.x",   offsetof(CTRL42_TBL_Gains_t, Kp[0]) },
+   { "kp.y",   offsetof(CTRL42_TBL_Gains_t, Kp[1]) },
+   { "kp.z",   offsetof(CTRL42_TBL_Gains_t, Kp[2]) },
+   { "kr.x",   offsetof(CTRL42_TBL_Gains_t, Kr[0]) },
+   { "kr.y",   offsetof(CTRL42_TBL_Gains_t, Kr[1]) },
+   { "kr.z",   offsetof(CTRL42_TBL_Gains_t, Kr[2]) },
+   { "kunl.k", offsetof(CTRL42_TBL_Gains_t, Kunl)  }
 };
 
 
@@ -81,84 +150,135 @@ static CJSON_Obj_t JsonTblObjs[] =
 **    1. This must be called prior to any other functions
 **
 */
-void CTRL42_TBL_Constructor(CTRL42_TBL_Class_t *Ctrl42TblPtr, 
+void CTRL42_TBL_Constructor(CTRL42_TBL_Class_t *Ctrl42Tbl,
                             CTRL42_TBL_LoadFunc_t LoadFunc)
 {
 
-   Ctrl42Tbl = Ctrl42TblPtr;
-
    CFE_PSP_MemSet(Ctrl42Tbl, 0, sizeof(CTRL42_TBL_Class_t));
  
-   Ctrl42Tbl->LoadFunc = LoadFunc;
-   Ctrl42Tbl->JsonObjCnt = (sizeof(JsonTblObjs)/sizeof(CJSON_Obj_t));
-         
+   Ctrl42Tbl->LoadFunc    = LoadFunc;
+   Ctrl42Tbl->JsonObjCnt  = (sizeof(JsonTblObjs)/sizeof(CJSON_Obj_t));
+
+   Ctrl42Tbl->ActiveBuf  = 0;
+   Ctrl42Tbl->PendingBuf = 1;
+   Ctrl42Tbl->FreeBuf    = 2;
+   Ctrl42Tbl->NewestBuf  = Ctrl42Tbl->ActiveBuf;
+
+   Ctrl42TblObj = Ctrl42Tbl;
+
 } /* End CTRL42_TBL_Constructor() */
 
 
 /******************************************************************************
-** Function: CTRL42_TBL_DumpCmd
+** Function: CTRL42_TBL_Commit
 **
-** Notes:
-**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
-**  2. File is formatted so it can be used as a load file.
 */
-bool CTRL42_TBL_DumpCmd(osal_id_t FileHandle)
+bool CTRL42_TBL_Commit(CTRL42_TBL_Class_t *Ctrl42Tbl)
 {
 
-   char DumpRecord[256];
+   bool   Committed = false;
+   uint32 PendingBuf;
 
-   sprintf(DumpRecord,"   \"kp\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   },\n",
-           Ctrl42Tbl->Data.Kp[0], Ctrl42Tbl->Data.Kp[1], Ctrl42Tbl->Data.Kp[2]);
-   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   if (__atomic_load_n(&Ctrl42Tbl->PendingBuf, __ATOMIC_RELAXED) & CTRL42_TBL_BUF_PENDING)
+   {
+      PendingBuf = __atomic_exchange_n(&Ctrl42Tbl->PendingBuf, Ctrl42Tbl->ActiveBuf, __ATOMIC_ACQ_REL);
+      Ctrl42Tbl->ActiveBuf = PendingBuf & ~CTRL42_TBL_BUF_PENDING;
+      Committed = true;
+   }
 
-   sprintf(DumpRecord,"   \"kr\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   },\n",
-           Ctrl42Tbl->Data.Kr[0], Ctrl42Tbl->Data.Kr[1], Ctrl42Tbl->Data.Kr[2]);
-   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   return Committed;
 
-   sprintf(DumpRecord,"   \"kunl\": {\n      \"k\": %4.8e   },\n",
-           Ctrl42Tbl->Data.Kunl);
-   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+} /* End CTRL42_TBL_Commit() */
 
-   sprintf(DumpRecord,"   \"hcmd-lim\": {\n      \"lower\": %4.8e,\n      \"upper\": %4.8e\n   },\n",
-           Ctrl42Tbl->Data.HcmdLim.Lower, Ctrl42Tbl->Data.HcmdLim.Upper);
-   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
 
-   sprintf(DumpRecord,"   \"sci-theta-lim\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   }\n",
-           Ctrl42Tbl->Data.SciThetaLim[0], Ctrl42Tbl->Data.SciThetaLim[1], Ctrl42Tbl->Data.SciThetaLim[2]);
-   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+/******************************************************************************
+** Function: CTRL42_TBL_GetData
+**
+*/
+const CTRL42_TBL_Data_t *CTRL42_TBL_GetData(const CTRL42_TBL_Class_t *Ctrl42Tbl)
+{
 
-   return true;
-   
-} /* End of CTRL42_TBL_DumpCmd() */
+   return &Ctrl42Tbl->Buf[Ctrl42Tbl->ActiveBuf];
+
+} /* End CTRL42_TBL_GetData() */
 
 
 /******************************************************************************
-** Function: CTRL42_TBL_LoadCmd
+** Function: CTRL42_TBL_GetNewestData
 **
-** Notes:
-**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
 */
-bool CTRL42_TBL_LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename)
+const CTRL42_TBL_Data_t *CTRL42_TBL_GetNewestData(const CTRL42_TBL_Class_t *Ctrl42Tbl)
 {
 
-   bool  RetStatus = false;
+   return &Ctrl42Tbl->Buf[Ctrl42Tbl->NewestBuf];
+
+} /* End CTRL42_TBL_GetNewestData() */
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_InitImg
+**
+*/
+void CTRL42_TBL_InitImg(CTRL42_TBL_Img_t *Img, const CTRL42_TBL_Data_t *Data)
+{
+
+   memset(Img, 0, sizeof(CTRL42_TBL_Img_t));
+
+   memcpy(Img->Hdr.ImgId, CTRL42_TBL_IMG_ID, sizeof(Img->Hdr.ImgId));
+   Img->Hdr.Version    = CTRL42_TBL_IMG_VERSION;
+   Img->Hdr.ByteOrder  = 0x01020304;
+   Img->Hdr.SchemaHash = SchemaHash();
+   Img->Hdr.DataLen    = sizeof(CTRL42_TBL_Data_t);
+
+   memcpy(&Img->Data, Data, sizeof(CTRL42_TBL_Data_t));
+   Img->Hdr.DataCrc = Crc32(0, &Img->Data, sizeof(CTRL42_TBL_Data_t));
+
+} /* End CTRL42_TBL_InitImg() */
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_LoadData
+**
+*/
+bool CTRL42_TBL_LoadData(CTRL42_TBL_Class_t *Ctrl42Tbl, const CTRL42_TBL_Data_t *TblData)
+{
 
-   if (CJSON_ProcessFile(Filename, Ctrl42Tbl->JsonBuf, CTRL42_TBL_JSON_FILE_MAX_CHAR, LoadJsonData))
+   bool RetStatus = true;
+
+   if (Ctrl42Tbl->LoadFunc != NULL)
    {
+      RetStatus = (Ctrl42Tbl->LoadFunc)(TblData);
+   }
+
+   if (RetStatus)
+   {
+      StageData(Ctrl42Tbl, TblData);
       Ctrl42Tbl->Loaded = true;
-      RetStatus = true;   
    }
 
    return RetStatus;
-   
-} /* End CTRL42_TBL_LoadCmd() */
+
+} /* End CTRL42_TBL_LoadData() */
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_Register
+**
+*/
+void CTRL42_TBL_Register(CTRL42_TBL_Class_t *Ctrl42Tbl, TBLMGR_Class_t *TblMgr,
+                         const char *TblFilename)
+{
+
+   Ctrl42Tbl->TblId = TBLMGR_RegisterTblWithDef(TblMgr, CTRL42_TBL_NAME, LoadCmd, DumpCmd, TblFilename);
+
+} /* End CTRL42_TBL_Register() */
 
 
 /******************************************************************************
 ** Function: CTRL42_TBL_ResetStatus
 **
 */
-void CTRL42_TBL_ResetStatus(void)
+void CTRL42_TBL_ResetStatus(CTRL42_TBL_Class_t *Ctrl42Tbl)
 {
 
    Ctrl42Tbl->LastLoadCnt = 0;
@@ -167,37 +287,26 @@ void CTRL42_TBL_ResetStatus(void)
 
 
 /******************************************************************************
-** Function: LoadJsonData
+** Function: AcceptTblData
+**
+** Validate and stage the load buffer. ObjLoadCnt is the number of table
+** objects in the file.
 **
 ** Notes:
 **  1. See file prologue for full/partial table load scenarios
 */
-static bool LoadJsonData(size_t JsonFileLen)
+static bool AcceptTblData(CTRL42_TBL_Class_t *Ctrl42Tbl, size_t ObjLoadCnt)
 {
 
-   bool      RetStatus = false;
-   size_t    ObjLoadCnt;
-
-
-   Ctrl42Tbl->JsonFileLen = JsonFileLen;
-
-   /* 
-   ** 1. Copy table owner data into local table buffer
-   ** 2. Process JSON file which updates local table buffer with JSON supplied values
-   ** 3. If valid, copy local buffer over owner's data 
-   */
-   
-   memcpy(&TblData, &Ctrl42Tbl->Data, sizeof(CTRL42_TBL_Data_t));
-   
-   ObjLoadCnt = CJSON_LoadObjArray(JsonTblObjs, Ctrl42Tbl->JsonObjCnt, Ctrl42Tbl->JsonBuf, Ctrl42Tbl->JsonFileLen);
+   bool  RetStatus = false;
 
    /* Partial table only accepted after a full table load has been performed */
    if (!Ctrl42Tbl->Loaded && (ObjLoadCnt != Ctrl42Tbl->JsonObjCnt))
    {
 
       CFE_EVS_SendEvent(CTRL42_TBL_LOAD_EID, CFE_EVS_EventType_ERROR, 
-                        "Table has never been loaded and new table only contains %d of %d data objects",
-                        (unsigned int)ObjLoadCnt, (unsigned int)Ctrl42Tbl->JsonObjCnt);
+                        "%s: Table has never been loaded and new table only contains %d of %d data objects",
+                        CTRL42_TBL_NAME, (unsigned int)ObjLoadCnt, (unsigned int)Ctrl42Tbl->JsonObjCnt);
    
    }
    else
@@ -211,15 +320,435 @@ static bool LoadJsonData(size_t JsonFileLen)
       
       if (RetStatus)
       {
-         memcpy(&Ctrl42Tbl->Data,&TblData, sizeof(CTRL42_TBL_Data_t));
+         StageData(Ctrl42Tbl, &TblData);
          Ctrl42Tbl->LastLoadCnt = ObjLoadCnt;
          CFE_EVS_SendEvent(CTRL42_TBL_LOAD_EID, CFE_EVS_EventType_INFORMATION, 
-                           "Successfully loaded %d JSON objects", 
-                           (unsigned int)ObjLoadCnt);
+                           "%s: Successfully loaded %d data objects", 
+                           CTRL42_TBL_NAME, (unsigned int)ObjLoadCnt);
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End AcceptTblData() */
+
+
+/******************************************************************************
+** Function: CheckSchedLoad
+**
+** Finish the gain schedule after a JSON file has been parsed. Returns false
+** if a breakpoint in the file is missing a value.
+**
+*/
+static bool CheckSchedLoad(CTRL42_TBL_Class_t *Ctrl42Tbl, APP_C_FW_TblLoadOptions_Enum_t LoadType)
+{
+
+   bool   RetStatus = true;
+   uint32 Pt;
+
+   if (SchedLoad.InFile)
+   {
+      for (Pt=0; RetStatus && Pt < TblData.GainSched.PtCnt; Pt++)
+      {
+         if (SchedLoad.Field[Pt] != SCHED_FIELD_ALL)
+         {
+            CFE_EVS_SendEvent(CTRL42_TBL_SCHED_EID, CFE_EVS_EventType_ERROR,
+                              "%s: Gain schedule breakpoint %u doesn't define all %u values",
+                              CTRL42_TBL_NAME, (unsigned int)Pt, (unsigned int)SCHED_FIELD_CNT);
+            RetStatus = false;
+         }
+      }
+   }
+   else if (LoadType == APP_C_FW_TblLoadOptions_REPLACE)
+   {
+      TblData.GainSched.PtCnt = 0;
+   }
+
+   return RetStatus;
+
+} /* End CheckSchedLoad() */
+
+/******************************************************************************
+** Function: Crc32
+**
+** Continue a CRC-32 (IEEE 802.3) over DataLen bytes. Start with Crc = 0.
+**
+*/
+static uint32 Crc32(uint32 Crc, const void *Data, size_t DataLen)
+{
+
+   const uint8 *Byte = (const uint8 *)Data;
+   size_t i;
+   int    b;
+
+   Crc = ~Crc;
+   for (i=0; i < DataLen; i++)
+   {
+      Crc ^= Byte[i];
+      for (b=0; b < 8; b++)
+      {
+         Crc = (Crc >> 1) ^ (0xEDB88320 & (0 - (Crc & 1)));
+      }
+   }
+
+   return ~Crc;
+
+} /* End Crc32() */
+
+
+/******************************************************************************
+** Function: DumpCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+*/
+static bool DumpCmd(osal_id_t FileHandle)
+{
+
+   return DumpTblFile(Ctrl42TblObj, FileHandle);
+
+} /* End DumpCmd() */
+
+
+/******************************************************************************
+** Function: DumpTblFile
+**
+** Notes:
+**  1. File is formatted so it can be used as a load file.
+**  2. Dumps the most recently accepted data even if it hasn't been
+**     committed yet.
+*/
+static bool DumpTblFile(CTRL42_TBL_Class_t *Ctrl42Tbl, osal_id_t FileHandle)
+{
+
+   const CTRL42_TBL_Data_t  *Data = CTRL42_TBL_GetNewestData(Ctrl42Tbl);
+   const CTRL42_TBL_Gains_t *Gains;
+   char   DumpRecord[256];
+   uint32 Pt;
+
+   sprintf(DumpRecord,"   \"kp\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   },\n",
+           Data->Kp[0], Data->Kp[1], Data->Kp[2]);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"kr\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   },\n",
+           Data->Kr[0], Data->Kr[1], Data->Kr[2]);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"kunl\": {\n      \"k\": %4.8e   },\n",
+           Data->Kunl);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"hcmd-lim\": {\n      \"lower\": %4.8e,\n      \"upper\": %4.8e\n   },\n",
+           Data->HcmdLim.Lower, Data->HcmdLim.Upper);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"sci-theta-lim\": {\n      \"x\": %4.8e,\n      \"y\": %4.8e,\n      \"z\": %4.8e\n   },\n",
+           Data->SciThetaLim[0], Data->SciThetaLim[1], Data->SciThetaLim[2]);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"pid\": {\n      \"ki\": {\"x\": %4.8e, \"y\": %4.8e, \"z\": %4.8e},\n"
+           "      \"int-lim\": %4.8e,\n      \"tcmd-lim\": %4.8e\n   },\n",
+           Data->Law.Ki[0], Data->Law.Ki[1], Data->Law.Ki[2], Data->Law.IntLim, Data->Law.TcmdLim);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   sprintf(DumpRecord,"   \"steer\": {\n      \"whl-tcmd-lim\": %4.8e,\n      \"sr-lambda\": %4.8e\n   }%s\n",
+           Data->Law.WhlTcmdLim, Data->Law.SrLambda, (Data->GainSched.PtCnt > 0) ? "," : "");
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   if (Data->GainSched.PtCnt > 0)
+   {
+      sprintf(DumpRecord,"   \"%s\": [\n", SCHED_KEY);
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      for (Pt=0; Pt < Data->GainSched.PtCnt; Pt++)
+      {
+         Gains = &Data->GainSched.Gains[Pt];
+
+         sprintf(DumpRecord,"      {\n         \"%s\": %4.8e,\n"
+                 "         \"kp\": {\"x\": %4.8e, \"y\": %4.8e, \"z\": %4.8e},\n",
+                 SCHED_MAG_KEY, Data->GainSched.HvbMag[Pt], Gains->Kp[0], Gains->Kp[1], Gains->Kp[2]);
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+         sprintf(DumpRecord,"         \"kr\": {\"x\": %4.8e, \"y\": %4.8e, \"z\": %4.8e},\n"
+                 "         \"kunl\": {\"k\": %4.8e}\n      }%s\n",
+                 Gains->Kr[0], Gains->Kr[1], Gains->Kr[2], Gains->Kunl,
+                 (Pt < Data->GainSched.PtCnt-1) ? "," : "");
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
       }
+
+      sprintf(DumpRecord,"   ]\n");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
    }
+
+   return true;
    
+} /* End of DumpTblFile() */
+
+
+/******************************************************************************
+** Function: LoadCmd
+**
+** Notes:
+**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
+*/
+static bool LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename)
+{
+
+   return LoadTblFile(Ctrl42TblObj, LoadType, Filename);
+
+} /* End LoadCmd() */
+
+
+/******************************************************************************
+** Function: LoadImg
+**
+** Check the binary table image in ImgBuf and load its data.
+**
+** Notes:
+**   1. An image always contains the entire table.
+*/
+static bool LoadImg(CTRL42_TBL_Class_t *Ctrl42Tbl, const char *Filename, int32 ImgLen)
+{
+
+   bool   RetStatus = false;
+   const  CTRL42_TBL_ImgHdr_t *Hdr = &ImgBuf.Img.Hdr;
+   const  char *Error = NULL;
+
+   if (ImgLen != (int32)sizeof(CTRL42_TBL_Img_t))
+   {
+      Error = "file length doesn't match the image length";
+   }
+   else if (Hdr->ByteOrder != 0x01020304)
+   {
+      Error = "image byte order doesn't match this processor";
+   }
+   else if (Hdr->Version != CTRL42_TBL_IMG_VERSION)
+   {
+      Error = "unsupported image version";
+   }
+   else if (Hdr->DataLen != sizeof(CTRL42_TBL_Data_t) || Hdr->SchemaHash != SchemaHash())
+   {
+      Error = "image was created for a different table schema";
+   }
+   else if (Hdr->DataCrc != Crc32(0, &ImgBuf.Img.Data, sizeof(CTRL42_TBL_Data_t)))
+   {
+      Error = "data CRC check failed";
+   }
+
+   if (Error == NULL)
+   {
+      memcpy(&TblData, &ImgBuf.Img.Data, sizeof(CTRL42_TBL_Data_t));
+      RetStatus = AcceptTblData(Ctrl42Tbl, Ctrl42Tbl->JsonObjCnt);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CTRL42_TBL_IMG_EID, CFE_EVS_EventType_ERROR,
+                        "%s: Binary table image %s rejected, %s",
+                        CTRL42_TBL_NAME, Filename, Error);
+   }
+
+   return RetStatus;
+
+} /* End LoadImg() */
+
+
+/******************************************************************************
+** Function: LoadTblFile
+**
+*/
+static bool LoadTblFile(CTRL42_TBL_Class_t *Ctrl42Tbl, APP_C_FW_TblLoadOptions_Enum_t LoadType,
+                        const char *Filename)
+{
+
+   bool      RetStatus = false;
+   int32     ReadLen = 0;
+   osal_id_t FileHandle;
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+      ReadLen = OS_read(FileHandle, &ImgBuf, sizeof(ImgBuf));
+      OS_close(FileHandle);
+   }
+
+   if (ReadLen >= (int32)sizeof(ImgBuf.Img.Hdr.ImgId) &&
+       memcmp(ImgBuf.Img.Hdr.ImgId, CTRL42_TBL_IMG_ID, sizeof(ImgBuf.Img.Hdr.ImgId)) == 0)
+   {
+      RetStatus = LoadImg(Ctrl42Tbl, Filename, ReadLen);
+   }
+   else
+   {
+      memcpy(&TblData, CTRL42_TBL_GetNewestData(Ctrl42Tbl), sizeof(CTRL42_TBL_Data_t));
+      SchedLoad.InFile = false;
+
+      if (JSON_STREAM_ProcessFile(&JsonStream, Filename, JsonTblObjs, Ctrl42Tbl->JsonObjCnt,
+                                  SchedValue, NULL))
+      {
+         if (CheckSchedLoad(Ctrl42Tbl, LoadType))
+         {
+            RetStatus = AcceptTblData(Ctrl42Tbl, JsonStream.ObjLoadCnt);
+         }
+      }
+   }
+
+   Ctrl42Tbl->Loaded |= RetStatus;
+
    return RetStatus;
    
-} /* End LoadJsonData() */
+} /* End LoadTblFile() */
+
+
+
+
+/******************************************************************************
+** Function: SchemaHash
+**
+** CRC-32 of the JSON object descriptors and the table data size. See the
+** binary table image definition in ctrl42_tbl.h.
+**
+*/
+static uint32 SchemaHash(void)
+{
+
+   uint32 Crc = 0;
+   uint32 Field[4];
+   size_t i;
+
+   for (i=0; i < (sizeof(JsonTblObjs)/sizeof(CJSON_Obj_t)); i++)
+   {
+      Field[0] = (uint32)((uint8 *)JsonTblObjs[i].TblData - (uint8 *)&TblData);
+      Field[1] = (uint32)JsonTblObjs[i].TblDataLen;
+      Field[2] = (uint32)JsonTblObjs[i].Type;
+      Field[3] = (uint32)JsonTblObjs[i].Float;
+      Crc = Crc32(Crc, JsonTblObjs[i].Query.Key, JsonTblObjs[i].Query.KeyLen);
+      Crc = Crc32(Crc, Field, sizeof(Field));
+   }
+
+   for (i=0; i < (sizeof(SchedGainKeys)/sizeof(SchedGainKeys[0])); i++)
+   {
+      Field[0] = (uint32)SchedGainKeys[i].Offset;
+      Crc = Crc32(Crc, SchedGainKeys[i].Key, strlen(SchedGainKeys[i].Key));
+      Crc = Crc32(Crc, Field, sizeof(Field[0]));
+   }
+
+   Field[0] = sizeof(CTRL42_TBL_Data_t);
+
+   return Crc32(Crc, Field, sizeof(Field[0]));
+
+} /* End SchemaHash() */
+
+
+/******************************************************************************
+** Function: SchedValue
+**
+** JSON_STREAM value callback that loads gain schedule breakpoints. Values
+** outside the gain schedule, e.g. the description strings, are ignored.
+**
+** Notes:
+**   1. The first gain schedule value in a file starts a new schedule.
+**
+*/
+static bool SchedValue(void *UserObj, const JSON_STREAM_Value_t *Value)
+{
+
+   CTRL42_TBL_Sched_t *Sched = &TblData.GainSched;
+   bool   RetStatus = true;
+   const  char *Field;
+   const  char *Error = NULL;
+   uint32 Bit = 0;
+   size_t GainKey = 0, i;
+
+   if (strncmp(Value->Path, SCHED_KEY, sizeof(SCHED_KEY)-1) == 0 &&
+       (Value->Path[sizeof(SCHED_KEY)-1] == '.' || Value->Path[sizeof(SCHED_KEY)-1] == '\0'))
+   {
+
+      if (!SchedLoad.InFile)
+      {
+         SchedLoad.InFile = true;
+         memset(SchedLoad.Field, 0, sizeof(SchedLoad.Field));
+         Sched->PtCnt = 0;
+      }
+
+      Field = (Value->Path[sizeof(SCHED_KEY)-1] == '.') ? &Value->Path[sizeof(SCHED_KEY)] : "";
+      if (strcmp(Field, SCHED_MAG_KEY) == 0)
+      {
+         Bit = 1;
+      }
+      for (i=0; Bit == 0 && i < (sizeof(SchedGainKeys)/sizeof(SchedGainKeys[0])); i++)
+      {
+         if (strcmp(Field, SchedGainKeys[i].Key) == 0)
+         {
+            Bit = 2 << i;
+            GainKey = i;
+         }
+      }
+
+      if (Bit == 0)
+      {
+         Error = "unknown breakpoint key";
+      }
+      else if (Value->Index == JSON_STREAM_NO_INDEX)
+      {
+         Error = "breakpoints must be array elements";
+      }
+      else if (Value->Index >= CTRL42_TBL_SCHED_PT_MAX)
+      {
+         Error = "more breakpoints than CTRL42_TBL_SCHED_PT_MAX";
+      }
+      else if (Value->Type != JSON_STREAM_NUMBER)
+      {
+         Error = "value isn't a number";
+      }
+
+      if (Error == NULL)
+      {
+         if (Bit == 1)
+         {
+            Sched->HvbMag[Value->Index] = (float)Value->Number;
+         }
+         else
+         {
+            *(float *)((uint8 *)&Sched->Gains[Value->Index] + SchedGainKeys[GainKey].Offset) = (float)Value->Number;
+         }
+         SchedLoad.Field[Value->Index] |= Bit;
+         if (Value->Index >= Sched->PtCnt)
+         {
+            Sched->PtCnt = Value->Index + 1;
+         }
+      }
+      else
+      {
+         CFE_EVS_SendEvent(CTRL42_TBL_SCHED_EID, CFE_EVS_EventType_ERROR,
+                           "%s: Gain schedule value '%s' rejected, %s",
+                           CTRL42_TBL_NAME, Value->Path, Error);
+         RetStatus = false;
+      }
+
+   } /* End if gain schedule value */
+
+   return RetStatus;
+
+} /* End SchedValue() */
+
+
+/******************************************************************************
+** Function: StageData
+**
+** Make accepted data the pending and newest data.
+**
+** Notes:
+**   1. A pending load that hasn't been committed is replaced and its copy
+**      becomes the free copy, see file prologue.
+**
+*/
+static void StageData(CTRL42_TBL_Class_t *Ctrl42Tbl, const CTRL42_TBL_Data_t *Data)
+{
+
+   uint32 StagedBuf = Ctrl42Tbl->FreeBuf;
+
+   memcpy(&Ctrl42Tbl->Buf[StagedBuf], Data, sizeof(CTRL42_TBL_Data_t));
+   Ctrl42Tbl->NewestBuf = StagedBuf;
+
+   Ctrl42Tbl->FreeBuf = __atomic_exchange_n(&Ctrl42Tbl->PendingBuf, StagedBuf | CTRL42_TBL_BUF_PENDING,
+                                            __ATOMIC_ACQ_REL) & ~CTRL42_TBL_BUF_PENDING;
 
+} /* End StageData() */
@@ -16,9 +16,36 @@
 **    Manage the Controller parameter table
 **
 **  Notes:
-**    1. Use the Singleton design pattern. A pointer to the table object
-**       is passed to the constructor and saved for all other operations.
-**       This is a table-specific file so it doesn't need to be re-entrant.
+**    1. The table manager load and dump callbacks don't identify a table
+**       so the constructor saves the table object for them. The app routes
+**       table commands to a low priority child task so JSON parsing and dump
+**       file writes never delay a control cycle.
+**    2. Each table object holds CTRL42_TBL_BUF_CNT preallocated copies of
+**       the table data that are owned by index. The control task owns the
+**       active copy and only reads it. The loading task owns a free copy
+**       that it fills with accepted data and then swaps for the pending
+**       copy with one atomic exchange, getting back either the replaced
+**       uncommitted load or the copy the controller released. The
+**       controller calls CTRL42_TBL_Commit() at the start of each control
+**       cycle, which swaps a new pending copy for the active copy, so a
+**       commit never copies table data and a cycle never sees a partially
+**       applied table.
+**    3. The loading task uses the most recently accepted copy for partial
+**       loads and dumps. It's the pending or active copy so the loading
+**       task only reads it and it's never handed back as the free copy.
+**    4. A table file is either JSON or a binary table image created from a
+**       JSON file by the host bc42_ctrl_tblimg tool. Loads detect the form
+**       from the file's first bytes. An image is loaded with one read and is
+**       checked against its header, schema hash and CRC before the normal
+**       table validation. Dumps are always JSON.
+**    5. The optional "gain-schedule" array replaces the fixed gains with gains
+**       interpolated over the system momentum magnitude |Hvb|. Each element
+**       is a breakpoint with "hvb-mag" and the same "kp", "kr" and "kunl"
+**       objects as the fixed gains. A file that contains the array replaces
+**       the whole schedule. A replace load without the array clears it and
+**       an update load without the array keeps it.
+**    6. The "pid" and "steer" objects hold the control law parameters. See
+**       ctrl_law.h.
 **
 */
 #ifndef _ctrl42_tbl_
@@ -29,6 +56,8 @@
 */
 
 #include "app_cfg.h"
+#include "ctrl_law.h"
+#include "json_stream.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -40,6 +69,22 @@
 
 #define CTRL42_TBL_DUMP_EID  (CTRL42_TBL_BASE_EID + 0)
 #define CTRL42_TBL_LOAD_EID  (CTRL42_TBL_BASE_EID + 1)
+#define CTRL42_TBL_IMG_EID   (CTRL42_TBL_BASE_EID + 2)
+#define CTRL42_TBL_SCHED_EID (CTRL42_TBL_BASE_EID + 3)
+
+/*
+** Table data copies, see file prologue
+*/
+
+#define CTRL42_TBL_BUF_CNT      3
+#define CTRL42_TBL_BUF_PENDING  0x80000000  /* Set in PendingBuf until the copy is committed */
+
+/*
+** Binary table image
+*/
+
+#define CTRL42_TBL_IMG_ID       "BC42CTBL"
+#define CTRL42_TBL_IMG_VERSION  1
 
 
 /**********************/
@@ -60,6 +105,29 @@ typedef struct
    
 } CTRL42_TBL_Lim_t;
 
+typedef struct
+{
+
+   float  Kp[3];
+   float  Kr[3];
+   float  Kunl;
+
+} CTRL42_TBL_Gains_t;
+
+/*
+** Gain schedule
+** - The breakpoints are kept in their own array so a lookup only searches
+**   contiguous floats and then reads the two bracketing gain sets.
+*/
+typedef struct
+{
+
+   uint32  PtCnt;                                      /* 0 when the fixed gains are used */
+   float   HvbMag[CTRL42_TBL_SCHED_PT_MAX];            /* Nms, strictly increasing */
+   CTRL42_TBL_Gains_t  Gains[CTRL42_TBL_SCHED_PT_MAX];
+
+} CTRL42_TBL_Sched_t;
+
 typedef struct
 {
    float  Kp[3];
@@ -67,11 +135,45 @@ typedef struct
    float  Kunl;
    float  SciThetaLim[3];
    CTRL42_TBL_Lim_t HcmdLim;
+   CTRL_LAW_Cfg_t   Law;
+   CTRL42_TBL_Sched_t GainSched;
    
 } CTRL42_TBL_Data_t;
 
+/******************************************************************************
+** Binary Table Image
+** - Multi-byte values are in the byte order of the host that created the
+**   image. The header ByteOrder field is 0x01020304 in that byte order and
+**   images with a different byte order are rejected.
+** - SchemaHash is a CRC-32 of the table's JSON keys, their data offsets,
+**   sizes and types, and the size of CTRL42_TBL_Data_t. An image created
+**   for a different table layout is rejected.
+*/
+
+typedef struct
+{
+
+   char    ImgId[8];           /* CTRL42_TBL_IMG_ID, not null terminated */
+   uint16  Version;
+   uint16  Spare;
+   uint32  ByteOrder;
+   uint32  SchemaHash;
+   uint32  DataLen;            /* Bytes, sizeof(CTRL42_TBL_Data_t) */
+   uint32  DataCrc;            /* CRC-32 of Data */
+
+} CTRL42_TBL_ImgHdr_t;
+
+typedef struct
+{
+
+   CTRL42_TBL_ImgHdr_t  Hdr;
+   CTRL42_TBL_Data_t    Data;
+
+} CTRL42_TBL_Img_t;
+
 /*
-** Table load callback function
+** Table load validation function. It runs in the loading task so it must
+** only inspect TblData.
 */
 typedef bool (*CTRL42_TBL_LoadFunc_t)(const CTRL42_TBL_Data_t *TblData);
 
@@ -87,19 +189,22 @@ typedef struct
    ** Table Data
    */
    
-   CTRL42_TBL_Data_t     Data;
+   CTRL42_TBL_Data_t     Buf[CTRL42_TBL_BUF_CNT];  /* See file prologue */
+   uint32                ActiveBuf;   /* Control task only */
+   uint32                PendingBuf;  /* Exchanged by both tasks */
+   uint32                FreeBuf;     /* Loading task only */
+   uint32                NewestBuf;   /* Loading task only, most recently accepted data */
    CTRL42_TBL_LoadFunc_t LoadFunc; 
+
+   uint8   TblId;      /* Table manager ID */
    
    /*
-   ** Standard CJSON table data
+   ** JSON table load status
    */
    
    bool         Loaded;   /* Has entire table been loaded? */
    uint16       LastLoadCnt;
-   
    size_t       JsonObjCnt;
-   char         JsonBuf[CTRL42_TBL_JSON_FILE_MAX_CHAR];   
-   size_t       JsonFileLen;
    
 } CTRL42_TBL_Class_t;
 
@@ -112,41 +217,83 @@ typedef struct
 /******************************************************************************
 ** Function: CTRL42_TBL_Constructor
 **
-** Initialize the Histogram table object.
+** Initialize the controller's table object.
 **
 ** Notes:
 **   1. The table values are not populated. This is done when the table is 
 **      registered with the table manager.
 **
 */
-void CTRL42_TBL_Constructor(CTRL42_TBL_Class_t *TblObj, 
+void CTRL42_TBL_Constructor(CTRL42_TBL_Class_t *TblObj,
                             CTRL42_TBL_LoadFunc_t LoadFunc);
 
 
 /******************************************************************************
-** Function: CTRL42_TBL_DumpCmd
+** Function: CTRL42_TBL_Commit
+**
+** Make the most recently accepted load the active table data. Returns true
+** if the active data changed.
+**
+** Notes:
+**   1. Called by the controller at the start of a control cycle. Loads that
+**      were replaced by a newer load before the cycle are discarded.
+**
+*/
+bool CTRL42_TBL_Commit(CTRL42_TBL_Class_t *TblObj);
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_GetData
+**
+** Return the active table data.
+**
+*/
+const CTRL42_TBL_Data_t *CTRL42_TBL_GetData(const CTRL42_TBL_Class_t *TblObj);
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_GetNewestData
 **
-** Command to write the table data from memory to a JSON file.
+** Return the most recently accepted table data, which may not have been
+** committed yet.
 **
 ** Notes:
-**  1. Function signature must match TBLMGR_DumpTblFuncPtr_t.
+**   1. Only for the loading task, see file prologue.
+**
+*/
+const CTRL42_TBL_Data_t *CTRL42_TBL_GetNewestData(const CTRL42_TBL_Class_t *TblObj);
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_InitImg
+**
+** Create a binary table image of Data.
 **
 */
-bool CTRL42_TBL_DumpCmd(osal_id_t FileHandle);
+void CTRL42_TBL_InitImg(CTRL42_TBL_Img_t *Img, const CTRL42_TBL_Data_t *Data);
 
 
 /******************************************************************************
-** Function: CTRL42_TBL_LoadCmd
+** Function: CTRL42_TBL_LoadData
 **
-** Command to copy the table data from a JSON file to memory.
+** Validate table data that didn't come from a file and stage it for the
+** next commit. Returns false if the data is rejected.
 **
 ** Notes:
-**  1. Function signature must match TBLMGR_LoadTblFuncPtr_t.
-**  2. Can assume valid table file name because this is a callback from 
-**     the app framework table manager.
+**   1. Must not be called while the table child task can be loading.
+**
+*/
+bool CTRL42_TBL_LoadData(CTRL42_TBL_Class_t *TblObj, const CTRL42_TBL_Data_t *TblData);
+
+
+/******************************************************************************
+** Function: CTRL42_TBL_Register
+**
+** Register the table with the table manager and load the default table file.
 **
 */
-bool CTRL42_TBL_LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename);
+void CTRL42_TBL_Register(CTRL42_TBL_Class_t *TblObj, TBLMGR_Class_t *TblMgr,
+                         const char *TblFilename);
 
 
 /******************************************************************************
@@ -157,7 +304,7 @@ bool CTRL42_TBL_LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Fil
 ** and flags to a known default state for telemetry.
 **
 */
-void CTRL42_TBL_ResetStatus(void);
+void CTRL42_TBL_ResetStatus(CTRL42_TBL_Class_t *TblObj);
 
 
 #endif /* _ctrl42_tbl_ */
@@ -0,0 +1,420 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the control laws
+**
+**  Notes:
+**    1. The laws only use the control errors so the loops are written for
+**       three axes and BC42_NWHL wheels and are unrolled by the compiler.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <math.h>
+#include <string.h>
+#include "ctrl_law.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   char                Name[CTRL_LAW_NAME_LEN];
+   CTRL_LAW_RunFunc_t  Run;
+
+} CTRL_LAW_Def_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static const CTRL_LAW_Def_t *FindLaw(const char *LawName);
+static void PdTorque(const CTRL_LAW_Param_t *Param, const BC42_Ac_t *Ac42, CTRL_LAW_Real_t Tpd[3]);
+static void RunBc42(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3]);
+static void RunPd(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3]);
+static void RunPid(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3]);
+static void RunSrSteer(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3]);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const double WhlAxis[BC42_NWHL][3] = CTRL_LAW_WHL_AXES;
+
+/*
+** Registered laws. The first entry is the default.
+*/
+static CTRL_LAW_Def_t LawDef[CTRL_LAW_REG_MAX] =
+{
+   { "BC42",     RunBc42    },
+   { "PD",       RunPd      },
+   { "PID",      RunPid     },
+   { "SR_STEER", RunSrSteer }
+};
+static uint32 LawCnt = 4;
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Constructor
+**
+*/
+bool CTRL_LAW_Constructor(CTRL_LAW_Class_t *CtrlLaw, const char *LawName, double Dt)
+{
+
+   const CTRL_LAW_Def_t *Def = FindLaw(LawName);
+   bool RetStatus = true;
+   int  w, i;
+
+   CFE_PSP_MemSet((void*)CtrlLaw, 0, sizeof(CTRL_LAW_Class_t));
+
+   if (Def == NULL)
+   {
+      CFE_EVS_SendEvent(CTRL_LAW_SELECT_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid control law %s, using %s", LawName, LawDef[0].Name);
+      Def = &LawDef[0];
+      RetStatus = false;
+   }
+
+   strncpy(CtrlLaw->Name, Def->Name, CTRL_LAW_NAME_LEN);
+   CtrlLaw->Run = Def->Run;
+   CtrlLaw->Param.Dt = (CTRL_LAW_Real_t)Dt;
+
+   for (w=0; w < BC42_NWHL; w++)
+   {
+      for (i=0; i < 3; i++)
+      {
+         CtrlLaw->Param.WhlAxis[w][i] = (CTRL_LAW_Real_t)WhlAxis[w][i];
+      }
+   }
+
+   return RetStatus;
+
+} /* End CTRL_LAW_Constructor() */
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Register
+**
+*/
+bool CTRL_LAW_Register(const char *LawName, CTRL_LAW_RunFunc_t Run)
+{
+
+   bool RetStatus = false;
+
+   if (FindLaw(LawName) != NULL)
+   {
+      CFE_EVS_SendEvent(CTRL_LAW_REGISTER_EID, CFE_EVS_EventType_ERROR,
+                        "Control law %s is already registered", LawName);
+   }
+   else if (LawCnt >= CTRL_LAW_REG_MAX || strlen(LawName) >= CTRL_LAW_NAME_LEN || Run == NULL)
+   {
+      CFE_EVS_SendEvent(CTRL_LAW_REGISTER_EID, CFE_EVS_EventType_ERROR,
+                        "Control law %s not registered. %u of %d laws registered, names must be shorter than %d",
+                        LawName, (unsigned int)LawCnt, CTRL_LAW_REG_MAX, CTRL_LAW_NAME_LEN);
+   }
+   else
+   {
+      strncpy(LawDef[LawCnt].Name, LawName, CTRL_LAW_NAME_LEN);
+      LawDef[LawCnt].Run = Run;
+      LawCnt++;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End CTRL_LAW_Register() */
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Reset
+**
+*/
+void CTRL_LAW_Reset(CTRL_LAW_Class_t *CtrlLaw)
+{
+
+   CFE_PSP_MemSet((void*)&CtrlLaw->State, 0, sizeof(CTRL_LAW_State_t));
+
+} /* End CTRL_LAW_Reset() */
+
+
+/******************************************************************************
+** Function: CTRL_LAW_SetCfg
+**
+** Notes:
+**   1. The steering matrix is the singularity robust inverse of the wheel
+**      axis matrix A (3 x BC42_NWHL), A^T * (A*A^T + Lambda*I)^-1. A*A^T
+**      is symmetric so its inverse is computed from the adjugate.
+**   2. The steering matrix is zeroed if A*A^T + Lambda*I is singular, i.e.
+**      Lambda is zero and the wheel axes don't span three axes.
+**
+*/
+void CTRL_LAW_SetCfg(CTRL_LAW_Class_t *CtrlLaw, const CTRL_LAW_Cfg_t *Cfg)
+{
+
+   CTRL_LAW_Param_t *Param = &CtrlLaw->Param;
+   double M[3][3], MInv[3][3];
+   double Det;
+   int    i, j, w;
+
+   for (i=0; i < 3; i++)
+   {
+      Param->Ki[i] = Cfg->Ki[i];
+   }
+   Param->IntLim     = Cfg->IntLim;
+   Param->TcmdLim    = Cfg->TcmdLim;
+   Param->WhlTcmdLim = Cfg->WhlTcmdLim;
+
+   for (i=0; i < 3; i++)
+   {
+      for (j=0; j < 3; j++)
+      {
+         M[i][j] = (i == j) ? Cfg->SrLambda : 0.0;
+         for (w=0; w < BC42_NWHL; w++)
+         {
+            M[i][j] += WhlAxis[w][i] * WhlAxis[w][j];
+         }
+      }
+   }
+
+   MInv[0][0] = M[1][1]*M[2][2] - M[1][2]*M[2][1];
+   MInv[0][1] = M[0][2]*M[2][1] - M[0][1]*M[2][2];
+   MInv[0][2] = M[0][1]*M[1][2] - M[0][2]*M[1][1];
+   MInv[1][0] = M[1][2]*M[2][0] - M[1][0]*M[2][2];
+   MInv[1][1] = M[0][0]*M[2][2] - M[0][2]*M[2][0];
+   MInv[1][2] = M[0][2]*M[1][0] - M[0][0]*M[1][2];
+   MInv[2][0] = M[1][0]*M[2][1] - M[1][1]*M[2][0];
+   MInv[2][1] = M[0][1]*M[2][0] - M[0][0]*M[2][1];
+   MInv[2][2] = M[0][0]*M[1][1] - M[0][1]*M[1][0];
+
+   Det = M[0][0]*MInv[0][0] + M[0][1]*MInv[1][0] + M[0][2]*MInv[2][0];
+   Det = (fabs(Det) > 1.0E-12) ? 1.0/Det : 0.0;
+
+   for (w=0; w < BC42_NWHL; w++)
+   {
+      for (j=0; j < 3; j++)
+      {
+         Param->SteerInv[w][j] = (CTRL_LAW_Real_t)(Det * (WhlAxis[w][0]*MInv[0][j] +
+                                                          WhlAxis[w][1]*MInv[1][j] +
+                                                          WhlAxis[w][2]*MInv[2][j]));
+      }
+   }
+
+} /* End CTRL_LAW_SetCfg() */
+
+
+/******************************************************************************
+** Function: CTRL_LAW_SetGains
+**
+*/
+void CTRL_LAW_SetGains(CTRL_LAW_Class_t *CtrlLaw, const BC42_CtrlGains_t *Gains)
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      CtrlLaw->Param.Kp[i] = Gains->Kp[i];
+      CtrlLaw->Param.Kr[i] = Gains->Kr[i];
+   }
+
+} /* End CTRL_LAW_SetGains() */
+
+
+/******************************************************************************
+** Function: FindLaw
+**
+*/
+static const CTRL_LAW_Def_t *FindLaw(const char *LawName)
+{
+
+   const CTRL_LAW_Def_t *Def = NULL;
+   uint32 i;
+
+   for (i=0; i < LawCnt && Def == NULL; i++)
+   {
+      if (strncmp(LawName, LawDef[i].Name, CTRL_LAW_NAME_LEN) == 0)
+      {
+         Def = &LawDef[i];
+      }
+   }
+
+   return Def;
+
+} /* End FindLaw() */
+
+
+/******************************************************************************
+** Function: PdTorque
+**
+*/
+static void PdTorque(const CTRL_LAW_Param_t *Param, const BC42_Ac_t *Ac42, CTRL_LAW_Real_t Tpd[3])
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Tpd[i] = -Param->Kp[i] * (CTRL_LAW_Real_t)Ac42->CmgCtrl.therr[i]
+               -Param->Kr[i] * (CTRL_LAW_Real_t)Ac42->CmgCtrl.werr[i];
+   }
+
+} /* End PdTorque() */
+
+
+/******************************************************************************
+** Function: RunBc42
+**
+*/
+static void RunBc42(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3])
+{
+
+   Tcmd[0] = Ac42->Tcmd[0];
+   Tcmd[1] = Ac42->Tcmd[1];
+   Tcmd[2] = Ac42->Tcmd[2];
+
+} /* End RunBc42() */
+
+
+/******************************************************************************
+** Function: RunPd
+**
+*/
+static void RunPd(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3])
+{
+
+   CTRL_LAW_Real_t Tpd[3];
+   int i;
+
+   PdTorque(&CtrlLaw->Param, Ac42, Tpd);
+
+   for (i=0; i < 3; i++)
+   {
+      Tcmd[i] = Tpd[i];
+   }
+
+} /* End RunPd() */
+
+
+/******************************************************************************
+** Function: RunPid
+**
+** Notes:
+**   1. -Ki*Int pushes the torque in the direction opposite therr. When an
+**      axis is limited and its torque has the opposite sign of therr the
+**      axis's integration step is discarded so the integrator doesn't wind
+**      up.
+**
+*/
+static void RunPid(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3])
+{
+
+   const CTRL_LAW_Param_t *Param = &CtrlLaw->Param;
+   CTRL_LAW_State_t *State = &CtrlLaw->State;
+   CTRL_LAW_Real_t Tpd[3];
+   CTRL_LAW_Real_t Therr, Int, T;
+   bool  Limited = false;
+   int   i;
+
+   PdTorque(Param, Ac42, Tpd);
+
+   for (i=0; i < 3; i++)
+   {
+
+      Therr = (CTRL_LAW_Real_t)Ac42->CmgCtrl.therr[i];
+      Int   = State->Int[i] + Therr * Param->Dt;
+      if (Int >  Param->IntLim) Int =  Param->IntLim;
+      if (Int < -Param->IntLim) Int = -Param->IntLim;
+
+      T = Tpd[i] - Param->Ki[i] * Int;
+      if (T > Param->TcmdLim || T < -Param->TcmdLim)
+      {
+         Limited = true;
+         if (T * Therr < 0)
+         {
+            Int = State->Int[i];
+            T   = Tpd[i] - Param->Ki[i] * Int;
+         }
+         if (T >  Param->TcmdLim) T =  Param->TcmdLim;
+         if (T < -Param->TcmdLim) T = -Param->TcmdLim;
+      }
+
+      State->Int[i] = Int;
+      Tcmd[i] = T;
+
+   } /* End axis loop */
+
+   if (Limited)
+   {
+      State->LimitCnt++;
+   }
+
+} /* End RunPid() */
+
+
+/******************************************************************************
+** Function: RunSrSteer
+**
+** Notes:
+**   1. All wheel torques are scaled by the same factor when one exceeds
+**      the limit so the body torque keeps the direction of the PD torque.
+**
+*/
+static void RunSrSteer(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3])
+{
+
+   const CTRL_LAW_Param_t *Param = &CtrlLaw->Param;
+   CTRL_LAW_State_t *State = &CtrlLaw->State;
+   CTRL_LAW_Real_t *WhlTcmd = State->WhlTcmd;
+   CTRL_LAW_Real_t Tpd[3];
+   CTRL_LAW_Real_t MaxTcmd = 0;
+   CTRL_LAW_Real_t Scale   = 1;
+   CTRL_LAW_Real_t T;
+   int   w, i;
+
+   PdTorque(Param, Ac42, Tpd);
+
+   for (w=0; w < BC42_NWHL; w++)
+   {
+      WhlTcmd[w] = Param->SteerInv[w][0]*Tpd[0] + Param->SteerInv[w][1]*Tpd[1] +
+                   Param->SteerInv[w][2]*Tpd[2];
+      T = (WhlTcmd[w] < 0) ? -WhlTcmd[w] : WhlTcmd[w];
+      if (T > MaxTcmd) MaxTcmd = T;
+   }
+
+   if (MaxTcmd > Param->WhlTcmdLim)
+   {
+      Scale = Param->WhlTcmdLim / MaxTcmd;
+      State->LimitCnt++;
+   }
+
+   for (i=0; i < 3; i++)
+   {
+      T = 0;
+      for (w=0; w < BC42_NWHL; w++)
+      {
+         T += Param->WhlAxis[w][i] * WhlTcmd[w];
+      }
+      Tcmd[i] = Scale * T;
+   }
+
+} /* End RunSrSteer() */
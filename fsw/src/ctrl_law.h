@@ -0,0 +1,212 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide the control laws that turn BC42_LIB's control errors into the
+**    commanded body torque
+**
+**  Notes:
+**    1. A control law is a named run function. The built-in laws are:
+**       - BC42:     Use the torque computed by BC42_RunController()
+**       - PD:       Tcmd = -Kp*therr - Kr*werr
+**       - PID:      PD plus -Ki times the integrated attitude error. The
+**                   torque is limited and the integrator stops while the
+**                   limit is active and integrating would increase the
+**                   torque. The integral is also limited.
+**       - SR_STEER: PD torque distributed to the wheels with a
+**                   singularity robust inverse of the wheel axis matrix,
+**                   scaled so no wheel exceeds its torque limit and mapped
+**                   back to a body torque
+**       More laws can be added with CTRL_LAW_Register() before the control
+**       law objects are constructed. The INI file selects one by name.
+**    2. The laws are compiled for BC42_NWHL wheels and CTRL_LAW_Real_t
+**       precision. Gains, limits and the steering matrix are converted when
+**       they change so a law's loops only use compile-time sizes and the
+**       configured type. Each control cycle makes one call through the
+**       selected law's function pointer.
+**    3. BC42_LIB computes the control errors and the magnetic torquer
+**       commands for every law. A law only replaces the body torque.
+**
+*/
+#ifndef _ctrl_law_
+#define _ctrl_law_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42_lib.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define CTRL_LAW_REGISTER_EID  (CTRL_LAW_BASE_EID + 0)
+#define CTRL_LAW_SELECT_EID    (CTRL_LAW_BASE_EID + 1)
+
+#define CTRL_LAW_NAME_LEN  16
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+#if (CTRL_LAW_DOUBLE == 1)
+   typedef double CTRL_LAW_Real_t;
+#else
+   typedef float  CTRL_LAW_Real_t;
+#endif
+
+/******************************************************************************
+** Control law parameters from the controller table
+*/
+
+typedef struct
+{
+
+   float  Ki[3];
+   float  IntLim;       /* rad*s, integrated attitude error limit */
+   float  TcmdLim;      /* Nm, PID body torque limit per axis */
+   float  WhlTcmdLim;   /* Nm, SR_STEER wheel torque limit */
+   float  SrLambda;     /* SR_STEER singularity robustness factor */
+
+} CTRL_LAW_Cfg_t;
+
+
+/******************************************************************************
+** Parameters in the law's precision and state
+*/
+
+typedef struct
+{
+
+   CTRL_LAW_Real_t  Kp[3];
+   CTRL_LAW_Real_t  Kr[3];
+   CTRL_LAW_Real_t  Ki[3];
+   CTRL_LAW_Real_t  IntLim;
+   CTRL_LAW_Real_t  TcmdLim;
+   CTRL_LAW_Real_t  WhlTcmdLim;
+   CTRL_LAW_Real_t  Dt;                           /* Seconds between control cycles */
+   CTRL_LAW_Real_t  WhlAxis[BC42_NWHL][3];
+   CTRL_LAW_Real_t  SteerInv[BC42_NWHL][3];       /* Body torque to wheel torque */
+
+} CTRL_LAW_Param_t;
+
+typedef struct
+{
+
+   CTRL_LAW_Real_t  Int[3];                       /* PID integrated attitude error */
+   CTRL_LAW_Real_t  WhlTcmd[BC42_NWHL];           /* SR_STEER wheel torques */
+   uint32           LimitCnt;                     /* Cycles the torque was limited */
+
+} CTRL_LAW_State_t;
+
+typedef struct CTRL_LAW_Class CTRL_LAW_Class_t;
+
+/*
+** Compute the body torque command Tcmd from BC42_LIB's outputs
+*/
+typedef void (*CTRL_LAW_RunFunc_t)(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3]);
+
+
+/******************************************************************************
+** CTRL_LAW Class
+*/
+
+struct CTRL_LAW_Class
+{
+
+   CTRL_LAW_RunFunc_t  Run;
+   char                Name[CTRL_LAW_NAME_LEN];
+   
+   CTRL_LAW_Param_t    Param;
+   CTRL_LAW_State_t    State;
+
+};
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Constructor
+**
+** Initialize a control law object to run the law registered as LawName.
+**
+** Notes:
+**   1. An unknown name selects BC42 and returns false.
+**   2. Gains and table parameters are zero until they are set.
+**
+*/
+bool CTRL_LAW_Constructor(CTRL_LAW_Class_t *CtrlLaw, const char *LawName, double Dt);
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Register
+**
+** Register a control law. Returns false if the name is already registered
+** or CTRL_LAW_REG_MAX laws are registered.
+**
+*/
+bool CTRL_LAW_Register(const char *LawName, CTRL_LAW_RunFunc_t Run);
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Reset
+**
+** Clear the law's state, e.g. the PID integrator.
+**
+*/
+void CTRL_LAW_Reset(CTRL_LAW_Class_t *CtrlLaw);
+
+
+/******************************************************************************
+** Function: CTRL_LAW_Run
+**
+** Run the selected law.
+**
+*/
+static inline void CTRL_LAW_Run(CTRL_LAW_Class_t *CtrlLaw, const BC42_Ac_t *Ac42, double Tcmd[3])
+{
+   CtrlLaw->Run(CtrlLaw, Ac42, Tcmd);
+}
+
+
+/******************************************************************************
+** Function: CTRL_LAW_SetCfg
+**
+** Load the table parameters and compute the steering matrix.
+**
+*/
+void CTRL_LAW_SetCfg(CTRL_LAW_Class_t *CtrlLaw, const CTRL_LAW_Cfg_t *Cfg);
+
+
+/******************************************************************************
+** Function: CTRL_LAW_SetGains
+**
+** Load the PD gains used by the PD, PID and SR_STEER laws.
+**
+*/
+void CTRL_LAW_SetGains(CTRL_LAW_Class_t *CtrlLaw, const BC42_CtrlGains_t *Gains);
+
+
+#endif /* _ctrl_law_ */
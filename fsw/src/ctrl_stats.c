@@ -0,0 +1,211 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the decimated controller telemetry statistics
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <float.h>
+#include "ctrl_stats.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddVec3(CTRL_STATS_Vec3_t *Vec3, const double Sample[3]);
+static void LoadTlmVec3(BC42_CTRL_Vec3Stats_t *TlmVec3, const CTRL_STATS_Vec3_t *Vec3, uint16 SampleCnt);
+static void ResetWindow(CTRL_STATS_Class_t *CtrlStats);
+static void SendStatsTlm(CTRL_STATS_Class_t *CtrlStats);
+
+
+/******************************************************************************
+** Function: CTRL_STATS_Constructor
+**
+*/
+void CTRL_STATS_Constructor(CTRL_STATS_Class_t *CtrlStats, uint16 DecimFactor,
+                            CFE_SB_MsgId_t StatsTlmMid)
+{
+
+   CFE_PSP_MemSet((void*)CtrlStats, 0, sizeof(CTRL_STATS_Class_t));
+
+   CtrlStats->DecimFactor = (DecimFactor > 0) ? DecimFactor : 1;
+   ResetWindow(CtrlStats);
+
+   CFE_MSG_Init(CFE_MSG_PTR(CtrlStats->StatsTlm.TelemetryHeader), StatsTlmMid,
+                sizeof(BC42_CTRL_ControllerStatsTlm_t));
+
+} /* End CTRL_STATS_Constructor() */
+
+
+/******************************************************************************
+** Function: CTRL_STATS_AddSample
+**
+*/
+void CTRL_STATS_AddSample(CTRL_STATS_Class_t *CtrlStats, const BC42_Ac_t *Ac42, const double Tcmd[3])
+{
+
+   AddVec3(&CtrlStats->Signal[CTRL_STATS_THERR], Ac42->CmgCtrl.therr);
+   AddVec3(&CtrlStats->Signal[CTRL_STATS_WERR],  Ac42->CmgCtrl.werr);
+   AddVec3(&CtrlStats->Signal[CTRL_STATS_TCMD],  Tcmd);
+   AddVec3(&CtrlStats->Signal[CTRL_STATS_HVB],   Ac42->Hvb);
+
+   CtrlStats->SampleCnt++;
+   if (CtrlStats->SampleCnt >= CtrlStats->DecimFactor)
+   {
+      SendStatsTlm(CtrlStats);
+      ResetWindow(CtrlStats);
+   }
+
+} /* End CTRL_STATS_AddSample() */
+
+
+/******************************************************************************
+** Function: CTRL_STATS_Decimated
+**
+*/
+bool CTRL_STATS_Decimated(const CTRL_STATS_Class_t *CtrlStats)
+{
+
+   return (CtrlStats->DecimFactor > 1);
+
+} /* End CTRL_STATS_Decimated() */
+
+
+/******************************************************************************
+** Function: CTRL_STATS_SetDecimCmd
+**
+*/
+bool CTRL_STATS_SetDecimCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   CTRL_STATS_Class_t *CtrlStats = (CTRL_STATS_Class_t *)ObjDataPtr;
+   const BC42_CTRL_SetCtrlTlmDecim_CmdPayload_t *CmdPayload = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_CTRL_SetCtrlTlmDecim_t);
+   bool  RetStatus = false;
+
+   if (CmdPayload->DecimFactor > 0)
+   {
+
+      CtrlStats->DecimFactor = CmdPayload->DecimFactor;
+      ResetWindow(CtrlStats);
+      RetStatus = true;
+
+      CFE_EVS_SendEvent(CTRL_STATS_SET_DECIM_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Controller telemetry decimation factor set to %d", CtrlStats->DecimFactor);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(CTRL_STATS_SET_DECIM_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Invalid controller telemetry decimation factor %d. Must be greater than 0",
+                        CmdPayload->DecimFactor);
+   }
+
+   return RetStatus;
+
+} /* End CTRL_STATS_SetDecimCmd() */
+
+
+/******************************************************************************
+** Function: AddVec3
+**
+*/
+static void AddVec3(CTRL_STATS_Vec3_t *Vec3, const double Sample[3])
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Vec3->Sum[i] += Sample[i];
+      if (Sample[i] < Vec3->Min[i]) Vec3->Min[i] = Sample[i];
+      if (Sample[i] > Vec3->Max[i]) Vec3->Max[i] = Sample[i];
+   }
+
+} /* End AddVec3() */
+
+
+/******************************************************************************
+** Function: LoadTlmVec3
+**
+** Notes:
+**   1. Only called with a complete window so SampleCnt is non-zero.
+*/
+static void LoadTlmVec3(BC42_CTRL_Vec3Stats_t *TlmVec3, const CTRL_STATS_Vec3_t *Vec3, uint16 SampleCnt)
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      TlmVec3->Mean[i] = Vec3->Sum[i] / SampleCnt;
+      TlmVec3->Min[i]  = Vec3->Min[i];
+      TlmVec3->Max[i]  = Vec3->Max[i];
+   }
+
+} /* End LoadTlmVec3() */
+
+
+/******************************************************************************
+** Function: ResetWindow
+**
+*/
+static void ResetWindow(CTRL_STATS_Class_t *CtrlStats)
+{
+
+   int s, i;
+
+   CtrlStats->SampleCnt = 0;
+
+   for (s=0; s < CTRL_STATS_SIGNAL_CNT; s++)
+   {
+      for (i=0; i < 3; i++)
+      {
+         CtrlStats->Signal[s].Sum[i] = 0.0;
+         CtrlStats->Signal[s].Min[i] = DBL_MAX;
+         CtrlStats->Signal[s].Max[i] = -DBL_MAX;
+      }
+   }
+
+} /* End ResetWindow() */
+
+
+/******************************************************************************
+** Function: SendStatsTlm
+**
+*/
+static void SendStatsTlm(CTRL_STATS_Class_t *CtrlStats)
+{
+
+   BC42_CTRL_ControllerStatsTlm_Payload_t *Payload = &CtrlStats->StatsTlm.Payload;
+
+   Payload->DecimFactor = CtrlStats->DecimFactor;
+   Payload->SampleCnt   = CtrlStats->SampleCnt;
+
+   LoadTlmVec3(&Payload->therr, &CtrlStats->Signal[CTRL_STATS_THERR], CtrlStats->SampleCnt);
+   LoadTlmVec3(&Payload->werr,  &CtrlStats->Signal[CTRL_STATS_WERR],  CtrlStats->SampleCnt);
+   LoadTlmVec3(&Payload->Tcmd,  &CtrlStats->Signal[CTRL_STATS_TCMD],  CtrlStats->SampleCnt);
+   LoadTlmVec3(&Payload->Hvb,   &CtrlStats->Signal[CTRL_STATS_HVB],   CtrlStats->SampleCnt);
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(CtrlStats->StatsTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(CtrlStats->StatsTlm.TelemetryHeader), true);
+
+} /* End SendStatsTlm() */
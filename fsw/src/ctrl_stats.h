@@ -0,0 +1,156 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Decimate controller telemetry into windowed statistics
+**
+**  Notes:
+**    1. With a decimation factor of 1 CTRL42 sends the raw controller
+**       telemetry packet every control cycle. With a factor of N it
+**       calls CTRL_STATS_AddSample() instead and a controller statistics
+**       packet with the mean, min and max of therr, werr, Tcmd and Hvb
+**       is sent every N control cycles.
+**    2. Statistics are accumulated as running sums and extremes so each
+**       sample is a fixed amount of work regardless of the window size.
+**    3. therr and werr are read from Ac42->CmgCtrl, which assumes BC42_LIB's
+**       controller is built with 42's AcCmgCtrlType like the controller
+**       telemetry.
+**
+*/
+#ifndef _ctrl_stats_
+#define _ctrl_stats_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42_lib.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define CTRL_STATS_SET_DECIM_CMD_EID  (CTRL_STATS_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   CTRL_STATS_THERR = 0,
+   CTRL_STATS_WERR  = 1,
+   CTRL_STATS_TCMD  = 2,
+   CTRL_STATS_HVB   = 3,
+   CTRL_STATS_SIGNAL_CNT = 4
+
+} CTRL_STATS_Signal_t;
+
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** CTRL_STATS Class
+*/
+
+typedef struct
+{
+
+   double  Sum[3];
+   double  Min[3];
+   double  Max[3];
+
+} CTRL_STATS_Vec3_t;
+
+typedef struct
+{
+
+   uint16  DecimFactor;
+   uint16  SampleCnt;          /* Samples in the current window */
+
+   CTRL_STATS_Vec3_t  Signal[CTRL_STATS_SIGNAL_CNT];
+
+   BC42_CTRL_ControllerStatsTlm_t  StatsTlm;
+
+} CTRL_STATS_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CTRL_STATS_Constructor
+**
+** Initialize a CTRL_STATS object.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. A decimation factor of zero is treated as 1.
+**
+*/
+void CTRL_STATS_Constructor(CTRL_STATS_Class_t *CtrlStats, uint16 DecimFactor,
+                            CFE_SB_MsgId_t StatsTlmMid);
+
+
+/******************************************************************************
+** Function: CTRL_STATS_AddSample
+**
+** Accumulate one control cycle and send the statistics packet when the
+** window is complete. Tcmd is the control law's body torque command.
+**
+*/
+void CTRL_STATS_AddSample(CTRL_STATS_Class_t *CtrlStats, const BC42_Ac_t *Ac42, const double Tcmd[3]);
+
+
+/******************************************************************************
+** Function: CTRL_STATS_Decimated
+**
+** Return true if controller telemetry is being decimated.
+**
+*/
+bool CTRL_STATS_Decimated(const CTRL_STATS_Class_t *CtrlStats);
+
+
+/******************************************************************************
+** Function: CTRL_STATS_SetDecimCmd
+**
+** Set the controller telemetry decimation factor.
+**
+** Notes:
+**   1. Takes effect on the next control cycle. The partially accumulated
+**      window is discarded.
+*/
+bool CTRL_STATS_SetDecimCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _ctrl_stats_ */
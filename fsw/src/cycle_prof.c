@@ -0,0 +1,212 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the control cycle phase profiler
+**
+**  Notes:
+**    1. Means are derived from the sums when telemetry is sent so the
+**       per-phase bookkeeping is a few integer operations.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "cycle_prof.h"
+#include "mono_time.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddSample(CYCLE_PROF_Stats_t *Stats, uint64 ExeTime);
+static void LoadTlmStats(BC42_CTRL_PhaseTiming_t *TlmStats, const CYCLE_PROF_Stats_t *Stats);
+static void ResetStats(CYCLE_PROF_Stats_t *Stats);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_Constructor
+**
+*/
+void CYCLE_PROF_Constructor(CYCLE_PROF_Class_t *CycleProf, uint32 PerfIdBase,
+                            CFE_SB_MsgId_t TimingTlmMid)
+{
+
+   CFE_PSP_MemSet((void*)CycleProf, 0, sizeof(CYCLE_PROF_Class_t));
+
+   CycleProf->PerfIdBase = PerfIdBase;
+   CYCLE_PROF_ResetStatus(CycleProf);
+
+   CFE_MSG_Init(CFE_MSG_PTR(CycleProf->TimingTlm.TelemetryHeader), TimingTlmMid,
+                sizeof(BC42_CTRL_TimingTlm_t));
+
+} /* End CYCLE_PROF_Constructor() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_EndCycle
+**
+*/
+void CYCLE_PROF_EndCycle(CYCLE_PROF_Class_t *CycleProf)
+{
+
+   AddSample(&CycleProf->Cycle, MONO_TIME_GetNs() - CycleProf->CycleStart);
+
+} /* End CYCLE_PROF_EndCycle() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_EndPhase
+**
+*/
+void CYCLE_PROF_EndPhase(CYCLE_PROF_Class_t *CycleProf, CYCLE_PROF_Phase_t Phase)
+{
+
+   AddSample(&CycleProf->Phase[Phase], MONO_TIME_GetNs() - CycleProf->PhaseStart);
+   CFE_ES_PerfLogExit(CycleProf->PerfIdBase + Phase);
+
+} /* End CYCLE_PROF_EndPhase() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_ResetStatus
+**
+*/
+void CYCLE_PROF_ResetStatus(CYCLE_PROF_Class_t *CycleProf)
+{
+
+   int i;
+
+   ResetStats(&CycleProf->Cycle);
+   for (i=0; i < CYCLE_PROF_PHASE_CNT; i++)
+   {
+      ResetStats(&CycleProf->Phase[i]);
+   }
+
+} /* End CYCLE_PROF_ResetStatus() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_SendTimingTlmCmd
+**
+*/
+bool CYCLE_PROF_SendTimingTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   CYCLE_PROF_Class_t *CycleProf = (CYCLE_PROF_Class_t *)ObjDataPtr;
+   BC42_CTRL_TimingTlm_Payload_t *Payload = &CycleProf->TimingTlm.Payload;
+   int32  CfeStatus;
+
+   LoadTlmStats(&Payload->Cycle,            &CycleProf->Cycle);
+   LoadTlmStats(&Payload->RunController,    &CycleProf->Phase[CYCLE_PROF_RUN_CONTROLLER]);
+   LoadTlmStats(&Payload->SendControllerTlm, &CycleProf->Phase[CYCLE_PROF_SEND_CONTROLLER_TLM]);
+   LoadTlmStats(&Payload->SendActuatorCmd,  &CycleProf->Phase[CYCLE_PROF_SEND_ACTUATOR_CMD]);
+   LoadTlmStats(&Payload->SetTakeSci,       &CycleProf->Phase[CYCLE_PROF_SET_TAKE_SCI]);
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(CycleProf->TimingTlm.TelemetryHeader));
+   CfeStatus = CFE_SB_TransmitMsg(CFE_MSG_PTR(CycleProf->TimingTlm.TelemetryHeader), true);
+
+   return (CfeStatus == CFE_SUCCESS);
+
+} /* End CYCLE_PROF_SendTimingTlmCmd() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_StartCycle
+**
+*/
+void CYCLE_PROF_StartCycle(CYCLE_PROF_Class_t *CycleProf)
+{
+
+   CycleProf->CycleStart = MONO_TIME_GetNs();
+
+} /* End CYCLE_PROF_StartCycle() */
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_StartPhase
+**
+*/
+void CYCLE_PROF_StartPhase(CYCLE_PROF_Class_t *CycleProf, CYCLE_PROF_Phase_t Phase)
+{
+
+   CFE_ES_PerfLogEntry(CycleProf->PerfIdBase + Phase);
+   CycleProf->PhaseStart = MONO_TIME_GetNs();
+
+} /* End CYCLE_PROF_StartPhase() */
+
+
+/******************************************************************************
+** Function: AddSample
+**
+** Notes:
+**   1. Execution times are saturated at 32 bits (~4.3 seconds).
+*/
+static void AddSample(CYCLE_PROF_Stats_t *Stats, uint64 ExeTime)
+{
+
+   if (ExeTime > UINT32_MAX)
+   {
+      ExeTime = UINT32_MAX;
+   }
+
+   Stats->Cnt++;
+   Stats->Sum += ExeTime;
+   if (ExeTime < Stats->Min) Stats->Min = ExeTime;
+   if (ExeTime > Stats->Max) Stats->Max = ExeTime;
+
+} /* End AddSample() */
+
+
+/******************************************************************************
+** Function: LoadTlmStats
+**
+*/
+static void LoadTlmStats(BC42_CTRL_PhaseTiming_t *TlmStats, const CYCLE_PROF_Stats_t *Stats)
+{
+
+   TlmStats->Cnt = Stats->Cnt;
+
+   if (Stats->Cnt > 0)
+   {
+      TlmStats->Min  = Stats->Min;
+      TlmStats->Max  = Stats->Max;
+      TlmStats->Mean = (uint32)(Stats->Sum / Stats->Cnt);
+   }
+   else
+   {
+      TlmStats->Min  = 0;
+      TlmStats->Max  = 0;
+      TlmStats->Mean = 0;
+   }
+
+} /* End LoadTlmStats() */
+
+
+/******************************************************************************
+** Function: ResetStats
+**
+*/
+static void ResetStats(CYCLE_PROF_Stats_t *Stats)
+{
+
+   Stats->Cnt = 0;
+   Stats->Min = UINT32_MAX;
+   Stats->Max = 0;
+   Stats->Sum = 0;
+
+} /* End ResetStats() */
@@ -0,0 +1,169 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Profile the execution time of each control cycle phase
+**
+**  Notes:
+**    1. Each phase is bracketed with its own cFE performance ID so phases
+**       can be viewed in the cFE performance log. The IDs are assigned
+**       consecutively from an INI defined base ID in CYCLE_PROF_Phase_t
+**       order.
+**    2. Running min, max and mean execution times are also kept in the
+**       object using the monotonic clock so they're available without
+**       collecting a performance log.
+**
+*/
+#ifndef _cycle_prof_
+#define _cycle_prof_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** Phase order must match TimingTlm_Payload in bc42_ctrl.xml
+*/
+typedef enum
+{
+
+   CYCLE_PROF_RUN_CONTROLLER      = 0,
+   CYCLE_PROF_SEND_CONTROLLER_TLM = 1,
+   CYCLE_PROF_SEND_ACTUATOR_CMD   = 2,
+   CYCLE_PROF_SET_TAKE_SCI        = 3,
+   CYCLE_PROF_PHASE_CNT           = 4
+
+} CYCLE_PROF_Phase_t;
+
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** CYCLE_PROF Class
+*/
+
+typedef struct
+{
+
+   uint32  Cnt;
+   uint32  Min;     /* Nanoseconds */
+   uint32  Max;     /* Nanoseconds */
+   uint64  Sum;     /* Nanoseconds */
+
+} CYCLE_PROF_Stats_t;
+
+typedef struct
+{
+
+   uint32  PerfIdBase;
+
+   uint64  CycleStart;
+   uint64  PhaseStart;
+
+   CYCLE_PROF_Stats_t  Cycle;
+   CYCLE_PROF_Stats_t  Phase[CYCLE_PROF_PHASE_CNT];
+
+   BC42_CTRL_TimingTlm_t  TimingTlm;
+
+} CYCLE_PROF_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_Constructor
+**
+** Initialize a CYCLE_PROF object.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void CYCLE_PROF_Constructor(CYCLE_PROF_Class_t *CycleProf, uint32 PerfIdBase,
+                            CFE_SB_MsgId_t TimingTlmMid);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_EndCycle
+**
+*/
+void CYCLE_PROF_EndCycle(CYCLE_PROF_Class_t *CycleProf);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_EndPhase
+**
+** Notes:
+**   1. Must be paired with a preceding CYCLE_PROF_StartPhase() for the same
+**      phase. Phases don't nest.
+*/
+void CYCLE_PROF_EndPhase(CYCLE_PROF_Class_t *CycleProf, CYCLE_PROF_Phase_t Phase);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_ResetStatus
+**
+** Clear the execution time statistics.
+**
+*/
+void CYCLE_PROF_ResetStatus(CYCLE_PROF_Class_t *CycleProf);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_SendTimingTlmCmd
+**
+** Send the timing telemetry packet containing the execution time statistics.
+**
+*/
+bool CYCLE_PROF_SendTimingTlmCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_StartCycle
+**
+*/
+void CYCLE_PROF_StartCycle(CYCLE_PROF_Class_t *CycleProf);
+
+
+/******************************************************************************
+** Function: CYCLE_PROF_StartPhase
+**
+*/
+void CYCLE_PROF_StartPhase(CYCLE_PROF_Class_t *CycleProf, CYCLE_PROF_Phase_t Phase);
+
+
+#endif /* _cycle_prof_ */
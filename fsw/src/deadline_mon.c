@@ -0,0 +1,418 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the DEADLINE_MON class
+**
+**  Notes:
+**    1. The watchdog token is shared by the control task and the watchdog
+**       task. Its low two bits are the guarded cycle's state and the rest
+**       is the cycle sequence number:
+**       - IDLE:    No cycle is guarded
+**       - ARMED:   Cycle running and its actuator command hasn't been claimed
+**       - CLAIMED: The control task claimed the actuator command
+**       - MISSED:  The watchdog sent the safe actuator command
+**       Only ARMED can change to CLAIMED or MISSED so exactly one of the
+**       two tasks sends an actuator command for the cycle.
+**    2. ArmedMon and ArmNs are written before the token is armed and aren't
+**       changed while it's armed. The watchdog reads them between two reads
+**       of the token and only uses them if the token didn't change.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "deadline_mon.h"
+#include "mono_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TOKEN_IDLE     0
+#define TOKEN_ARMED    1
+#define TOKEN_CLAIMED  2
+#define TOKEN_MISSED   3
+#define TOKEN_STATE_MASK  0x3
+
+#define TOKEN(Seq,State)  (((Seq) << 2) | (State))
+#define TOKEN_SEQ(Token)  ((Token) >> 2)
+
+#define GET_TOKEN(Watchdog)  __atomic_load_n(&((Watchdog)->Token), __ATOMIC_ACQUIRE)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool ChangeToken(uint32 Expected, uint32 State);
+static void CheckAtRisk(DEADLINE_MON_Class_t *DeadlineMon);
+static bool ChildTaskCallback(CHILDMGR_Class_t *ChildMgr);
+static void SendSafeCmd(DEADLINE_MON_Class_t *DeadlineMon);
+static void SetShedLevel(DEADLINE_MON_Class_t *DeadlineMon, uint8 ShedLevel);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static DEADLINE_MON_Watchdog_t *Watchdog = NULL;
+
+static const char *ShedWorkStr[DEADLINE_MON_SHED_MAX+1] =
+{
+   "no work",
+   "controller telemetry",
+   "TakeSci evaluation",
+   "debug log records"
+};
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_Constructor
+**
+*/
+void DEADLINE_MON_Constructor(DEADLINE_MON_Class_t *DeadlineMon, uint32 DeadlineUs,
+                              uint32 AtRiskUs, CFE_SB_MsgId_t ActuatorCmdMid)
+{
+
+   CFE_PSP_MemSet((void*)DeadlineMon, 0, sizeof(DEADLINE_MON_Class_t));
+
+   DeadlineMon->DeadlineNs = (uint64)DeadlineUs * 1000;
+   DeadlineMon->AtRiskNs   = (uint64)AtRiskUs * 1000;
+
+   /* Payload is zeroed by the MemSet */
+   CFE_MSG_Init(CFE_MSG_PTR(DeadlineMon->SafeCmdMsg.TelemetryHeader), ActuatorCmdMid,
+                sizeof(BC42_INTF_ActuatorCmdMsg_t));
+
+} /* End DEADLINE_MON_Constructor() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_WatchdogConstructor
+**
+*/
+void DEADLINE_MON_WatchdogConstructor(DEADLINE_MON_Watchdog_t *WatchdogObj, const INITBL_Class_t *IniTbl)
+{
+
+   int32 Status;
+   CHILDMGR_TaskInit_t ChildTaskInit;
+
+   Watchdog = WatchdogObj;
+
+   CFE_PSP_MemSet((void*)Watchdog, 0, sizeof(DEADLINE_MON_Watchdog_t));
+
+   ChildTaskInit.TaskName  = INITBL_GetStrConfig(IniTbl, CFG_DEADLINE_MON_CHILD_NAME);
+   ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_DEADLINE_MON_CHILD_STACK_SIZE);
+   ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_DEADLINE_MON_CHILD_PRIORITY);
+   ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_DEADLINE_MON_CHILD_PERF_ID);
+
+   Status = OS_BinSemCreate(&Watchdog->ArmSem, ChildTaskInit.TaskName, 0, 0);
+   if (Status == OS_SUCCESS)
+   {
+      Status = CHILDMGR_Constructor(&Watchdog->ChildMgr, ChildMgr_TaskMainCallback,
+                                    ChildTaskCallback, &ChildTaskInit);
+   }
+
+   Watchdog->ChildTaskValid = (Status == CFE_SUCCESS);
+   if (!Watchdog->ChildTaskValid)
+   {
+      CFE_EVS_SendEvent(DEADLINE_MON_CHILD_TASK_EID, CFE_EVS_EventType_ERROR,
+                        "Deadline watchdog child task %s creation failed, status 0x%08X. Actuator deadlines are not guarded",
+                        ChildTaskInit.TaskName, (unsigned int)Status);
+   }
+
+} /* End DEADLINE_MON_WatchdogConstructor() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_CheckRisk
+**
+*/
+void DEADLINE_MON_CheckRisk(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   if (DeadlineMon->DeadlineNs != 0)
+   {
+   
+      CheckAtRisk(DeadlineMon);
+
+      if (DeadlineMon->ShedLevel != DEADLINE_MON_SHED_NONE)
+      {
+         DeadlineMon->ShedCycleCnt++;
+      }
+   
+   } /* End if enabled */
+   
+} /* End DEADLINE_MON_CheckRisk() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_ClaimActuator
+**
+*/
+bool DEADLINE_MON_ClaimActuator(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   bool Claimed = true;
+   uint32 Token;
+   
+   if (DeadlineMon->Armed)
+   {
+      Token   = GET_TOKEN(Watchdog);
+      Claimed = ChangeToken(TOKEN(TOKEN_SEQ(Token), TOKEN_ARMED), TOKEN_CLAIMED);
+      if (!Claimed)
+      {
+         DeadlineMon->LateCmdCnt++;
+      }
+   }
+
+   return Claimed;
+   
+} /* End DEADLINE_MON_ClaimActuator() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_EndCycle
+**
+*/
+void DEADLINE_MON_EndCycle(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   uint32 Token;
+   
+   if (DeadlineMon->Armed)
+   {
+      /* Leaves CLAIMED and MISSED cycles unchanged */
+      Token = GET_TOKEN(Watchdog);
+      ChangeToken(TOKEN(TOKEN_SEQ(Token), TOKEN_ARMED), TOKEN_IDLE);
+      DeadlineMon->Armed = false;
+   }
+   
+   if (DeadlineMon->DeadlineNs != 0)
+   {
+   
+      CheckAtRisk(DeadlineMon);
+
+      if (DeadlineMon->AtRisk)
+      {
+         DeadlineMon->RecoverCnt = 0;
+      }
+      else if (DeadlineMon->ShedLevel != DEADLINE_MON_SHED_NONE)
+      {
+         if (++DeadlineMon->RecoverCnt >= DEADLINE_MON_RECOVER_CYC)
+         {
+            SetShedLevel(DeadlineMon, DeadlineMon->ShedLevel - 1);
+            DeadlineMon->RecoverCnt = 0;
+         }
+      }
+
+   } /* End if enabled */
+   
+} /* End DEADLINE_MON_EndCycle() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_ResetStatus
+**
+*/
+void DEADLINE_MON_ResetStatus(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   DeadlineMon->MissCnt      = 0;
+   DeadlineMon->LateCmdCnt   = 0;
+   DeadlineMon->ShedCycleCnt = 0;
+
+} /* End DEADLINE_MON_ResetStatus() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_StartCycle
+**
+** Notes:
+**   1. The previous cycle's token was left IDLE, CLAIMED or MISSED by
+**      DEADLINE_MON_EndCycle() so the watchdog isn't reading ArmedMon
+**      and ArmNs while they're written.
+**
+*/
+void DEADLINE_MON_StartCycle(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   uint32 Token;
+   
+   DeadlineMon->StartNs = MONO_TIME_GetNs();
+   DeadlineMon->AtRisk  = false;
+   DeadlineMon->Armed   = (DeadlineMon->DeadlineNs != 0 && Watchdog != NULL && Watchdog->ChildTaskValid);
+   
+   if (DeadlineMon->Armed)
+   {
+      Token = GET_TOKEN(Watchdog);
+      __atomic_store_n(&Watchdog->ArmedMon, DeadlineMon, __ATOMIC_RELAXED);
+      __atomic_store_n(&Watchdog->ArmNs, DeadlineMon->StartNs, __ATOMIC_RELAXED);
+      __atomic_store_n(&Watchdog->Token, TOKEN(TOKEN_SEQ(Token) + 1, TOKEN_ARMED), __ATOMIC_RELEASE);
+      OS_BinSemGive(Watchdog->ArmSem);
+   }
+
+} /* End DEADLINE_MON_StartCycle() */
+
+
+/******************************************************************************
+** Function: ChangeToken
+**
+** Change the token's state if it's still Expected.
+**
+*/
+static bool ChangeToken(uint32 Expected, uint32 State)
+{
+
+   return __atomic_compare_exchange_n(&Watchdog->Token, &Expected,
+                                      TOKEN(TOKEN_SEQ(Expected), State),
+                                      false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+
+} /* End ChangeToken() */
+
+
+/******************************************************************************
+** Function: CheckAtRisk
+**
+** Raise the shed level once per cycle when the time since the start of the
+** cycle exceeds the at-risk limit.
+**
+*/
+static void CheckAtRisk(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   if (!DeadlineMon->AtRisk && (MONO_TIME_GetNs() - DeadlineMon->StartNs) > DeadlineMon->AtRiskNs)
+   {
+      DeadlineMon->AtRisk = true;
+      if (DeadlineMon->ShedLevel < DEADLINE_MON_SHED_MAX)
+      {
+         SetShedLevel(DeadlineMon, DeadlineMon->ShedLevel + 1);
+      }
+   }
+
+} /* End CheckAtRisk() */
+
+
+/******************************************************************************
+** Function: ChildTaskCallback
+**
+** Notes:
+**   1. Called in a loop by the child task manager. Returning false would
+**      terminate the child task.
+**   2. A cycle that ended while the watchdog waited for its deadline has a
+**      different token so the compare and exchange fails.
+**
+*/
+static bool ChildTaskCallback(CHILDMGR_Class_t *ChildMgr)
+{
+
+   uint32 Token;
+   uint64 ArmNs;
+   uint64 Now;
+   DEADLINE_MON_Class_t *DeadlineMon;
+
+   OS_BinSemTake(Watchdog->ArmSem);
+
+   do
+   {
+      Token       = GET_TOKEN(Watchdog);
+      DeadlineMon = __atomic_load_n(&Watchdog->ArmedMon, __ATOMIC_RELAXED);
+      ArmNs       = __atomic_load_n(&Watchdog->ArmNs, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   } while (GET_TOKEN(Watchdog) != Token);
+
+   if ((Token & TOKEN_STATE_MASK) == TOKEN_ARMED)
+   {
+
+      Now = MONO_TIME_GetNs();
+      if (ArmNs + DeadlineMon->DeadlineNs > Now)
+      {
+         /* Round up so the watchdog never fires early */
+         OS_TaskDelay((uint32)((ArmNs + DeadlineMon->DeadlineNs - Now + 999999) / 1000000));
+      }
+
+      if (ChangeToken(Token, TOKEN_MISSED))
+      {
+         SendSafeCmd(DeadlineMon);
+      }
+      else
+      {
+         Watchdog->Missing = false;
+      }
+
+   } /* End if armed */
+
+   return true;
+
+} /* End ChildTaskCallback() */
+
+
+/******************************************************************************
+** Function: SendSafeCmd
+**
+** Notes:
+**   1. Runs in the watchdog task. The message is copied by the software bus
+**      so the control task's zero copy buffers aren't used.
+**   2. An event is sent for the first miss after a guarded cycle that met
+**      its deadline so a burst of misses produces one event.
+**
+*/
+static void SendSafeCmd(DEADLINE_MON_Class_t *DeadlineMon)
+{
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(DeadlineMon->SafeCmdMsg.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(DeadlineMon->SafeCmdMsg.TelemetryHeader), true);
+   DeadlineMon->MissCnt++;
+
+   if (!Watchdog->Missing)
+   {
+      CFE_EVS_SendEvent(DEADLINE_MON_MISS_EID, CFE_EVS_EventType_ERROR,
+                        "Controller missed its %u us actuator command deadline, sent the safe actuator command",
+                        (unsigned int)(DeadlineMon->DeadlineNs / 1000));
+      Watchdog->Missing = true;
+   }
+
+} /* End SendSafeCmd() */
+
+
+/******************************************************************************
+** Function: SetShedLevel
+**
+** Notes:
+**   1. An event is sent each time the level changes. The recovery hysteresis
+**      limits the rate.
+**
+*/
+static void SetShedLevel(DEADLINE_MON_Class_t *DeadlineMon, uint8 ShedLevel)
+{
+
+   if (ShedLevel > DeadlineMon->ShedLevel)
+   {
+      CFE_EVS_SendEvent(DEADLINE_MON_SHED_EID, CFE_EVS_EventType_INFORMATION,
+                        "Controller cycle exceeded its %u us at-risk limit, shedding %s",
+                        (unsigned int)(DeadlineMon->AtRiskNs / 1000), ShedWorkStr[ShedLevel]);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(DEADLINE_MON_SHED_EID, CFE_EVS_EventType_INFORMATION,
+                        "Controller lowered its load shedding level, resumed %s",
+                        ShedWorkStr[DeadlineMon->ShedLevel]);
+   }
+
+   DeadlineMon->ShedLevel = ShedLevel;
+
+} /* End SetShedLevel() */
@@ -0,0 +1,246 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Guard each control cycle's actuator command deadline
+**
+**  Notes:
+**    1. Each control cycle has a deadline measured from the start of the
+**       cycle. A high priority watchdog child task is armed at the start of
+**       every cycle and sleeps until the cycle's deadline. If the cycle
+**       hasn't claimed its actuator command by then the watchdog sends the
+**       safe actuator command and counts a missed deadline. The safe command has
+**       zero wheel torque, magnetic torquer and solar array gimbal commands
+**       and is built by the constructor so sending it only needs a time
+**       stamp.
+**    2. The control task claims the actuator command immediately before it's
+**       transmitted. A command that loses the claim to the watchdog is late
+**       and isn't sent so the actuators never receive a late command after
+**       the safe command. Claims and the watchdog's check are one atomic
+**       compare and exchange on a token that holds the cycle's sequence
+**       number so a watchdog that wakes after its cycle ended has no effect.
+**    3. The watchdog must run at a higher priority than the app, i.e. the
+**       INI DEADLINE_MON_CHILD_PRIORITY must stay a lower number than the
+**       app's priority in bc42_ctrl.json, so it's on time when the app's
+**       cycle is delayed by CPU contention. At the app's priority or below
+**       it can't preempt a running cycle and a late cycle is only caught
+**       after it ends.
+**    4. The watchdog waits with OS_TaskDelay(), which takes whole
+**       milliseconds. The remaining time is rounded up so the watchdog
+**       never fires early, which means it can fire up to a millisecond
+**       plus one OS clock tick after the deadline.
+**    5. The deadline is measured from DEADLINE_MON_StartCycle(), which the
+**       control cycle calls after the sensor data message is received and
+**       checked. Time before that isn't guarded: a control task that is
+**       starved before CFE_SB_ReceiveBuffer() returns never arms the
+**       watchdog so no safe command is sent for that message. The latency
+**       monitor measures from the message's time stamp and reports these
+**       delays. See latency_mon.h.
+**    6. Optional cycle work is shed when a cycle is at risk of missing its
+**       deadline. A cycle is at risk when the time from the start of the
+**       cycle exceeds the at-risk limit, either after the actuator command
+**       is sent or at the end of the cycle. Each at-risk cycle raises the
+**       shed level by one and DEADLINE_MON_RECOVER_CYC consecutive cycles
+**       that aren't at risk lower it by one. Work is shed in this order:
+**       - Level 1: Controller telemetry
+**       - Level 2: TakeSci evaluation, the flag keeps its previous value
+**       - Level 3: Debug log records
+**    7. A deadline of 0 disables the watchdog and load shedding.
+**       Without a watchdog task, e.g. on the host, load shedding still runs
+**       and every actuator command claim succeeds.
+**
+*/
+#ifndef _deadline_mon_
+#define _deadline_mon_
+
+/*
+** Includes
+*/
+
+#include "bc42_intf_eds_typedefs.h"
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define DEADLINE_MON_CHILD_TASK_EID  (DEADLINE_MON_BASE_EID + 0)
+#define DEADLINE_MON_MISS_EID        (DEADLINE_MON_BASE_EID + 1)
+#define DEADLINE_MON_SHED_EID        (DEADLINE_MON_BASE_EID + 2)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** Optional cycle work in the order it's shed
+*/
+typedef enum
+{
+
+   DEADLINE_MON_SHED_NONE      = 0,
+   DEADLINE_MON_SHED_CTRL_TLM  = 1,
+   DEADLINE_MON_SHED_TAKE_SCI  = 2,
+   DEADLINE_MON_SHED_DEBUG_LOG = 3
+
+} DEADLINE_MON_ShedLevel_t;
+
+#define DEADLINE_MON_SHED_MAX  DEADLINE_MON_SHED_DEBUG_LOG
+
+
+/******************************************************************************
+** DEADLINE_MON Class
+*/
+
+typedef struct
+{
+
+   uint64  DeadlineNs;         /* 0 disables the monitor */
+   uint64  AtRiskNs;
+
+   uint64  StartNs;            /* Start of the current cycle */
+   bool    Armed;              /* Current cycle is guarded by the watchdog */
+   bool    AtRisk;             /* Current cycle has been at risk */
+
+   uint8   ShedLevel;          /* DEADLINE_MON_ShedLevel_t */
+   uint16  RecoverCnt;         /* Consecutive cycles that weren't at risk */
+
+   uint32  MissCnt;            /* Written by the watchdog task */
+   uint32  LateCmdCnt;         /* Actuator commands not sent because the deadline was missed */
+   uint32  ShedCycleCnt;       /* Cycles that shed work */
+
+   BC42_INTF_ActuatorCmdMsg_t  SafeCmdMsg;   /* Watchdog task only after construction */
+
+} DEADLINE_MON_Class_t;
+
+
+/******************************************************************************
+** DEADLINE_MON Watchdog
+** - One per app
+*/
+
+typedef struct
+{
+
+   CHILDMGR_Class_t  ChildMgr;
+   bool       ChildTaskValid;
+   osal_id_t  ArmSem;
+
+   /* Written by the control task before the token is armed */
+   DEADLINE_MON_Class_t *ArmedMon;
+   uint64     ArmNs;
+
+   uint32     Token;           /* (Cycle sequence << 2) | cycle state, see deadline_mon.c */
+   bool       Missing;         /* Watchdog task only, previous guarded cycle missed */
+
+} DEADLINE_MON_Watchdog_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_Constructor
+**
+** Initialize a DEADLINE_MON object. DeadlineUs and AtRiskUs are
+** measured from the start of the control cycle.
+**
+** Notes:
+**   1. This must be called prior to any other instance function.
+**
+*/
+void DEADLINE_MON_Constructor(DEADLINE_MON_Class_t *DeadlineMon, uint32 DeadlineUs,
+                              uint32 AtRiskUs, CFE_SB_MsgId_t ActuatorCmdMid);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_WatchdogConstructor
+**
+** Create the watchdog child task. See file prologue.
+**
+*/
+void DEADLINE_MON_WatchdogConstructor(DEADLINE_MON_Watchdog_t *WatchdogObj, const INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_ClaimActuator
+**
+** Returns true if the cycle's actuator command can be sent. Returns false
+** and counts a late command if the watchdog has sent the safe command.
+**
+*/
+bool DEADLINE_MON_ClaimActuator(DEADLINE_MON_Class_t *DeadlineMon);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_CheckRisk
+**
+** Raise the shed level if the cycle is at risk. Called after the actuator
+** command is sent and before any optional work.
+**
+*/
+void DEADLINE_MON_CheckRisk(DEADLINE_MON_Class_t *DeadlineMon);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_EndCycle
+**
+** Disarm the watchdog and update the shed level.
+**
+*/
+void DEADLINE_MON_EndCycle(DEADLINE_MON_Class_t *DeadlineMon);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_ResetStatus
+**
+** Clear the counters. The shed level is kept.
+**
+*/
+void DEADLINE_MON_ResetStatus(DEADLINE_MON_Class_t *DeadlineMon);
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_Shed
+**
+** Returns true if Work should be skipped this cycle.
+**
+*/
+static inline bool DEADLINE_MON_Shed(const DEADLINE_MON_Class_t *DeadlineMon, DEADLINE_MON_ShedLevel_t Work)
+{
+
+   return (DeadlineMon->ShedLevel >= Work);
+
+} /* End DEADLINE_MON_Shed() */
+
+
+/******************************************************************************
+** Function: DEADLINE_MON_StartCycle
+**
+** Arm the watchdog for a new control cycle.
+**
+*/
+void DEADLINE_MON_StartCycle(DEADLINE_MON_Class_t *DeadlineMon);
+
+
+#endif /* _deadline_mon_ */
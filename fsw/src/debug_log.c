@@ -0,0 +1,409 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the binary control cycle debug log
+**
+**  Notes:
+**    1. State is written with release semantics after the file handle so
+**       the child task sees an open file whenever it sees ACTIVE.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "bool_ovr.h"
+#include "debug_log.h"
+#include "mono_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define GET_STATE(DebugLog)      __atomic_load_n(&((DebugLog)->State), __ATOMIC_ACQUIRE)
+#define SET_STATE(DebugLog,Val)  __atomic_store_n(&((DebugLog)->State), (Val), __ATOMIC_RELEASE)
+
+#define FIELD(Name,Type,Cnt)  { #Name, offsetof(DEBUG_LOG_Rec_t, Name), Type, Cnt }
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool  ChildTaskCallback(CHILDMGR_Class_t *ChildMgr);
+static void  FlushRing(void);
+static int32 WriteFileHdrs(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static DEBUG_LOG_Class_t *DebugLog = NULL;
+
+/* Must contain DEBUG_LOG_FIELD_CNT entries in DEBUG_LOG_Rec_t order */
+static const DEBUG_LOG_Field_t FieldDef[DEBUG_LOG_FIELD_CNT] =
+{
+   FIELD(Seq,              DEBUG_LOG_FIELD_UINT32, 1),
+   FIELD(SensorSeconds,    DEBUG_LOG_FIELD_UINT32, 1),
+   FIELD(SensorSubseconds, DEBUG_LOG_FIELD_UINT32, 1),
+   FIELD(ExeTime,          DEBUG_LOG_FIELD_UINT32, 1),
+   FIELD(CycleStart,       DEBUG_LOG_FIELD_UINT64, 1),
+   FIELD(wbn,              DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(wln,              DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(qbr,              DEBUG_LOG_FIELD_DOUBLE, 4),
+   FIELD(therr,            DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(werr,             DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(Hvb,              DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(svb,              DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(Tcmd,             DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(Mcmd,             DEBUG_LOG_FIELD_DOUBLE, 3),
+   FIELD(SaGcmd,           DEBUG_LOG_FIELD_DOUBLE, 1),
+   FIELD(StValid,          DEBUG_LOG_FIELD_UINT8,  1),
+   FIELD(SunValid,         DEBUG_LOG_FIELD_UINT8,  1),
+   FIELD(TakeSci,          DEBUG_LOG_FIELD_UINT8,  1),
+   FIELD(Sensor,           DEBUG_LOG_FIELD_BYTES,  sizeof(BC42_INTF_SensorDataMsg_Payload_t))
+};
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_Constructor
+**
+*/
+void DEBUG_LOG_Constructor(DEBUG_LOG_Class_t *DebugLogObj, const INITBL_Class_t *IniTbl)
+{
+
+   int32 CfeStatus;
+   CHILDMGR_TaskInit_t ChildTaskInit;
+   
+   DebugLog = DebugLogObj;
+
+   CFE_PSP_MemSet((void*)DebugLog, 0, sizeof(DEBUG_LOG_Class_t));
+
+   DebugLog->State       = DEBUG_LOG_IDLE;
+   DebugLog->FlushPeriod = INITBL_GetIntConfig(IniTbl, CFG_DEBUG_LOG_FLUSH_PERIOD);
+
+   strncpy(DebugLog->Filename, INITBL_GetStrConfig(IniTbl, CFG_CTRL42_DEBUG_FILE), OS_MAX_PATH_LEN);
+   DebugLog->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SPSC_RING_Constructor(&DebugLog->Ring, DebugLog->RecBuf, sizeof(DEBUG_LOG_Rec_t), DEBUG_LOG_REC_CNT);
+
+   ChildTaskInit.TaskName  = INITBL_GetStrConfig(IniTbl, CFG_DEBUG_LOG_CHILD_NAME);
+   ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_DEBUG_LOG_CHILD_STACK_SIZE);
+   ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_DEBUG_LOG_CHILD_PRIORITY);
+   ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_DEBUG_LOG_CHILD_PERF_ID);
+
+   CfeStatus = CHILDMGR_Constructor(&DebugLog->ChildMgr, ChildMgr_TaskMainCallback,
+                                    ChildTaskCallback, &ChildTaskInit);
+
+   DebugLog->ChildTaskValid = (CfeStatus == CFE_SUCCESS);
+   if (!DebugLog->ChildTaskValid)
+   {
+      CFE_EVS_SendEvent(DEBUG_LOG_CHILD_TASK_EID, CFE_EVS_EventType_ERROR,
+                        "Debug log child task %s creation failed, status 0x%08X. Debug logging is unavailable",
+                        ChildTaskInit.TaskName, (unsigned int)CfeStatus);
+   }
+
+} /* End DEBUG_LOG_Constructor() */
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_AddRec
+**
+*/
+void DEBUG_LOG_AddRec(DEBUG_LOG_Class_t *DebugLogObj, const BC42_INTF_SensorDataMsg_t *SensorDataMsg,
+                      const BC42_Ac_t *Ac42, const double Tcmd[3], uint32 SensorValid,
+                      bool TakeSci, uint64 CycleStart)
+{
+
+   int i;
+   DEBUG_LOG_Rec_t    Rec;
+   CFE_TIME_SysTime_t SensorTime;
+
+   if (GET_STATE(DebugLogObj) == DEBUG_LOG_ACTIVE)
+   {
+
+      memset(&Rec, 0, sizeof(DEBUG_LOG_Rec_t));
+
+      CFE_MSG_GetMsgTime(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), &SensorTime);
+      Rec.Seq              = DebugLogObj->Seq++;
+      Rec.SensorSeconds    = SensorTime.Seconds;
+      Rec.SensorSubseconds = SensorTime.Subseconds;
+      Rec.CycleStart       = CycleStart;
+
+      for (i=0; i < 3; i++)
+      {
+         Rec.wbn[i]   = Ac42->wbn[i];
+         Rec.wln[i]   = Ac42->wln[i];
+         Rec.qbr[i]   = Ac42->qbr[i];
+         Rec.therr[i] = Ac42->CmgCtrl.therr[i];
+         Rec.werr[i]  = Ac42->CmgCtrl.werr[i];
+         Rec.Hvb[i]   = Ac42->Hvb[i];
+         Rec.svb[i]   = Ac42->svb[i];
+         Rec.Tcmd[i]  = Tcmd[i];
+         Rec.Mcmd[i]  = Ac42->Mcmd[i];
+      }
+      Rec.qbr[3]   = Ac42->qbr[3];
+      Rec.SaGcmd   = Ac42->G[0].GCmd.AngRate[0];
+      Rec.StValid  = (SensorValid & BOOL_OVR_BIT(BC42_CTRL_Bool42Id_St_VALID)) != 0;
+      Rec.SunValid = (SensorValid & BOOL_OVR_BIT(BC42_CTRL_Bool42Id_Sun_VALID)) != 0;
+      Rec.TakeSci  = TakeSci;
+
+      memcpy(&Rec.Sensor, &SensorDataMsg->Payload, sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+
+      Rec.ExeTime = (uint32)(MONO_TIME_GetNs() - CycleStart);
+
+      SPSC_RING_Push(&DebugLogObj->Ring, &Rec);
+
+   } /* End if active */
+
+} /* End DEBUG_LOG_AddRec() */
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_DisableCmd
+**
+*/
+bool DEBUG_LOG_DisableCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   DEBUG_LOG_Class_t *DebugLogObj = (DEBUG_LOG_Class_t *)ObjDataPtr;
+
+   if (GET_STATE(DebugLogObj) == DEBUG_LOG_ACTIVE)
+   {
+      SET_STATE(DebugLogObj, DEBUG_LOG_CLOSING);
+      CFE_EVS_SendEvent(DEBUG_LOG_DISABLE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Debug log file %s will be closed after the record buffer is flushed",
+                        DebugLogObj->Filename);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(DEBUG_LOG_DISABLE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Disable debug command had no effect, debug log not currently enabled.");
+   }
+              
+   return true;
+
+} /* End DEBUG_LOG_DisableCmd() */
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_EnableCmd
+**
+*/
+bool DEBUG_LOG_EnableCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   DEBUG_LOG_Class_t *DebugLogObj = (DEBUG_LOG_Class_t *)ObjDataPtr;
+   bool          RetStatus = false;
+   int32         SysStatus;
+   os_err_name_t OsErrStr;
+
+   if (!DebugLogObj->ChildTaskValid)
+   {
+      CFE_EVS_SendEvent(DEBUG_LOG_ENABLE_CMD_EID, CFE_EVS_EventType_ERROR, 
+                        "Enable debug command rejected, debug log child task not running");
+   }
+   else if (GET_STATE(DebugLogObj) != DEBUG_LOG_IDLE)
+   {
+      CFE_EVS_SendEvent(DEBUG_LOG_ENABLE_CMD_EID, CFE_EVS_EventType_ERROR, 
+                        "Enable debug command had no effect, debug log already enabled or closing");
+   }
+   else
+   {
+      
+      SysStatus = OS_OpenCreate(&DebugLogObj->FileHandle, DebugLogObj->Filename, 
+                                OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+      
+      if (SysStatus == OS_SUCCESS)
+      {   
+         
+         SysStatus = WriteFileHdrs();
+         
+         if (SysStatus == OS_SUCCESS)
+         {
+            DebugLogObj->Seq         = 0;
+            DebugLogObj->RecWriteCnt = 0;
+            DebugLogObj->WriteErrCnt = 0;
+            SPSC_RING_Reset(&DebugLogObj->Ring);
+            SET_STATE(DebugLogObj, DEBUG_LOG_ACTIVE);
+            
+            CFE_EVS_SendEvent(DEBUG_LOG_ENABLE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                              "Created debug log file %s with %d byte records",
+                              DebugLogObj->Filename, (int)sizeof(DEBUG_LOG_Rec_t));
+            RetStatus = true;
+         }
+         else
+         {
+            OS_close(DebugLogObj->FileHandle);
+            CFE_EVS_SendEvent(DEBUG_LOG_ENABLE_CMD_EID, CFE_EVS_EventType_ERROR, 
+                              "Error writing debug log file %s headers", DebugLogObj->Filename);
+         }
+      }
+      else 
+      {
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent(DEBUG_LOG_ENABLE_CMD_EID, CFE_EVS_EventType_ERROR, 
+                           "Error creating debug log file %s. Status = %s", DebugLogObj->Filename, OsErrStr);
+      
+      } /* End if error creating file */
+   } /* End if debug not enabled */
+
+   return RetStatus;
+
+} /* End DEBUG_LOG_EnableCmd() */
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_Enabled
+**
+*/
+bool DEBUG_LOG_Enabled(const DEBUG_LOG_Class_t *DebugLogObj)
+{
+
+   return (GET_STATE(DebugLogObj) == DEBUG_LOG_ACTIVE);
+
+} /* End DEBUG_LOG_Enabled() */
+
+
+/******************************************************************************
+** Function: ChildTaskCallback
+**
+** Notes:
+**   1. Called in a loop by the child task manager. Returning false would
+**      terminate the child task.
+**
+*/
+static bool ChildTaskCallback(CHILDMGR_Class_t *ChildMgr)
+{
+
+   uint32 State;
+
+   OS_TaskDelay(DebugLog->FlushPeriod);
+
+   State = GET_STATE(DebugLog);
+   
+   if (State != DEBUG_LOG_IDLE)
+   {
+
+      FlushRing();
+
+      /* Control task stopped adding records before setting CLOSING so the ring is empty */
+      if (State == DEBUG_LOG_CLOSING)
+      {
+
+         OS_close(DebugLog->FileHandle);
+
+         CFE_EVS_SendEvent(DEBUG_LOG_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Debug log file %s closed. Wrote %u records, dropped %u, %u write errors",
+                           DebugLog->Filename, (unsigned int)DebugLog->RecWriteCnt,
+                           (unsigned int)DebugLog->Ring.OverflowCnt, (unsigned int)DebugLog->WriteErrCnt);
+
+         SET_STATE(DebugLog, DEBUG_LOG_IDLE);
+
+      }
+   } /* End if not idle */
+
+   return true;
+
+} /* End ChildTaskCallback() */
+
+
+/******************************************************************************
+** Function: FlushRing
+**
+** Write every record in the ring to the file.
+**
+** Notes:
+**   1. A wrapped ring takes two writes.
+**   2. Records are released after a failed write so a persistent file
+**      error can't stall the control task. The first error in a session
+**      is reported with an event.
+*/
+static void FlushRing(void)
+{
+
+   int32  SysStatus;
+   uint32 RecCnt;
+   const void *Rec;
+
+   RecCnt = SPSC_RING_GetReadSpan(&DebugLog->Ring, &Rec);
+   
+   while (RecCnt > 0)
+   {
+   
+      SysStatus = OS_write(DebugLog->FileHandle, Rec, RecCnt * sizeof(DEBUG_LOG_Rec_t));
+      
+      if (SysStatus == (int32)(RecCnt * sizeof(DEBUG_LOG_Rec_t)))
+      {
+         DebugLog->RecWriteCnt += RecCnt;
+      }
+      else
+      {
+         if (DebugLog->WriteErrCnt == 0)
+         {
+            CFE_EVS_SendEvent(DEBUG_LOG_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "Debug log file %s write error, status %d", DebugLog->Filename, (int)SysStatus);
+         }
+         DebugLog->WriteErrCnt++;
+      }
+      
+      SPSC_RING_Release(&DebugLog->Ring, RecCnt);
+      RecCnt = SPSC_RING_GetReadSpan(&DebugLog->Ring, &Rec);
+   
+   } /* End while records */
+
+} /* End FlushRing() */
+
+
+/******************************************************************************
+** Function: WriteFileHdrs
+**
+** Write the cFE file header and the record layout header.
+**
+*/
+static int32 WriteFileHdrs(void)
+{
+
+   int32 RetStatus = OS_ERROR;
+   CFE_FS_Header_t     CfeHdr;
+   DEBUG_LOG_FileHdr_t LogHdr;
+
+   CFE_FS_InitHeader(&CfeHdr, "BC42_CTRL debug log", DEBUG_LOG_FS_SUBTYPE);
+   
+   if (CFE_FS_WriteHeader(DebugLog->FileHandle, &CfeHdr) == sizeof(CFE_FS_Header_t))
+   {
+
+      memset(&LogHdr, 0, sizeof(DEBUG_LOG_FileHdr_t));
+      memcpy(LogHdr.FileId, DEBUG_LOG_FILE_ID, sizeof(LogHdr.FileId));
+      LogHdr.Version   = DEBUG_LOG_FILE_VERSION;
+      LogHdr.FieldCnt  = DEBUG_LOG_FIELD_CNT;
+      LogHdr.ByteOrder = 0x01020304;
+      LogHdr.HdrSize   = sizeof(DEBUG_LOG_FileHdr_t);
+      LogHdr.RecSize   = sizeof(DEBUG_LOG_Rec_t);
+      memcpy(LogHdr.Field, FieldDef, sizeof(LogHdr.Field));
+   
+      if (OS_write(DebugLog->FileHandle, &LogHdr, sizeof(DEBUG_LOG_FileHdr_t)) == sizeof(DEBUG_LOG_FileHdr_t))
+      {
+         RetStatus = OS_SUCCESS;
+      }
+   }
+   
+   return RetStatus;
+
+} /* End WriteFileHdrs() */
@@ -0,0 +1,270 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record a binary debug log of every control cycle
+**
+**  Notes:
+**    1. The control task copies one fixed-size record per control cycle
+**       into a preallocated ring. A low priority child task periodically
+**       writes the ring to the log file in contiguous spans so the control
+**       task never waits on file I/O. Records are dropped and counted if
+**       the ring fills.
+**    2. The log file starts with a cFE file header followed by a
+**       DEBUG_LOG_FileHdr_t that lists the name, offset, type and element
+**       count of every record field so logs can be decoded offline. The
+**       sensor data message payload is recorded as raw bytes and decoded
+**       with the BC42_INTF EDS.
+**    3. The child task owns the file while logging. The disable command
+**       only requests a stop and the child task closes the file after the
+**       ring has been flushed.
+**
+*/
+#ifndef _debug_log_
+#define _debug_log_
+
+/*
+** Includes
+*/
+
+#include "bc42_intf_eds_typedefs.h"
+
+#include "app_cfg.h"
+#include "bc42_lib.h"
+#include "spsc_ring.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define DEBUG_LOG_FILE_ID       "BC42DLOG"
+#define DEBUG_LOG_FILE_VERSION  1
+#define DEBUG_LOG_FS_SUBTYPE    0x42444C47  /* "BDLG" */
+
+#define DEBUG_LOG_FIELD_NAME_LEN  16
+
+
+/*
+** Event Message IDs
+*/
+
+#define DEBUG_LOG_ENABLE_CMD_EID   (DEBUG_LOG_BASE_EID + 0)
+#define DEBUG_LOG_DISABLE_CMD_EID  (DEBUG_LOG_BASE_EID + 1)
+#define DEBUG_LOG_CHILD_TASK_EID   (DEBUG_LOG_BASE_EID + 2)
+#define DEBUG_LOG_WRITE_ERR_EID    (DEBUG_LOG_BASE_EID + 3)
+#define DEBUG_LOG_CLOSE_EID        (DEBUG_LOG_BASE_EID + 4)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   DEBUG_LOG_IDLE    = 0,    /* No file open                         */
+   DEBUG_LOG_ACTIVE  = 1,    /* Control task adding records          */
+   DEBUG_LOG_CLOSING = 2     /* Child task flushing before closing   */
+
+} DEBUG_LOG_State_t;
+
+typedef enum
+{
+
+   DEBUG_LOG_FIELD_UINT8   = 1,
+   DEBUG_LOG_FIELD_UINT32  = 2,
+   DEBUG_LOG_FIELD_UINT64  = 3,
+   DEBUG_LOG_FIELD_DOUBLE  = 4,
+   DEBUG_LOG_FIELD_BYTES   = 5
+
+} DEBUG_LOG_FieldType_t;
+
+
+/******************************************************************************
+** Log File Definitions
+** - Multi-byte values are written in the host's byte order. The file header
+**   ByteOrder field is 0x01020304 in that byte order.
+*/
+
+typedef struct
+{
+
+   uint32  Seq;                /* Control cycle sequence, detects dropped records */
+   uint32  SensorSeconds;      /* Sensor data message time */
+   uint32  SensorSubseconds;
+   uint32  ExeTime;            /* Nanoseconds, cycle start to record */
+   uint64  CycleStart;         /* Nanoseconds, monotonic clock */
+
+   double  wbn[3];
+   double  wln[3];
+   double  qbr[4];
+   double  therr[3];
+   double  werr[3];
+   double  Hvb[3];
+   double  svb[3];
+   double  Tcmd[3];
+   double  Mcmd[3];
+   double  SaGcmd;
+
+   uint8   StValid;
+   uint8   SunValid;
+   uint8   TakeSci;
+   uint8   Spare[5];
+
+   BC42_INTF_SensorDataMsg_Payload_t  Sensor;
+
+} DEBUG_LOG_Rec_t;
+
+typedef struct
+{
+
+   char    Name[DEBUG_LOG_FIELD_NAME_LEN];
+   uint32  Offset;             /* Bytes from the start of a record */
+   uint16  Type;               /* DEBUG_LOG_FieldType_t */
+   uint16  Cnt;                /* Elements, bytes for DEBUG_LOG_FIELD_BYTES */
+
+} DEBUG_LOG_Field_t;
+
+#define DEBUG_LOG_FIELD_CNT  19  /* Must match the FieldDef[] table in debug_log.c */
+
+typedef struct
+{
+
+   char    FileId[8];          /* DEBUG_LOG_FILE_ID, not null terminated */
+   uint16  Version;
+   uint16  FieldCnt;
+   uint32  ByteOrder;
+   uint32  HdrSize;            /* Bytes, this header */
+   uint32  RecSize;            /* Bytes, records follow the header */
+   DEBUG_LOG_Field_t  Field[DEBUG_LOG_FIELD_CNT];
+
+} DEBUG_LOG_FileHdr_t;
+
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** DEBUG_LOG Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+   
+   CHILDMGR_Class_t  ChildMgr;
+   bool              ChildTaskValid;
+
+   /*
+   ** Shared with the child task
+   */
+
+   uint32     State;           /* DEBUG_LOG_State_t, accessed atomically */
+   osal_id_t  FileHandle;
+   SPSC_RING_Class_t  Ring;
+   DEBUG_LOG_Rec_t    RecBuf[DEBUG_LOG_REC_CNT];
+
+   /*
+   ** Control task data
+   */
+
+   uint32  Seq;
+   uint32  FlushPeriod;        /* Milliseconds */
+   char    Filename[OS_MAX_PATH_LEN];
+
+   /*
+   ** Child task data
+   */
+
+   uint32  RecWriteCnt;
+   uint32  WriteErrCnt;
+
+} DEBUG_LOG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_Constructor
+**
+** Initialize a DEBUG_LOG object and start its child task.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void DEBUG_LOG_Constructor(DEBUG_LOG_Class_t *DebugLog, const INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_AddRec
+**
+** Add a control cycle record if logging is enabled.
+**
+** Notes:
+**   1. Called by the control task every control cycle. Only copies data
+**      into the ring.
+**   2. Tcmd is the torque command sent to the actuators and SensorValid
+**      holds the cycle's BOOL_OVR validity flags with overrides applied.
+**      Ac42's copies are BC42_LIB's and don't include either.
+**
+*/
+void DEBUG_LOG_AddRec(DEBUG_LOG_Class_t *DebugLog, const BC42_INTF_SensorDataMsg_t *SensorDataMsg,
+                      const BC42_Ac_t *Ac42, const double Tcmd[3], uint32 SensorValid,
+                      bool TakeSci, uint64 CycleStart);
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_DisableCmd
+**
+** Stop logging. The child task flushes the ring and closes the file.
+**
+*/
+bool DEBUG_LOG_DisableCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_EnableCmd
+**
+** Create the log file, write its headers and start logging.
+**
+** TODO - Add file command parameter
+*/
+bool DEBUG_LOG_EnableCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: DEBUG_LOG_Enabled
+**
+** Return true if control cycles are being recorded.
+**
+*/
+bool DEBUG_LOG_Enabled(const DEBUG_LOG_Class_t *DebugLog);
+
+
+#endif /* _debug_log_ */
@@ -0,0 +1,720 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the scripted sensor fault injection
+**
+**  Notes:
+**    1. Script values are array elements and top level values that aren't
+**       table objects so JSON_STREAM passes every value to ScriptValue().
+**       The fields loaded for each entry are tracked in "LoadField" and
+**       CheckScript() checks each entry once the file is parsed.
+**    2. A script file always replaces the whole script.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include "fault_inj.h"
+#include "json_stream.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define ENTRIES_KEY  "entries"
+
+/* Entry fields loaded from a file */
+#define FIELD_AT      0x01
+#define FIELD_TARGET  0x02
+#define FIELD_ACTION  0x04
+#define FIELD_VALUE   0x08
+#define FIELD_STATE   0x10
+
+#define TWO_PI  6.283185307179586
+
+#define SENSOR_VAL(Sensor, Target)  ((double *)((uint8 *)(Sensor) + SensorTarget[Target]))
+
+
+/************************************/
+/** Local File Function Prototypes **/
+/************************************/
+
+static void   ApplySensorFaults(FAULT_INJ_Class_t *FaultInj, BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+static bool   CheckScript(void);
+static bool   DumpCmd(osal_id_t FileHandle);
+static void   ExeEntry(FAULT_INJ_Class_t *FaultInj, const FAULT_INJ_Entry_t *Entry,
+                       const BC42_INTF_SensorDataMsg_Payload_t *SensorIn);
+static int    FindName(const char *const Name[], int NameCnt, const char *Token);
+static double GaussRand(uint64 *Rand);
+static bool   LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename);
+static bool   ScriptValue(void *UserObj, const JSON_STREAM_Value_t *Value);
+static void   StageScript(void);
+static void   StartNewScript(FAULT_INJ_Class_t *FaultInj);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static FAULT_INJ_Class_t *FaultInjObj = NULL;  /* Table manager callbacks don't identify an object */
+
+static FAULT_INJ_Script_t  LoadScript;      /* Loading task only, working buffer for loads */
+static uint8               LoadField[FAULT_INJ_ENTRY_MAX];
+static JSON_STREAM_Class_t JsonStream;
+
+static const char *const TimeBaseName[] = { "cycle", "time" };
+
+static const char *const ActionName[FAULT_INJ_ACTION_CNT] =
+{
+   "override", "freeze", "bias", "noise", "drop", "clear"
+};
+
+/* Indexed by BC42_CTRL_Bool42State_Enum_t */
+static const char *const StateName[BC42_CTRL_Bool42State_COUNT] = { "sim", "true", "false" };
+
+/*
+** Targets, see FAULT_INJ_Entry_t. Flags are indexed by
+** BC42_CTRL_Bool42Id_Enum_t.
+*/
+static const char *const TargetName[FAULT_INJ_SENSOR_CNT + BC42_CTRL_Bool42Id_COUNT] =
+{
+   "qbn.0", "qbn.1", "qbn.2", "qbn.3",
+   "wbn.0", "wbn.1", "wbn.2",
+   "svb.0", "svb.1", "svb.2",
+   "bvb.0", "bvb.1", "bvb.2",
+   "hw.0",  "hw.1",  "hw.2",  "hw.3",
+   "sun-valid", "st-valid", "gps-valid"
+};
+
+static const size_t SensorTarget[FAULT_INJ_SENSOR_CNT] =
+{
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, qbn[0]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, qbn[1]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, qbn[2]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, qbn[3]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, wbn[0]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, wbn[1]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, wbn[2]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, svb[0]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, svb[1]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, svb[2]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, bvb[0]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, bvb[1]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, bvb[2]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, Hw[0]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, Hw[1]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, Hw[2]),
+   offsetof(BC42_INTF_SensorDataMsg_Payload_t, Hw[3])
+};
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Constructor
+**
+*/
+void FAULT_INJ_Constructor(FAULT_INJ_Class_t *FaultInj, BOOL_OVR_Class_t *BoolOvr)
+{
+
+   CFE_PSP_MemSet((void*)FaultInj, 0, sizeof(FAULT_INJ_Class_t));
+
+   FaultInj->BoolOvr = BoolOvr;
+
+   FaultInj->ActiveBuf  = 0;
+   FaultInj->PendingBuf = 1;
+   FaultInj->FreeBuf    = 2;
+   FaultInj->NewestBuf  = FaultInj->ActiveBuf;
+
+   FaultInjObj = FaultInj;
+
+} /* End FAULT_INJ_Constructor() */
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Ingest
+**
+*/
+bool FAULT_INJ_Ingest(FAULT_INJ_Class_t *FaultInj, CFE_TIME_SysTime_t SensorTime,
+                      const BC42_INTF_SensorDataMsg_Payload_t *SensorIn,
+                      BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   const FAULT_INJ_Script_t *Script;
+   bool   Keep = true;
+   double Now;
+
+   if (__atomic_load_n(&FaultInj->PendingBuf, __ATOMIC_RELAXED) & FAULT_INJ_SCRIPT_BUF_PENDING)
+   {
+      StartNewScript(FaultInj);
+   }
+   Script = &FaultInj->Script[FaultInj->ActiveBuf];
+
+   if (Script->TimeBase == FAULT_INJ_TIME_BASE_CYCLE)
+   {
+      Now = (double)FaultInj->MsgCnt;
+   }
+   else
+   {
+      Now = (double)SensorTime.Seconds + (double)SensorTime.Subseconds / 4294967296.0;
+   }
+
+   while (FaultInj->Cursor < Script->EntryCnt && Script->Entry[FaultInj->Cursor].At <= Now)
+   {
+      ExeEntry(FaultInj, &Script->Entry[FaultInj->Cursor], SensorIn);
+      FaultInj->Cursor++;
+   }
+   FaultInj->MsgCnt++;
+
+   *Sensor = *SensorIn;
+   if (FaultInj->FaultMask != 0)
+   {
+      ApplySensorFaults(FaultInj, Sensor);
+   }
+
+   if (FaultInj->DropCnt > 0)
+   {
+      FaultInj->DropCnt--;
+      FaultInj->DroppedCnt++;
+      Keep = false;
+   }
+
+   return Keep;
+
+} /* End FAULT_INJ_Ingest() */
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Register
+**
+*/
+uint8 FAULT_INJ_Register(TBLMGR_Class_t *TblMgr, const char *TblFilename)
+{
+
+   return TBLMGR_RegisterTblWithDef(TblMgr, FAULT_INJ_TBL_NAME, LoadCmd, DumpCmd, TblFilename);
+
+} /* End FAULT_INJ_Register() */
+
+
+/******************************************************************************
+** Function: FAULT_INJ_ResetStatus
+**
+*/
+void FAULT_INJ_ResetStatus(FAULT_INJ_Class_t *FaultInj)
+{
+
+   FaultInj->ExeCnt     = 0;
+   FaultInj->DroppedCnt = 0;
+
+} /* End FAULT_INJ_ResetStatus() */
+
+
+/******************************************************************************
+** Function: ApplySensorFaults
+**
+** Notes:
+**   1. A frozen value ignores its bias and noise.
+**
+*/
+static void ApplySensorFaults(FAULT_INJ_Class_t *FaultInj, BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   double *Val;
+   int    t;
+
+   for (t=0; t < FAULT_INJ_SENSOR_CNT; t++)
+   {
+      if (FaultInj->FaultMask & (1 << t))
+      {
+         Val = SENSOR_VAL(Sensor, t);
+         if (FaultInj->FrozenMask & (1 << t))
+         {
+            *Val = FaultInj->Frozen[t];
+         }
+         else
+         {
+            *Val += FaultInj->Bias[t];
+            if (FaultInj->NoiseSd[t] > 0.0)
+            {
+               *Val += FaultInj->NoiseSd[t] * GaussRand(&FaultInj->Rand);
+            }
+         }
+      }
+   }
+
+} /* End ApplySensorFaults() */
+
+
+/******************************************************************************
+** Function: CheckScript
+**
+** Check the entries loaded from a file. Returns false and reports the first
+** invalid entry.
+**
+*/
+static bool CheckScript(void)
+{
+
+   const FAULT_INJ_Entry_t *Entry;
+   const char *Error = NULL;
+   uint32 i;
+   bool   SensorTgt;
+
+   for (i=0; i < LoadScript.EntryCnt && Error == NULL; i++)
+   {
+
+      Entry = &LoadScript.Entry[i];
+      SensorTgt = (Entry->Target < FAULT_INJ_SENSOR_CNT);
+
+      if ((LoadField[i] & FIELD_AT) == 0 || (LoadField[i] & FIELD_ACTION) == 0)
+      {
+         Error = "\"at\" and \"action\" are required";
+      }
+      else if (!(Entry->At >= 0.0) ||
+               (LoadScript.TimeBase == FAULT_INJ_TIME_BASE_CYCLE && Entry->At != floor(Entry->At)))
+      {
+         Error = "\"at\" must be non-negative and a whole number of cycles for a cycle time base";
+      }
+      else if (i > 0 && Entry->At < LoadScript.Entry[i-1].At)
+      {
+         Error = "entries must be in \"at\" order";
+      }
+      else if (Entry->Action != FAULT_INJ_DROP && (LoadField[i] & FIELD_TARGET) == 0)
+      {
+         Error = "\"target\" is required";
+      }
+      else if (Entry->Action == FAULT_INJ_OVERRIDE && (SensorTgt || (LoadField[i] & FIELD_STATE) == 0))
+      {
+         Error = "\"override\" requires a validity flag target and a \"state\"";
+      }
+      else if ((Entry->Action == FAULT_INJ_FREEZE || Entry->Action == FAULT_INJ_BIAS ||
+                Entry->Action == FAULT_INJ_NOISE) && !SensorTgt)
+      {
+         Error = "\"freeze\", \"bias\" and \"noise\" require a sensor value target";
+      }
+      else if ((Entry->Action == FAULT_INJ_BIAS || Entry->Action == FAULT_INJ_NOISE) &&
+               (LoadField[i] & FIELD_VALUE) == 0)
+      {
+         Error = "\"bias\" and \"noise\" require a \"value\"";
+      }
+      else if (Entry->Action == FAULT_INJ_NOISE && !(Entry->Value >= 0.0))
+      {
+         Error = "noise \"value\" must be non-negative";
+      }
+      else if (Entry->Action == FAULT_INJ_DROP && !(Entry->Value >= 1.0 && Entry->Value == floor(Entry->Value)))
+      {
+         Error = "drop \"value\" must be a whole number of messages greater than zero";
+      }
+
+   } /* End entry loop */
+
+   if (Error != NULL)
+   {
+      CFE_EVS_SendEvent(FAULT_INJ_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "%s: Entry %u rejected, %s", FAULT_INJ_TBL_NAME, (unsigned int)(i-1), Error);
+   }
+
+   return (Error == NULL);
+
+} /* End CheckScript() */
+
+
+/******************************************************************************
+** Function: DumpCmd
+**
+** Notes:
+**  1. File is formatted so it can be used as a load file.
+**
+*/
+static bool DumpCmd(osal_id_t FileHandle)
+{
+
+   const FAULT_INJ_Script_t *Newest = &FaultInjObj->Script[FaultInjObj->NewestBuf];
+   const FAULT_INJ_Entry_t *Entry;
+   char   DumpRecord[256];
+   uint32 i;
+
+   sprintf(DumpRecord,"   \"time-base\": \"%s\",\n   \"seed\": %u,\n   \"%s\": [\n",
+           TimeBaseName[Newest->TimeBase], (unsigned int)Newest->Seed, ENTRIES_KEY);
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   for (i=0; i < Newest->EntryCnt; i++)
+   {
+      Entry = &Newest->Entry[i];
+      sprintf(DumpRecord,"      {\"at\": %.9g, \"action\": \"%s\"",
+              Entry->At, ActionName[Entry->Action]);
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+      if (Entry->Action != FAULT_INJ_DROP)
+      {
+         sprintf(DumpRecord,", \"target\": \"%s\"", TargetName[Entry->Target]);
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+
+      if (Entry->Action == FAULT_INJ_OVERRIDE)
+      {
+         sprintf(DumpRecord,", \"state\": \"%s\"", StateName[Entry->State]);
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+      else if (Entry->Action == FAULT_INJ_BIAS || Entry->Action == FAULT_INJ_NOISE ||
+               Entry->Action == FAULT_INJ_DROP)
+      {
+         sprintf(DumpRecord,", \"value\": %.7g", Entry->Value);
+         OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+      }
+
+      sprintf(DumpRecord,"}%s\n", (i < Newest->EntryCnt-1) ? "," : "");
+      OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+   }
+
+   sprintf(DumpRecord,"   ]\n");
+   OS_write(FileHandle, DumpRecord, strlen(DumpRecord));
+
+   return true;
+
+} /* End DumpCmd() */
+
+
+/******************************************************************************
+** Function: ExeEntry
+**
+*/
+static void ExeEntry(FAULT_INJ_Class_t *FaultInj, const FAULT_INJ_Entry_t *Entry,
+                     const BC42_INTF_SensorDataMsg_Payload_t *SensorIn)
+{
+
+   uint32 Bit = (uint32)1 << Entry->Target;
+
+   switch (Entry->Action)
+   {
+
+      case FAULT_INJ_OVERRIDE:
+         BOOL_OVR_SetState(FaultInj->BoolOvr, Entry->Target - FAULT_INJ_SENSOR_CNT, Entry->State);
+         break;
+
+      case FAULT_INJ_FREEZE:
+         FaultInj->Frozen[Entry->Target] = *SENSOR_VAL(SensorIn, Entry->Target);
+         FaultInj->FrozenMask |= Bit;
+         FaultInj->FaultMask  |= Bit;
+         break;
+
+      case FAULT_INJ_BIAS:
+         FaultInj->Bias[Entry->Target] = Entry->Value;
+         FaultInj->FaultMask |= Bit;
+         break;
+
+      case FAULT_INJ_NOISE:
+         FaultInj->NoiseSd[Entry->Target] = Entry->Value;
+         FaultInj->FaultMask |= Bit;
+         break;
+
+      case FAULT_INJ_DROP:
+         FaultInj->DropCnt += (uint32)Entry->Value;
+         break;
+
+      case FAULT_INJ_CLEAR:
+         if (Entry->Target < FAULT_INJ_SENSOR_CNT)
+         {
+            FaultInj->Bias[Entry->Target]    = 0.0;
+            FaultInj->NoiseSd[Entry->Target] = 0.0;
+            FaultInj->FrozenMask &= ~Bit;
+            FaultInj->FaultMask  &= ~Bit;
+         }
+         else
+         {
+            BOOL_OVR_SetState(FaultInj->BoolOvr, Entry->Target - FAULT_INJ_SENSOR_CNT,
+                              BC42_CTRL_Bool42State_USE_SIM);
+         }
+         break;
+
+      default:
+         break;
+
+   } /* End action switch */
+
+   FaultInj->ExeCnt++;
+
+   CFE_EVS_SendEvent(FAULT_INJ_EXE_EID, CFE_EVS_EventType_DEBUG,
+                     "Fault script entry %u at %.9g: %s %s",
+                     (unsigned int)FaultInj->Cursor, Entry->At, ActionName[Entry->Action],
+                     (Entry->Action == FAULT_INJ_DROP) ? "" : TargetName[Entry->Target]);
+
+} /* End ExeEntry() */
+
+
+/******************************************************************************
+** Function: FindName
+**
+** Return the index of Token in Name[], -1 if it isn't found.
+**
+*/
+static int FindName(const char *const Name[], int NameCnt, const char *Token)
+{
+
+   int i;
+
+   for (i=0; i < NameCnt && strcmp(Name[i], Token) != 0; i++);
+
+   return (i < NameCnt) ? i : -1;
+
+} /* End FindName() */
+
+
+/******************************************************************************
+** Function: GaussRand
+**
+** Unit normal value from a 64-bit LCG using the Box-Muller transform.
+**
+*/
+static double GaussRand(uint64 *Rand)
+{
+
+   double U1, U2;
+
+   *Rand = *Rand * 6364136223846793005ULL + 1442695040888963407ULL;
+   U1 = ((double)(*Rand >> 11) + 1.0) / 9007199254740993.0;   /* (0,1] so log() is finite */
+   *Rand = *Rand * 6364136223846793005ULL + 1442695040888963407ULL;
+   U2 = (double)(*Rand >> 11) / 9007199254740992.0;
+
+   return sqrt(-2.0*log(U1)) * cos(TWO_PI*U2);
+
+} /* End GaussRand() */
+
+
+/******************************************************************************
+** Function: LoadCmd
+**
+** Table manager load callback. Runs in the table loading task.
+**
+*/
+static bool LoadCmd(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename)
+{
+
+   bool RetStatus = false;
+
+   memset(&LoadScript, 0, sizeof(FAULT_INJ_Script_t));
+   memset(LoadField, 0, sizeof(LoadField));
+   LoadScript.TimeBase = FAULT_INJ_TIME_BASE_CYCLE;
+   LoadScript.Seed     = 1;
+
+   if (JSON_STREAM_ProcessFile(&JsonStream, Filename, NULL, 0, ScriptValue, NULL))
+   {
+      if (CheckScript())
+      {
+         StageScript();
+         RetStatus = true;
+      }
+   }
+
+   if (RetStatus)
+   {
+      CFE_EVS_SendEvent(FAULT_INJ_LOAD_EID, CFE_EVS_EventType_INFORMATION,
+                        "%s: Loaded %u entries from %s", FAULT_INJ_TBL_NAME,
+                        (unsigned int)LoadScript.EntryCnt, Filename);
+   }
+
+   return RetStatus;
+
+} /* End LoadCmd() */
+
+
+/******************************************************************************
+** Function: ScriptValue
+**
+** JSON_STREAM value callback that loads the script. Values that aren't part
+** of the script, e.g. the description strings, are ignored.
+**
+*/
+static bool ScriptValue(void *UserObj, const JSON_STREAM_Value_t *Value)
+{
+
+   FAULT_INJ_Entry_t *Entry;
+   const char *Field;
+   const char *Error = NULL;
+   int   Name = 0;
+   uint8 Bit  = 0;
+
+   if (strcmp(Value->Path, "time-base") == 0)
+   {
+      Name = (Value->Type == JSON_STREAM_STRING) ? FindName(TimeBaseName, 2, Value->Token) : -1;
+      if (Name < 0)
+      {
+         Error = "must be \"cycle\" or \"time\"";
+      }
+      else
+      {
+         LoadScript.TimeBase = Name;
+      }
+   }
+   else if (strcmp(Value->Path, "seed") == 0)
+   {
+      if (Value->Type != JSON_STREAM_NUMBER || !(Value->Number >= 0.0 && Value->Number <= 4294967295.0))
+      {
+         Error = "must be a 32-bit unsigned number";
+      }
+      else
+      {
+         LoadScript.Seed = (uint32)Value->Number;
+      }
+   }
+   else if (strncmp(Value->Path, ENTRIES_KEY ".", sizeof(ENTRIES_KEY)) == 0)
+   {
+
+      Field = &Value->Path[sizeof(ENTRIES_KEY)];
+
+      if (Value->Index == JSON_STREAM_NO_INDEX)
+      {
+         Error = "entries must be array elements";
+      }
+      else if (Value->Index >= FAULT_INJ_ENTRY_MAX)
+      {
+         Error = "more entries than FAULT_INJ_ENTRY_MAX";
+      }
+      else
+      {
+
+         Entry = &LoadScript.Entry[Value->Index];
+
+         if (strcmp(Field, "at") == 0 || strcmp(Field, "value") == 0)
+         {
+            if (Value->Type != JSON_STREAM_NUMBER)
+            {
+               Error = "value isn't a number";
+            }
+            else if (Field[0] == 'a')
+            {
+               Entry->At = Value->Number;
+               Bit = FIELD_AT;
+            }
+            else
+            {
+               Entry->Value = (float)Value->Number;
+               Bit = FIELD_VALUE;
+            }
+         }
+         else
+         {
+            if (Value->Type != JSON_STREAM_STRING)
+            {
+               Error = "value isn't a string";
+            }
+            else if (strcmp(Field, "target") == 0)
+            {
+               Name = FindName(TargetName, FAULT_INJ_SENSOR_CNT + BC42_CTRL_Bool42Id_COUNT, Value->Token);
+               Entry->Target = (uint8)Name;
+               Bit = FIELD_TARGET;
+               Error = (Name < 0) ? "unknown target" : NULL;
+            }
+            else if (strcmp(Field, "action") == 0)
+            {
+               Name = FindName(ActionName, FAULT_INJ_ACTION_CNT, Value->Token);
+               Entry->Action = (uint8)Name;
+               Bit = FIELD_ACTION;
+               Error = (Name < 0) ? "unknown action" : NULL;
+            }
+            else if (strcmp(Field, "state") == 0)
+            {
+               Name = FindName(StateName, BC42_CTRL_Bool42State_COUNT, Value->Token);
+               Entry->State = (uint8)Name;
+               Bit = FIELD_STATE;
+               Error = (Name < 0) ? "must be \"sim\", \"true\" or \"false\"" : NULL;
+            }
+            else
+            {
+               Error = "unknown entry key";
+            }
+         }
+
+         LoadField[Value->Index] |= Bit;
+         if (Value->Index >= LoadScript.EntryCnt)
+         {
+            LoadScript.EntryCnt = Value->Index + 1;
+            if ((LoadField[Value->Index] & FIELD_VALUE) == 0)
+            {
+               Entry->Value = 1.0;   /* Drop count default */
+            }
+         }
+
+      } /* End if valid index */
+
+   } /* End if entry value */
+
+   if (Error != NULL)
+   {
+      CFE_EVS_SendEvent(FAULT_INJ_LOAD_EID, CFE_EVS_EventType_ERROR,
+                        "%s: Value '%s' rejected, %s", FAULT_INJ_TBL_NAME, Value->Path, Error);
+   }
+
+   return (Error == NULL);
+
+} /* End ScriptValue() */
+
+
+/******************************************************************************
+** Function: StageScript
+**
+** Make the loaded script the pending and newest script.
+**
+** Notes:
+**   1. A pending script that hasn't been started is replaced and its copy
+**      becomes the free copy, see file prologue.
+**
+*/
+static void StageScript(void)
+{
+
+   uint32 StagedBuf = FaultInjObj->FreeBuf;
+
+   memcpy(&FaultInjObj->Script[StagedBuf], &LoadScript, sizeof(FAULT_INJ_Script_t));
+   FaultInjObj->NewestBuf = StagedBuf;
+
+   FaultInjObj->FreeBuf = __atomic_exchange_n(&FaultInjObj->PendingBuf, StagedBuf | FAULT_INJ_SCRIPT_BUF_PENDING,
+                                              __ATOMIC_ACQ_REL) & ~FAULT_INJ_SCRIPT_BUF_PENDING;
+
+} /* End StageScript() */
+
+
+/******************************************************************************
+** Function: StartNewScript
+**
+** Swap the pending script for the running script and start it.
+**
+*/
+static void StartNewScript(FAULT_INJ_Class_t *FaultInj)
+{
+
+   uint32 PendingBuf;
+
+   PendingBuf = __atomic_exchange_n(&FaultInj->PendingBuf, FaultInj->ActiveBuf, __ATOMIC_ACQ_REL);
+   FaultInj->ActiveBuf = PendingBuf & ~FAULT_INJ_SCRIPT_BUF_PENDING;
+
+   FaultInj->Cursor     = 0;
+   FaultInj->MsgCnt     = 0;
+   FaultInj->Rand       = FaultInj->Script[FaultInj->ActiveBuf].Seed;
+   FaultInj->FaultMask  = 0;
+   FaultInj->FrozenMask = 0;
+   FaultInj->DropCnt    = 0;
+   memset(FaultInj->Bias, 0, sizeof(FaultInj->Bias));
+   memset(FaultInj->NoiseSd, 0, sizeof(FaultInj->NoiseSd));
+
+   CFE_EVS_SendEvent(FAULT_INJ_EXE_EID, CFE_EVS_EventType_INFORMATION,
+                     "Started a fault script with %u entries",
+                     (unsigned int)FaultInj->Script[FaultInj->ActiveBuf].EntryCnt);
+
+} /* End StartNewScript() */
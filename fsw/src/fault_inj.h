@@ -0,0 +1,246 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Inject scripted faults into the sensor data ingested by the controller
+**
+**  Notes:
+**    1. The fault injection script is one table for the app. Each entry is
+**       executed by the controller when its time tag is reached:
+**       - "at":     Time tag, sensor messages ingested since the script was
+**                   started or the sensor message time in seconds, set by
+**                   the script's "time-base"
+**       - "target": A sensor data value, e.g. "wbn.0", or a validity flag,
+**                   "sun-valid", "st-valid" or "gps-valid"
+**       - "action": One of the following
+**                   "override" Set a validity flag's override to "state",
+**                              "true", "false" or "sim"
+**                   "freeze"   Hold a sensor value at its current value
+**                   "bias"     Add "value" to a sensor value
+**                   "noise"    Add Gaussian noise with standard deviation
+**                              "value" to a sensor value
+**                   "drop"     Discard the next "value" sensor messages,
+**                              default 1. Doesn't use a target.
+**                   "clear"    Remove a sensor value's freeze, bias and
+**                              noise or set a flag's override to "sim"
+**       The entries must be in time tag order.
+**    2. A load is parsed and checked by the table loading task. Scripts are
+**       exchanged with the controller the same way as CTRL42_TBL data: the
+**       object holds FAULT_INJ_SCRIPT_BUF_CNT script copies owned by index
+**       and the loading task swaps its filled free copy for the pending
+**       copy with one atomic exchange. The controller swaps a pending copy
+**       for its running copy at its next sensor message, so a new load
+**       replaces one that hasn't started and starting a script never copies
+**       it. Starting a script removes the sensor faults of the previous
+**       script. Validity flag overrides are shared with the SetBoolOvrState
+**       command and are kept.
+**    3. The object keeps a cursor to its next entry so checking the
+**       script costs one comparison per message plus one per executed
+**       entry. Sensor faults are only applied to values that have one.
+**    4. Noise comes from a generator seeded with the script's "seed" when
+**       the script starts so a script produces the same faults each run.
+**
+*/
+#ifndef _fault_inj_
+#define _fault_inj_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42_intf_eds_typedefs.h"
+#include "bool_ovr.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define FAULT_INJ_LOAD_EID  (FAULT_INJ_BASE_EID + 0)
+#define FAULT_INJ_DUMP_EID  (FAULT_INJ_BASE_EID + 1)
+#define FAULT_INJ_EXE_EID   (FAULT_INJ_BASE_EID + 2)
+
+/*
+** Sensor data values that can be faulted: qbn[4], wbn[3], svb[3], bvb[3]
+** and Hw[4]
+*/
+#define FAULT_INJ_SENSOR_CNT  17
+
+/*
+** Script copies, see file prologue
+*/
+
+#define FAULT_INJ_SCRIPT_BUF_CNT      3
+#define FAULT_INJ_SCRIPT_BUF_PENDING  0x80000000  /* Set in PendingBuf until the script is started */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   FAULT_INJ_TIME_BASE_CYCLE = 0,
+   FAULT_INJ_TIME_BASE_TIME  = 1
+
+} FAULT_INJ_TimeBase_t;
+
+typedef enum
+{
+
+   FAULT_INJ_OVERRIDE = 0,
+   FAULT_INJ_FREEZE   = 1,
+   FAULT_INJ_BIAS     = 2,
+   FAULT_INJ_NOISE    = 3,
+   FAULT_INJ_DROP     = 4,
+   FAULT_INJ_CLEAR    = 5,
+   FAULT_INJ_ACTION_CNT = 6
+
+} FAULT_INJ_Action_t;
+
+/*
+** Targets 0 to FAULT_INJ_SENSOR_CNT-1 are sensor values. A validity flag
+** target is FAULT_INJ_SENSOR_CNT plus its BC42_CTRL_Bool42Id_Enum_t.
+*/
+typedef struct
+{
+
+   double  At;
+   float   Value;
+   uint8   Target;
+   uint8   Action;
+   uint8   State;        /* BC42_CTRL_Bool42State_Enum_t for overrides */
+
+} FAULT_INJ_Entry_t;
+
+typedef struct
+{
+
+   uint32  TimeBase;     /* FAULT_INJ_TimeBase_t */
+   uint32  Seed;
+   uint32  EntryCnt;
+   FAULT_INJ_Entry_t  Entry[FAULT_INJ_ENTRY_MAX];
+
+} FAULT_INJ_Script_t;
+
+
+/******************************************************************************
+** FAULT_INJ Class
+*/
+
+typedef struct
+{
+
+   BOOL_OVR_Class_t  *BoolOvr;
+
+   /*
+   ** Script copies, see file prologue
+   */
+
+   FAULT_INJ_Script_t  Script[FAULT_INJ_SCRIPT_BUF_CNT];
+   uint32  ActiveBuf;    /* Control task only, running script */
+   uint32  PendingBuf;   /* Exchanged by both tasks */
+   uint32  FreeBuf;      /* Loading task only */
+   uint32  NewestBuf;    /* Loading task only, most recently accepted script */
+
+   /*
+   ** Script state, control task only
+   */
+
+   uint32  Cursor;       /* Next entry to execute */
+   uint32  MsgCnt;       /* Sensor messages ingested since the script started */
+   uint64  Rand;         /* Noise generator state */
+
+   /*
+   ** Active sensor faults
+   */
+
+   uint32  FaultMask;    /* Sensor values with a fault */
+   uint32  FrozenMask;
+   uint32  DropCnt;      /* Sensor messages left to drop */
+   double  Frozen[FAULT_INJ_SENSOR_CNT];
+   double  Bias[FAULT_INJ_SENSOR_CNT];
+   double  NoiseSd[FAULT_INJ_SENSOR_CNT];
+
+   /*
+   ** Status
+   */
+
+   uint32  ExeCnt;       /* Entries executed */
+   uint32  DroppedCnt;   /* Sensor messages dropped */
+
+} FAULT_INJ_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Constructor
+**
+** Initialize the controller's fault injection object. The object has no
+** script until one is loaded.
+**
+*/
+void FAULT_INJ_Constructor(FAULT_INJ_Class_t *FaultInj, BOOL_OVR_Class_t *BoolOvr);
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Ingest
+**
+** Execute the script entries that are due and copy the sensor data to
+** Sensor with the active faults applied. Returns false if the message is
+** dropped.
+**
+** Notes:
+**   1. Called by the controller for each sensor message before
+**      anything else uses the sensor data.
+**
+*/
+bool FAULT_INJ_Ingest(FAULT_INJ_Class_t *FaultInj, CFE_TIME_SysTime_t SensorTime,
+                      const BC42_INTF_SensorDataMsg_Payload_t *SensorIn,
+                      BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+
+
+/******************************************************************************
+** Function: FAULT_INJ_Register
+**
+** Register the fault injection script with the table manager and load the
+** default script file. Returns the table manager ID.
+**
+** Notes:
+**   1. Must be called after the FAULT_INJ object is constructed.
+**
+*/
+uint8 FAULT_INJ_Register(TBLMGR_Class_t *TblMgr, const char *TblFilename);
+
+
+/******************************************************************************
+** Function: FAULT_INJ_ResetStatus
+**
+** Reset counters to a known reset state.
+**
+*/
+void FAULT_INJ_ResetStatus(FAULT_INJ_Class_t *FaultInj);
+
+
+#endif /* _fault_inj_ */
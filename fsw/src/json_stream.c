@@ -0,0 +1,760 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the incremental JSON table parser
+**
+**  Notes:
+**    1. The lexer handles one character at a time. A number or literal is
+**       only complete when the following character arrives, so a token that
+**       spans two JSON_STREAM_Parse() calls is handled without look ahead.
+**    2. \u escapes are stored as '?' since table strings are ASCII.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include <stdlib.h>
+#include "json_stream.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LEVEL_OBJECT  0
+#define LEVEL_ARRAY   1
+
+#define LEX_NONE      0
+#define LEX_STRING    1
+#define LEX_SCALAR    2
+
+#define TOKEN_STRING  256   /* Token types that aren't a punctuation character */
+#define TOKEN_SCALAR  257
+
+#define IS_SCALAR_CHAR(c)  (((c) >= '0' && (c) <= '9') || ((c) >= 'a' && (c) <= 'z') || \
+                            ((c) >= 'A' && (c) <= 'Z') || (c) == '-' || (c) == '+' || (c) == '.')
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   EXPECT_VALUE = 0,
+   EXPECT_VALUE_OR_END,        /* First array element or ']' */
+   EXPECT_KEY,
+   EXPECT_KEY_OR_END,          /* First object key or '}' */
+   EXPECT_COLON,
+   EXPECT_COMMA_OR_END,
+   EXPECT_NOTHING              /* Top level value is complete */
+
+} Expect_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool AddKey(JSON_STREAM_Class_t *JsonStream);
+static void AddTokenChar(JSON_STREAM_Class_t *JsonStream, char c);
+static bool LoadObj(JSON_STREAM_Class_t *JsonStream, CJSON_Obj_t *Obj, const JSON_STREAM_Value_t *Value);
+static bool LoadValue(JSON_STREAM_Class_t *JsonStream, int Token);
+static bool ParseChar(JSON_STREAM_Class_t *JsonStream, char c);
+static bool ParseError(JSON_STREAM_Class_t *JsonStream, const char *Error);
+static void PopLevel(JSON_STREAM_Class_t *JsonStream);
+static bool ProcessToken(JSON_STREAM_Class_t *JsonStream, int Token);
+static bool PushLevel(JSON_STREAM_Class_t *JsonStream, uint8 Type);
+static void ValueDone(JSON_STREAM_Class_t *JsonStream);
+
+
+/******************************************************************************
+** Function: JSON_STREAM_End
+**
+*/
+bool JSON_STREAM_End(JSON_STREAM_Class_t *JsonStream)
+{
+
+   if (!JsonStream->Error)
+   {
+      if (JsonStream->Lex == LEX_SCALAR)
+      {
+         JsonStream->Lex = LEX_NONE;
+         JsonStream->Token[JsonStream->TokenLen] = '\0';
+         ProcessToken(JsonStream, TOKEN_SCALAR);
+      }
+
+      if (!JsonStream->Error)
+      {
+         if (JsonStream->Lex == LEX_STRING)
+         {
+            ParseError(JsonStream, "Unterminated string");
+         }
+         else if (JsonStream->Expect != EXPECT_NOTHING)
+         {
+            ParseError(JsonStream, "Unexpected end of input");
+         }
+      }
+   }
+
+   return !JsonStream->Error;
+
+} /* End JSON_STREAM_End() */
+
+
+/******************************************************************************
+** Function: JSON_STREAM_Parse
+**
+*/
+bool JSON_STREAM_Parse(JSON_STREAM_Class_t *JsonStream, const char *Buf, size_t BufLen)
+{
+
+   size_t i;
+
+   for (i=0; i < BufLen && !JsonStream->Error; i++)
+   {
+      ParseChar(JsonStream, Buf[i]);
+   }
+
+   return !JsonStream->Error;
+
+} /* End JSON_STREAM_Parse() */
+
+
+/******************************************************************************
+** Function: JSON_STREAM_ProcessFile
+**
+*/
+bool JSON_STREAM_ProcessFile(JSON_STREAM_Class_t *JsonStream, const char *Filename,
+                             CJSON_Obj_t *Obj, size_t ObjCnt,
+                             JSON_STREAM_ValueFunc_t ValueFunc, void *ValueFuncObj)
+{
+
+   bool      RetStatus = false;
+   int32     SysStatus;
+   int32     ReadLen;
+   osal_id_t FileHandle;
+   os_err_name_t OsErrStr;
+
+   JSON_STREAM_Start(JsonStream, Filename, Obj, ObjCnt, ValueFunc, ValueFuncObj);
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      do
+      {
+         ReadLen = OS_read(FileHandle, JsonStream->ReadBuf, JSON_STREAM_READ_LEN);
+      } while (ReadLen > 0 && JSON_STREAM_Parse(JsonStream, JsonStream->ReadBuf, ReadLen));
+
+      OS_close(FileHandle);
+
+      if (ReadLen < 0)
+      {
+         OS_GetErrorName(ReadLen, &OsErrStr);
+         CFE_EVS_SendEvent(JSON_STREAM_FILE_EID, CFE_EVS_EventType_ERROR,
+                           "Error reading JSON file %s. Status = %s", Filename, OsErrStr);
+      }
+      else
+      {
+         RetStatus = JSON_STREAM_End(JsonStream);
+      }
+   }
+   else
+   {
+      OS_GetErrorName(SysStatus, &OsErrStr);
+      CFE_EVS_SendEvent(JSON_STREAM_FILE_EID, CFE_EVS_EventType_ERROR,
+                        "Error opening JSON file %s. Status = %s", Filename, OsErrStr);
+   }
+
+   return RetStatus;
+
+} /* End JSON_STREAM_ProcessFile() */
+
+
+/******************************************************************************
+** Function: JSON_STREAM_Start
+**
+*/
+void JSON_STREAM_Start(JSON_STREAM_Class_t *JsonStream, const char *Name,
+                       CJSON_Obj_t *Obj, size_t ObjCnt,
+                       JSON_STREAM_ValueFunc_t ValueFunc, void *ValueFuncObj)
+{
+
+   size_t i;
+
+   JsonStream->Name         = Name;
+   JsonStream->Obj          = Obj;
+   JsonStream->ObjCnt       = ObjCnt;
+   JsonStream->ValueFunc    = ValueFunc;
+   JsonStream->ValueFuncObj = ValueFuncObj;
+
+   JsonStream->Error      = false;
+   JsonStream->Lex        = LEX_NONE;
+   JsonStream->Expect     = EXPECT_VALUE;
+   JsonStream->Escape     = false;
+   JsonStream->UnicodeCnt = 0;
+   JsonStream->Line       = 1;
+   JsonStream->Depth      = 0;
+   JsonStream->ArrayDepth = 0;
+   JsonStream->PathLen    = 0;
+   JsonStream->Path[0]    = '\0';
+   JsonStream->TokenLen   = 0;
+   JsonStream->ObjLoadCnt = 0;
+   JsonStream->ValueCnt   = 0;
+
+   for (i=0; i < ObjCnt; i++)
+   {
+      Obj[i].Updated = false;
+   }
+
+} /* End JSON_STREAM_Start() */
+
+
+/******************************************************************************
+** Function: AddKey
+**
+** Append the current string token to the key path.
+**
+*/
+static bool AddKey(JSON_STREAM_Class_t *JsonStream)
+{
+
+   bool   RetStatus = false;
+   uint16 Sep = (JsonStream->PathLen > 0) ? 1 : 0;
+
+   if (JsonStream->TokenTruncated ||
+       (JsonStream->PathLen + Sep + JsonStream->TokenLen) >= JSON_STREAM_PATH_LEN)
+   {
+      ParseError(JsonStream, "Key path is too long");
+   }
+   else
+   {
+      if (Sep)
+      {
+         JsonStream->Path[JsonStream->PathLen++] = '.';
+      }
+      memcpy(&JsonStream->Path[JsonStream->PathLen], JsonStream->Token, JsonStream->TokenLen + 1);
+      JsonStream->PathLen += JsonStream->TokenLen;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End AddKey() */
+
+
+/******************************************************************************
+** Function: AddTokenChar
+**
+** Characters past the token buffer are dropped and the token is flagged as
+** truncated. That's only an error if the value is used.
+**
+*/
+static void AddTokenChar(JSON_STREAM_Class_t *JsonStream, char c)
+{
+
+   if (JsonStream->TokenLen < (JSON_STREAM_TOKEN_LEN - 1))
+   {
+      JsonStream->Token[JsonStream->TokenLen++] = c;
+   }
+   else
+   {
+      JsonStream->TokenTruncated = true;
+   }
+
+} /* End AddTokenChar() */
+
+
+/******************************************************************************
+** Function: LoadObj
+**
+** Write a value to a descriptor's table data the same way CJSON does.
+**
+*/
+static bool LoadObj(JSON_STREAM_Class_t *JsonStream, CJSON_Obj_t *Obj, const JSON_STREAM_Value_t *Value)
+{
+
+   bool RetStatus = true;
+
+   if (Value->Truncated)
+   {
+      RetStatus = ParseError(JsonStream, "Value is too long");
+   }
+   else if (Obj->Type == JSONString && Value->Type == JSON_STREAM_STRING)
+   {
+      snprintf((char *)Obj->TblData, Obj->TblDataLen, "%s", Value->Token);
+   }
+   else if (Obj->Type == JSONNumber && Value->Type == JSON_STREAM_NUMBER)
+   {
+      if (Obj->Float)
+      {
+         if (Obj->TblDataLen == sizeof(double))
+         {
+            *(double *)Obj->TblData = Value->Number;
+         }
+         else
+         {
+            *(float *)Obj->TblData = (float)Value->Number;
+         }
+      }
+      else
+      {
+         switch (Obj->TblDataLen)
+         {
+            case 1:  *(uint8 *)Obj->TblData  = (uint8)Value->Number;  break;
+            case 2:  *(uint16 *)Obj->TblData = (uint16)Value->Number; break;
+            default: *(uint32 *)Obj->TblData = (uint32)Value->Number; break;
+         }
+      }
+   }
+   else
+   {
+      RetStatus = ParseError(JsonStream, (Obj->Type == JSONString) ? "Expected a string" : "Expected a number");
+   }
+
+   if (RetStatus && !Obj->Updated)
+   {
+      Obj->Updated = true;
+      JsonStream->ObjLoadCnt++;
+   }
+
+   return RetStatus;
+
+} /* End LoadObj() */
+
+
+/******************************************************************************
+** Function: LoadValue
+**
+** Load a complete scalar into its descriptor or pass it to the value
+** callback.
+**
+*/
+static bool LoadValue(JSON_STREAM_Class_t *JsonStream, int Token)
+{
+
+   bool   RetStatus = true;
+   bool   Matched   = false;
+   char  *NumberEnd;
+   size_t i;
+   int    l;
+   JSON_STREAM_Value_t Value;
+
+   Value.Path      = JsonStream->Path;
+   Value.Index     = JSON_STREAM_NO_INDEX;
+   Value.Token     = JsonStream->Token;
+   Value.Truncated = JsonStream->TokenTruncated;
+   Value.Number    = 0.0;
+
+   if (Token == TOKEN_STRING)
+   {
+      Value.Type = JSON_STREAM_STRING;
+   }
+   else if (strcmp(JsonStream->Token, "true") == 0 || strcmp(JsonStream->Token, "false") == 0 ||
+            strcmp(JsonStream->Token, "null") == 0)
+   {
+      Value.Type = JSON_STREAM_LITERAL;
+   }
+   else
+   {
+      Value.Type   = JSON_STREAM_NUMBER;
+      Value.Number = strtod(JsonStream->Token, &NumberEnd);
+      if (Value.Truncated || NumberEnd == JsonStream->Token || *NumberEnd != '\0')
+      {
+         RetStatus = ParseError(JsonStream, "Invalid number or literal");
+      }
+   }
+
+   if (RetStatus)
+   {
+
+      JsonStream->ValueCnt++;
+
+      if (JsonStream->ArrayDepth == 0)
+      {
+         for (i=0; i < JsonStream->ObjCnt && !Matched; i++)
+         {
+            if (JsonStream->Obj[i].Query.KeyLen == JsonStream->PathLen &&
+                memcmp(JsonStream->Obj[i].Query.Key, JsonStream->Path, JsonStream->PathLen) == 0)
+            {
+               Matched   = true;
+               RetStatus = LoadObj(JsonStream, &JsonStream->Obj[i], &Value);
+            }
+         }
+      }
+      else
+      {
+         for (l=JsonStream->Depth-1; Value.Index == JSON_STREAM_NO_INDEX; l--)
+         {
+            if (JsonStream->Level[l].Type == LEVEL_ARRAY)
+            {
+               Value.Index = JsonStream->Level[l].Index;
+            }
+         }
+      }
+
+      if (!Matched && JsonStream->ValueFunc != NULL)
+      {
+         if (!(JsonStream->ValueFunc)(JsonStream->ValueFuncObj, &Value))
+         {
+            RetStatus = ParseError(JsonStream, "Value rejected");
+         }
+      }
+   }
+
+   return RetStatus;
+
+} /* End LoadValue() */
+
+
+/******************************************************************************
+** Function: ParseChar
+**
+*/
+static bool ParseChar(JSON_STREAM_Class_t *JsonStream, char c)
+{
+
+   bool RetStatus = true;
+
+   if (JsonStream->Lex == LEX_STRING)
+   {
+      if (JsonStream->UnicodeCnt > 0)
+      {
+         JsonStream->UnicodeCnt--;
+      }
+      else if (JsonStream->Escape)
+      {
+         JsonStream->Escape = false;
+         switch (c)
+         {
+            case 'b': AddTokenChar(JsonStream, '\b'); break;
+            case 'f': AddTokenChar(JsonStream, '\f'); break;
+            case 'n': AddTokenChar(JsonStream, '\n'); break;
+            case 'r': AddTokenChar(JsonStream, '\r'); break;
+            case 't': AddTokenChar(JsonStream, '\t'); break;
+            case 'u':
+               AddTokenChar(JsonStream, '?');
+               JsonStream->UnicodeCnt = 4;
+               break;
+            case '"':
+            case '\\':
+            case '/':
+               AddTokenChar(JsonStream, c);
+               break;
+            default:
+               RetStatus = ParseError(JsonStream, "Invalid string escape");
+         }
+      }
+      else if (c == '\\')
+      {
+         JsonStream->Escape = true;
+      }
+      else if (c == '"')
+      {
+         JsonStream->Lex = LEX_NONE;
+         JsonStream->Token[JsonStream->TokenLen] = '\0';
+         RetStatus = ProcessToken(JsonStream, TOKEN_STRING);
+      }
+      else if ((uint8)c < 0x20)
+      {
+         RetStatus = ParseError(JsonStream, "Control character in string");
+      }
+      else
+      {
+         AddTokenChar(JsonStream, c);
+      }
+   }
+   else
+   {
+
+      if (JsonStream->Lex == LEX_SCALAR && IS_SCALAR_CHAR(c))
+      {
+         AddTokenChar(JsonStream, c);
+      }
+      else
+      {
+
+         /* Any other character ends a number or literal and is then processed */
+         if (JsonStream->Lex == LEX_SCALAR)
+         {
+            JsonStream->Lex = LEX_NONE;
+            JsonStream->Token[JsonStream->TokenLen] = '\0';
+            RetStatus = ProcessToken(JsonStream, TOKEN_SCALAR);
+         }
+
+         if (RetStatus)
+         {
+            switch (c)
+            {
+               case '\n':
+                  JsonStream->Line++;
+                  break;
+               case ' ':
+               case '\t':
+               case '\r':
+                  break;
+               case '{':
+               case '}':
+               case '[':
+               case ']':
+               case ':':
+               case ',':
+                  RetStatus = ProcessToken(JsonStream, c);
+                  break;
+               case '"':
+                  JsonStream->Lex = LEX_STRING;
+                  JsonStream->TokenLen = 0;
+                  JsonStream->TokenTruncated = false;
+                  break;
+               default:
+                  if (IS_SCALAR_CHAR(c))
+                  {
+                     JsonStream->Lex = LEX_SCALAR;
+                     JsonStream->TokenLen = 0;
+                     JsonStream->TokenTruncated = false;
+                     AddTokenChar(JsonStream, c);
+                  }
+                  else
+                  {
+                     RetStatus = ParseError(JsonStream, "Unexpected character");
+                  }
+            } /* End switch */
+         }
+      } /* End if not continuing a number or literal */
+   } /* End if not in a string */
+
+   return RetStatus;
+
+} /* End ParseChar() */
+
+
+/******************************************************************************
+** Function: ParseError
+**
+** Report the first error in a parse. Always returns false.
+**
+*/
+static bool ParseError(JSON_STREAM_Class_t *JsonStream, const char *Error)
+{
+
+   if (!JsonStream->Error)
+   {
+      JsonStream->Error = true;
+      CFE_EVS_SendEvent(JSON_STREAM_PARSE_EID, CFE_EVS_EventType_ERROR,
+                        "%s line %u, key '%s': %s", JsonStream->Name, (unsigned int)JsonStream->Line,
+                        JsonStream->Path, Error);
+   }
+
+   return false;
+
+} /* End ParseError() */
+
+
+/******************************************************************************
+** Function: PopLevel
+**
+** Close the innermost container and restore the path it was opened with.
+**
+*/
+static void PopLevel(JSON_STREAM_Class_t *JsonStream)
+{
+
+   JSON_STREAM_Level_t *Level = &JsonStream->Level[--JsonStream->Depth];
+
+   if (Level->Type == LEVEL_ARRAY)
+   {
+      JsonStream->ArrayDepth--;
+   }
+   JsonStream->PathLen = Level->PathLen;
+   JsonStream->Path[JsonStream->PathLen] = '\0';
+
+} /* End PopLevel() */
+
+
+/******************************************************************************
+** Function: ProcessToken
+**
+*/
+static bool ProcessToken(JSON_STREAM_Class_t *JsonStream, int Token)
+{
+
+   bool RetStatus = true;
+   JSON_STREAM_Level_t *Level = (JsonStream->Depth > 0) ? &JsonStream->Level[JsonStream->Depth-1] : NULL;
+
+   switch (JsonStream->Expect)
+   {
+
+      case EXPECT_VALUE:
+      case EXPECT_VALUE_OR_END:
+         if (Token == '{')
+         {
+            RetStatus = PushLevel(JsonStream, LEVEL_OBJECT);
+         }
+         else if (Token == '[')
+         {
+            RetStatus = PushLevel(JsonStream, LEVEL_ARRAY);
+         }
+         else if (Token == TOKEN_STRING || Token == TOKEN_SCALAR)
+         {
+            RetStatus = LoadValue(JsonStream, Token);
+            ValueDone(JsonStream);
+         }
+         else if (Token == ']' && JsonStream->Expect == EXPECT_VALUE_OR_END)
+         {
+            PopLevel(JsonStream);
+            ValueDone(JsonStream);
+         }
+         else
+         {
+            RetStatus = ParseError(JsonStream, "Expected a value");
+         }
+         break;
+
+      case EXPECT_KEY:
+      case EXPECT_KEY_OR_END:
+         if (Token == TOKEN_STRING)
+         {
+            RetStatus = AddKey(JsonStream);
+            JsonStream->Expect = EXPECT_COLON;
+         }
+         else if (Token == '}' && JsonStream->Expect == EXPECT_KEY_OR_END)
+         {
+            PopLevel(JsonStream);
+            ValueDone(JsonStream);
+         }
+         else
+         {
+            RetStatus = ParseError(JsonStream, "Expected a key");
+         }
+         break;
+
+      case EXPECT_COLON:
+         if (Token == ':')
+         {
+            JsonStream->Expect = EXPECT_VALUE;
+         }
+         else
+         {
+            RetStatus = ParseError(JsonStream, "Expected ':'");
+         }
+         break;
+
+      case EXPECT_COMMA_OR_END:
+         if (Token == ',')
+         {
+            if (Level->Type == LEVEL_OBJECT)
+            {
+               JsonStream->Expect = EXPECT_KEY;
+            }
+            else
+            {
+               Level->Index++;
+               JsonStream->Expect = EXPECT_VALUE;
+            }
+         }
+         else if ((Token == '}' && Level->Type == LEVEL_OBJECT) ||
+                  (Token == ']' && Level->Type == LEVEL_ARRAY))
+         {
+            PopLevel(JsonStream);
+            ValueDone(JsonStream);
+         }
+         else
+         {
+            RetStatus = ParseError(JsonStream, (Level->Type == LEVEL_OBJECT) ? "Expected ',' or '}'" : "Expected ',' or ']'");
+         }
+         break;
+
+      default:
+         RetStatus = ParseError(JsonStream, "Unexpected data after the end of the top level value");
+         break;
+
+   } /* End Expect switch */
+
+   return RetStatus;
+
+} /* End ProcessToken() */
+
+
+/******************************************************************************
+** Function: PushLevel
+**
+*/
+static bool PushLevel(JSON_STREAM_Class_t *JsonStream, uint8 Type)
+{
+
+   bool RetStatus = false;
+   JSON_STREAM_Level_t *Level;
+
+   if (JsonStream->Depth < JSON_STREAM_DEPTH_MAX)
+   {
+      Level = &JsonStream->Level[JsonStream->Depth++];
+      Level->Type    = Type;
+      Level->PathLen = JsonStream->PathLen;
+      Level->Index   = 0;
+
+      if (Type == LEVEL_ARRAY)
+      {
+         JsonStream->ArrayDepth++;
+         JsonStream->Expect = EXPECT_VALUE_OR_END;
+      }
+      else
+      {
+         JsonStream->Expect = EXPECT_KEY_OR_END;
+      }
+      RetStatus = true;
+   }
+   else
+   {
+      ParseError(JsonStream, "Containers are nested too deeply");
+   }
+
+   return RetStatus;
+
+} /* End PushLevel() */
+
+
+/******************************************************************************
+** Function: ValueDone
+**
+** Remove an object member's key from the path once its value is complete.
+**
+*/
+static void ValueDone(JSON_STREAM_Class_t *JsonStream)
+{
+
+   const JSON_STREAM_Level_t *Level;
+
+   if (JsonStream->Depth == 0)
+   {
+      JsonStream->Expect = EXPECT_NOTHING;
+   }
+   else
+   {
+      Level = &JsonStream->Level[JsonStream->Depth-1];
+      if (Level->Type == LEVEL_OBJECT)
+      {
+         JsonStream->PathLen = Level->PathLen;
+         JsonStream->Path[JsonStream->PathLen] = '\0';
+      }
+      JsonStream->Expect = EXPECT_COMMA_OR_END;
+   }
+
+} /* End ValueDone() */
@@ -0,0 +1,210 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Incremental JSON parser that loads table data while a file is read
+**
+**  Notes:
+**    1. The parser is fed a file in small pieces and never holds more than
+**       one key path and one string or number token, so table files of any
+**       size are loaded in bounded memory. Memory use is set by the
+**       JSON_STREAM configurations in app_cfg.h.
+**    2. Values are addressed by their dotted key path, e.g. "kp.x", the same
+**       query strings used by the app_c_fw CJSON object descriptors. Array
+**       elements share their array's path and are identified by their index
+**       within the innermost enclosing array.
+**    3. A scalar value outside of any array whose path matches a CJSON_Obj_t
+**       descriptor is written to the descriptor's table data. Every other
+**       value, including all array elements, is passed to the optional value
+**       callback so a table can load variable length data such as a gain
+**       schedule.
+**    4. The first syntax error, descriptor type mismatch or callback failure
+**       stops the parse and is reported with an event that includes the line
+**       number and key path.
+**
+*/
+#ifndef _json_stream_
+#define _json_stream_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define JSON_STREAM_NO_INDEX  0xFFFFFFFF   /* Value isn't an array element */
+
+
+/*
+** Event Message IDs
+*/
+
+#define JSON_STREAM_FILE_EID   (JSON_STREAM_BASE_EID + 0)
+#define JSON_STREAM_PARSE_EID  (JSON_STREAM_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   JSON_STREAM_STRING  = 0,
+   JSON_STREAM_NUMBER  = 1,
+   JSON_STREAM_LITERAL = 2     /* true, false or null */
+
+} JSON_STREAM_ValType_t;
+
+typedef struct
+{
+
+   const char  *Path;          /* Dotted key path, null terminated */
+   uint32       Index;         /* Index in the innermost array or JSON_STREAM_NO_INDEX */
+   JSON_STREAM_ValType_t  Type;
+   const char  *Token;         /* String contents or number/literal text, null terminated */
+   bool         Truncated;     /* Token exceeded JSON_STREAM_TOKEN_LEN-1 characters */
+   double       Number;        /* Valid for JSON_STREAM_NUMBER */
+
+} JSON_STREAM_Value_t;
+
+/*
+** Value callback. Return false to reject the value and stop the parse. The
+** parser reports the line and path, the callback should report why.
+*/
+typedef bool (*JSON_STREAM_ValueFunc_t)(void *ValueFuncObj, const JSON_STREAM_Value_t *Value);
+
+typedef struct
+{
+
+   uint8   Type;               /* Object or array */
+   uint16  PathLen;            /* Path length when the container was opened */
+   uint32  Index;              /* Current element, arrays only */
+
+} JSON_STREAM_Level_t;
+
+
+/******************************************************************************
+** JSON_STREAM Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Load definition
+   */
+
+   const char   *Name;         /* Used in event messages, typically the filename */
+   CJSON_Obj_t  *Obj;
+   size_t        ObjCnt;
+   JSON_STREAM_ValueFunc_t  ValueFunc;
+   void         *ValueFuncObj;
+
+   /*
+   ** Parser state
+   */
+
+   bool    Error;
+   uint8   Lex;
+   uint8   Expect;
+   bool    Escape;
+   uint8   UnicodeCnt;         /* Hex digits of a \u escape still to skip */
+   uint32  Line;
+
+   uint16  Depth;
+   uint16  ArrayDepth;
+   JSON_STREAM_Level_t  Level[JSON_STREAM_DEPTH_MAX];
+
+   uint16  PathLen;
+   char    Path[JSON_STREAM_PATH_LEN];
+
+   uint16  TokenLen;
+   bool    TokenTruncated;
+   char    Token[JSON_STREAM_TOKEN_LEN];
+
+   /*
+   ** Results
+   */
+
+   size_t  ObjLoadCnt;         /* Descriptors updated */
+   uint32  ValueCnt;           /* Scalar values parsed */
+
+   char    ReadBuf[JSON_STREAM_READ_LEN];
+
+} JSON_STREAM_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: JSON_STREAM_End
+**
+** Finish a parse started by JSON_STREAM_Start(). Returns true if the input
+** was one complete JSON value and every value was accepted.
+**
+*/
+bool JSON_STREAM_End(JSON_STREAM_Class_t *JsonStream);
+
+
+/******************************************************************************
+** Function: JSON_STREAM_Parse
+**
+** Parse the next BufLen characters of the input. Returns false once an
+** error has been found, after which further input is ignored.
+**
+*/
+bool JSON_STREAM_Parse(JSON_STREAM_Class_t *JsonStream, const char *Buf, size_t BufLen);
+
+
+/******************************************************************************
+** Function: JSON_STREAM_ProcessFile
+**
+** Parse a file read JSON_STREAM_READ_LEN bytes at a time. Returns true if
+** the file was read and parsed without an error.
+**
+** Notes:
+**   1. Obj and ValueFunc are the same as JSON_STREAM_Start(). The number of
+**      descriptors loaded is in JsonStream->ObjLoadCnt.
+**
+*/
+bool JSON_STREAM_ProcessFile(JSON_STREAM_Class_t *JsonStream, const char *Filename,
+                             CJSON_Obj_t *Obj, size_t ObjCnt,
+                             JSON_STREAM_ValueFunc_t ValueFunc, void *ValueFuncObj);
+
+
+/******************************************************************************
+** Function: JSON_STREAM_Start
+**
+** Start a new parse.
+**
+** Notes:
+**   1. Every descriptor's Updated flag is cleared. ObjCnt may be zero and
+**      ValueFunc may be NULL.
+**
+*/
+void JSON_STREAM_Start(JSON_STREAM_Class_t *JsonStream, const char *Name,
+                       CJSON_Obj_t *Obj, size_t ObjCnt,
+                       JSON_STREAM_ValueFunc_t ValueFunc, void *ValueFuncObj);
+
+
+#endif /* _json_stream_ */
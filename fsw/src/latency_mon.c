@@ -0,0 +1,216 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the sensor-to-actuator latency monitor
+**
+**  Notes:
+**    1. LATENCY_MON_AddSample() runs every control cycle so it only does
+**       O(1) integer work. Statistics are derived when telemetry is sent.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "latency_mon.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LATENCY_PERCENTILE  99
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   ResetStats(LATENCY_MON_Class_t *LatencyMon);
+static uint32 Percentile(const LATENCY_MON_Class_t *LatencyMon, uint32 Percent);
+
+
+/******************************************************************************
+** Function: LATENCY_MON_Constructor
+**
+*/
+void LATENCY_MON_Constructor(LATENCY_MON_Class_t *LatencyMon, uint32 BinWidth,
+                             CFE_SB_MsgId_t LatencyTlmMid)
+{
+
+   CFE_PSP_MemSet((void*)LatencyMon, 0, sizeof(LATENCY_MON_Class_t));
+
+   LatencyMon->BinWidth = (BinWidth > 0) ? BinWidth : 1;
+   ResetStats(LatencyMon);
+
+   CFE_MSG_Init(CFE_MSG_PTR(LatencyMon->LatencyTlm.TelemetryHeader), LatencyTlmMid,
+                sizeof(BC42_CTRL_LatencyTlm_t));
+
+} /* End LATENCY_MON_Constructor() */
+
+
+/******************************************************************************
+** Function: LATENCY_MON_AddSample
+**
+*/
+void LATENCY_MON_AddSample(LATENCY_MON_Class_t *LatencyMon,
+                           CFE_TIME_SysTime_t SensorTime,
+                           CFE_TIME_SysTime_t ActuatorTime)
+{
+
+   CFE_TIME_SysTime_t DeltaTime;
+   uint64  Latency;
+   uint32  BinIdx;
+
+   if (CFE_TIME_Compare(ActuatorTime, SensorTime) == CFE_TIME_A_LT_B)
+   {
+      LatencyMon->InvalidCnt++;
+   }
+   else
+   {
+
+      DeltaTime = CFE_TIME_Subtract(ActuatorTime, SensorTime);
+      Latency   = (uint64)DeltaTime.Seconds * 1000000 + CFE_TIME_Sub2MicroSecs(DeltaTime.Subseconds);
+      if (Latency > UINT32_MAX)
+      {
+         Latency = UINT32_MAX;
+      }
+
+      LatencyMon->SampleCnt++;
+      LatencyMon->LatencySum += Latency;
+
+      if (Latency < LatencyMon->MinLatency) LatencyMon->MinLatency = Latency;
+      if (Latency > LatencyMon->MaxLatency) LatencyMon->MaxLatency = Latency;
+
+      BinIdx = Latency / LatencyMon->BinWidth;
+      if (BinIdx >= LATENCY_MON_BIN_CNT)
+      {
+         BinIdx = LATENCY_MON_BIN_CNT - 1;
+      }
+      LatencyMon->Bin[BinIdx]++;
+
+   } /* End if valid times */
+
+} /* End LATENCY_MON_AddSample() */
+
+
+/******************************************************************************
+** Function: LATENCY_MON_ResetCmd
+**
+*/
+bool LATENCY_MON_ResetCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   LATENCY_MON_Class_t *LatencyMon = (LATENCY_MON_Class_t *)ObjDataPtr;
+
+   ResetStats(LatencyMon);
+
+   CFE_EVS_SendEvent(LATENCY_MON_RESET_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                     "Sensor-to-actuator latency statistics reset");
+
+   return true;
+
+} /* End LATENCY_MON_ResetCmd() */
+
+
+/******************************************************************************
+** Function: LATENCY_MON_SendTlm
+**
+*/
+void LATENCY_MON_SendTlm(LATENCY_MON_Class_t *LatencyMon)
+{
+
+   BC42_CTRL_LatencyTlm_Payload_t *Payload = &LatencyMon->LatencyTlm.Payload;
+
+   Payload->SampleCnt  = LatencyMon->SampleCnt;
+   Payload->InvalidCnt = LatencyMon->InvalidCnt;
+   Payload->BinWidth   = LatencyMon->BinWidth;
+
+   if (LatencyMon->SampleCnt > 0)
+   {
+      Payload->Min  = LatencyMon->MinLatency;
+      Payload->Max  = LatencyMon->MaxLatency;
+      Payload->Mean = (uint32)(LatencyMon->LatencySum / LatencyMon->SampleCnt);
+      Payload->P99  = Percentile(LatencyMon, LATENCY_PERCENTILE);
+   }
+   else
+   {
+      Payload->Min  = 0;
+      Payload->Max  = 0;
+      Payload->Mean = 0;
+      Payload->P99  = 0;
+   }
+
+   memcpy(Payload->Bin, LatencyMon->Bin, sizeof(Payload->Bin));
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(LatencyMon->LatencyTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(LatencyMon->LatencyTlm.TelemetryHeader), true);
+
+} /* End LATENCY_MON_SendTlm() */
+
+
+/******************************************************************************
+** Function: Percentile
+**
+** Return the upper edge of the bin that contains the requested percentile.
+**
+** Notes:
+**   1. The overflow bin has no upper edge so the max latency is used. The
+**      max is also used when it's lower than the bin edge.
+**   2. Assumes at least one sample has been recorded.
+*/
+static uint32 Percentile(const LATENCY_MON_Class_t *LatencyMon, uint32 Percent)
+{
+
+   uint32 i;
+   uint64 Target;
+   uint64 CumulativeCnt = 0;
+   uint64 BinEdge = LatencyMon->MaxLatency;
+
+   /* Rank of the percentile sample, rounded up */
+   Target = ((uint64)LatencyMon->SampleCnt * Percent + 99) / 100;
+
+   for (i=0; i < (LATENCY_MON_BIN_CNT-1); i++)
+   {
+      CumulativeCnt += LatencyMon->Bin[i];
+      if (CumulativeCnt >= Target)
+      {
+         BinEdge = (uint64)(i+1) * LatencyMon->BinWidth;
+         break;
+      }
+   }
+
+   return (BinEdge < LatencyMon->MaxLatency) ? (uint32)BinEdge : LatencyMon->MaxLatency;
+
+} /* End Percentile() */
+
+
+/******************************************************************************
+** Function: ResetStats
+**
+*/
+static void ResetStats(LATENCY_MON_Class_t *LatencyMon)
+{
+
+   LatencyMon->SampleCnt  = 0;
+   LatencyMon->InvalidCnt = 0;
+   LatencyMon->MinLatency = UINT32_MAX;
+   LatencyMon->MaxLatency = 0;
+   LatencyMon->LatencySum = 0;
+   memset(LatencyMon->Bin, 0, sizeof(LatencyMon->Bin));
+
+} /* End ResetStats() */
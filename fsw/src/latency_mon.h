@@ -0,0 +1,130 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Monitor the sensor-to-actuator latency of the control loop
+**
+**  Notes:
+**    1. Latency is measured from the time BC42_INTF stamped a sensor data
+**       message to the time the actuator command computed from it is
+**       stamped for transmission. Both times come from cFE TIME so they
+**       share a time base.
+**    2. Samples are accumulated in a fixed-width bin histogram. The last
+**       bin collects all samples beyond the histogram range. Percentiles
+**       are resolved to a bin's upper edge.
+**
+*/
+#ifndef _latency_mon_
+#define _latency_mon_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/*
+** Event Message IDs
+*/
+
+#define LATENCY_MON_RESET_CMD_EID  (LATENCY_MON_BASE_EID + 0)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** LATENCY_MON Class
+*/
+
+typedef struct
+{
+
+   uint32  BinWidth;           /* Microseconds */
+
+   uint32  SampleCnt;
+   uint32  InvalidCnt;         /* Actuator time preceded sensor time */
+   uint32  MinLatency;         /* Microseconds */
+   uint32  MaxLatency;         /* Microseconds */
+   uint64  LatencySum;         /* Microseconds */
+   uint32  Bin[LATENCY_MON_BIN_CNT];
+
+   BC42_CTRL_LatencyTlm_t  LatencyTlm;
+
+} LATENCY_MON_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: LATENCY_MON_Constructor
+**
+** Initialize a LATENCY_MON object.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void LATENCY_MON_Constructor(LATENCY_MON_Class_t *LatencyMon, uint32 BinWidth,
+                             CFE_SB_MsgId_t LatencyTlmMid);
+
+
+/******************************************************************************
+** Function: LATENCY_MON_AddSample
+**
+** Add one sensor-to-actuator latency sample.
+**
+*/
+void LATENCY_MON_AddSample(LATENCY_MON_Class_t *LatencyMon,
+                           CFE_TIME_SysTime_t SensorTime,
+                           CFE_TIME_SysTime_t ActuatorTime);
+
+
+/******************************************************************************
+** Function: LATENCY_MON_ResetCmd
+**
+** Clear the latency statistics and histogram.
+**
+*/
+bool LATENCY_MON_ResetCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: LATENCY_MON_SendTlm
+**
+*/
+void LATENCY_MON_SendTlm(LATENCY_MON_Class_t *LatencyMon);
+
+
+#endif /* _latency_mon_ */
@@ -0,0 +1,44 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the monotonic high-resolution clock
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <time.h>
+#include "mono_time.h"
+
+
+/******************************************************************************
+** Function: MONO_TIME_GetNs
+**
+*/
+uint64 MONO_TIME_GetNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return ((uint64)Now.tv_sec * 1000000000 + (uint64)Now.tv_nsec);
+
+} /* End MONO_TIME_GetNs() */
@@ -0,0 +1,49 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Provide a monotonic high-resolution clock for execution timing
+**
+**  Notes:
+**    1. cFE TIME and OS_GetLocalTime() can be adjusted while the app runs
+**       so they can't be used to measure short intervals. This app runs
+**       with 42 on POSIX hosts so the POSIX monotonic clock is used.
+**    2. Only differences between two readings are meaningful.
+**
+*/
+#ifndef _mono_time_
+#define _mono_time_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: MONO_TIME_GetNs
+**
+** Return the monotonic clock time in nanoseconds.
+**
+*/
+uint64 MONO_TIME_GetNs(void);
+
+
+#endif /* _mono_time_ */
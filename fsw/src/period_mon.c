@@ -0,0 +1,253 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the control period monitor
+**
+**  Notes:
+**    1. The least severe worst event is tracked so a cycle that doesn't
+**       qualify costs one compare. The list is only scanned when an
+**       event is replaced.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "period_mon.h"
+#include "mono_time.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   AddPeriod(PERIOD_MON_Class_t *PeriodMon, uint32 Period);
+static void   AddWorstEvent(PERIOD_MON_Class_t *PeriodMon, uint32 Period, int32 Jitter);
+static uint32 AbsJitter(int32 Jitter);
+
+
+/******************************************************************************
+** Function: PERIOD_MON_Constructor
+**
+*/
+void PERIOD_MON_Constructor(PERIOD_MON_Class_t *PeriodMon, uint32 NominalPeriod,
+                            CFE_SB_MsgId_t PeriodTlmMid)
+{
+
+   CFE_PSP_MemSet((void*)PeriodMon, 0, sizeof(PERIOD_MON_Class_t));
+
+   PeriodMon->NominalPeriod = (NominalPeriod > 0) ? NominalPeriod : 1;
+   PERIOD_MON_ResetStatus(PeriodMon);
+
+   CFE_MSG_Init(CFE_MSG_PTR(PeriodMon->PeriodTlm.TelemetryHeader), PeriodTlmMid,
+                sizeof(BC42_CTRL_PeriodTlm_t));
+
+} /* End PERIOD_MON_Constructor() */
+
+
+/******************************************************************************
+** Function: PERIOD_MON_EndCycle
+**
+*/
+void PERIOD_MON_EndCycle(PERIOD_MON_Class_t *PeriodMon)
+{
+
+   uint64 ExeTime = (MONO_TIME_GetNs() - PeriodMon->CycleStart) / 1000;
+
+   PeriodMon->ExeTime = (ExeTime > UINT32_MAX) ? UINT32_MAX : (uint32)ExeTime;
+
+   if (PeriodMon->ExeTime > PeriodMon->NominalPeriod)
+   {
+      PeriodMon->OverrunCnt++;
+   }
+
+} /* End PERIOD_MON_EndCycle() */
+
+
+/******************************************************************************
+** Function: PERIOD_MON_ResetStatus
+**
+*/
+void PERIOD_MON_ResetStatus(PERIOD_MON_Class_t *PeriodMon)
+{
+
+   PeriodMon->CycleStarted   = false;
+   PeriodMon->ExeTime        = 0;
+   PeriodMon->PeriodCnt      = 0;
+   PeriodMon->MinPeriod      = UINT32_MAX;
+   PeriodMon->MaxPeriod      = 0;
+   PeriodMon->PeriodSum      = 0;
+   PeriodMon->MaxJitter      = 0;
+   PeriodMon->OverrunCnt     = 0;
+   PeriodMon->MissedCycleCnt = 0;
+   PeriodMon->WorstCnt       = 0;
+   PeriodMon->LeastWorstIdx  = 0;
+   memset(PeriodMon->Worst, 0, sizeof(PeriodMon->Worst));
+
+} /* End PERIOD_MON_ResetStatus() */
+
+
+/******************************************************************************
+** Function: PERIOD_MON_SendTlm
+**
+*/
+void PERIOD_MON_SendTlm(PERIOD_MON_Class_t *PeriodMon)
+{
+
+   BC42_CTRL_PeriodTlm_Payload_t *Payload = &PeriodMon->PeriodTlm.Payload;
+
+   Payload->NominalPeriod  = PeriodMon->NominalPeriod;
+   Payload->PeriodCnt      = PeriodMon->PeriodCnt;
+   Payload->MaxJitter      = PeriodMon->MaxJitter;
+   Payload->OverrunCnt     = PeriodMon->OverrunCnt;
+   Payload->MissedCycleCnt = PeriodMon->MissedCycleCnt;
+   Payload->WorstCnt       = PeriodMon->WorstCnt;
+
+   if (PeriodMon->PeriodCnt > 0)
+   {
+      Payload->MinPeriod  = PeriodMon->MinPeriod;
+      Payload->MaxPeriod  = PeriodMon->MaxPeriod;
+      Payload->MeanPeriod = (uint32)(PeriodMon->PeriodSum / PeriodMon->PeriodCnt);
+   }
+   else
+   {
+      Payload->MinPeriod  = 0;
+      Payload->MaxPeriod  = 0;
+      Payload->MeanPeriod = 0;
+   }
+
+   memcpy(Payload->Worst, PeriodMon->Worst, sizeof(Payload->Worst));
+
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(PeriodMon->PeriodTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(PeriodMon->PeriodTlm.TelemetryHeader), true);
+
+} /* End PERIOD_MON_SendTlm() */
+
+
+/******************************************************************************
+** Function: PERIOD_MON_StartCycle
+**
+*/
+void PERIOD_MON_StartCycle(PERIOD_MON_Class_t *PeriodMon)
+{
+
+   uint64 CycleStart = MONO_TIME_GetNs();
+   uint64 Period;
+
+   if (PeriodMon->CycleStarted)
+   {
+      Period = (CycleStart - PeriodMon->CycleStart) / 1000;
+      AddPeriod(PeriodMon, (Period > UINT32_MAX) ? UINT32_MAX : (uint32)Period);
+   }
+
+   PeriodMon->CycleStart   = CycleStart;
+   PeriodMon->CycleStarted = true;
+
+} /* End PERIOD_MON_StartCycle() */
+
+
+/******************************************************************************
+** Function: AbsJitter
+**
+*/
+static uint32 AbsJitter(int32 Jitter)
+{
+
+   return (Jitter < 0) ? (uint32)(-(int64)Jitter) : (uint32)Jitter;
+
+} /* End AbsJitter() */
+
+
+/******************************************************************************
+** Function: AddPeriod
+**
+*/
+static void AddPeriod(PERIOD_MON_Class_t *PeriodMon, uint32 Period)
+{
+
+   int64   Delta  = (int64)Period - (int64)PeriodMon->NominalPeriod;
+   int32   Jitter;
+   uint32  HalfPeriods;
+
+   if (Delta > INT32_MAX) Delta = INT32_MAX;
+   if (Delta < INT32_MIN) Delta = INT32_MIN;
+   Jitter = (int32)Delta;
+
+   PeriodMon->PeriodCnt++;
+   PeriodMon->PeriodSum += Period;
+   if (Period < PeriodMon->MinPeriod) PeriodMon->MinPeriod = Period;
+   if (Period > PeriodMon->MaxPeriod) PeriodMon->MaxPeriod = Period;
+   if (AbsJitter(Jitter) > PeriodMon->MaxJitter) PeriodMon->MaxJitter = AbsJitter(Jitter);
+
+   /* Count missed cycles when at least 1.5 nominal periods elapsed */
+   HalfPeriods = (uint32)(((uint64)Period * 2) / PeriodMon->NominalPeriod);
+   if (HalfPeriods >= 3)
+   {
+      PeriodMon->MissedCycleCnt += ((HalfPeriods + 1) / 2) - 1;
+   }
+
+   if (PeriodMon->WorstCnt < PERIOD_MON_WORST_CNT ||
+       AbsJitter(Jitter) > AbsJitter(PeriodMon->Worst[PeriodMon->LeastWorstIdx].Jitter))
+   {
+      AddWorstEvent(PeriodMon, Period, Jitter);
+   }
+
+} /* End AddPeriod() */
+
+
+/******************************************************************************
+** Function: AddWorstEvent
+**
+** Notes:
+**   1. Replaces the least severe event once the list is full and updates
+**      LeastWorstIdx.
+*/
+static void AddWorstEvent(PERIOD_MON_Class_t *PeriodMon, uint32 Period, int32 Jitter)
+{
+
+   uint32 i;
+   uint32 EventIdx;
+   BC42_CTRL_PeriodEvent_t *Event;
+   CFE_TIME_SysTime_t EventTime = CFE_TIME_GetTime();
+
+   if (PeriodMon->WorstCnt < PERIOD_MON_WORST_CNT)
+   {
+      EventIdx = PeriodMon->WorstCnt++;
+   }
+   else
+   {
+      EventIdx = PeriodMon->LeastWorstIdx;
+   }
+
+   Event = &PeriodMon->Worst[EventIdx];
+   Event->Seconds     = EventTime.Seconds;
+   Event->Subseconds  = EventTime.Subseconds;
+   Event->Period      = Period;
+   Event->Jitter      = Jitter;
+   Event->PrevExeTime = PeriodMon->ExeTime;
+
+   PeriodMon->LeastWorstIdx = 0;
+   for (i=1; i < PeriodMon->WorstCnt; i++)
+   {
+      if (AbsJitter(PeriodMon->Worst[i].Jitter) <
+          AbsJitter(PeriodMon->Worst[PeriodMon->LeastWorstIdx].Jitter))
+      {
+         PeriodMon->LeastWorstIdx = i;
+      }
+   }
+
+} /* End AddWorstEvent() */
@@ -0,0 +1,144 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Monitor the control period against its nominal value
+**
+**  Notes:
+**    1. The period is the monotonic time between the starts of consecutive
+**       control cycles. Jitter is the period minus the nominal period.
+**    2. An overrun is a control cycle whose execution time exceeds the
+**       nominal period. A period of at least 1.5 nominal periods is
+**       counted as missing round(period/nominal)-1 cycles.
+**    3. The worst events are the cycles with the largest absolute jitter.
+**       Each event records the execution time of the preceding cycle so
+**       a long period caused by a slow control law can be told apart
+**       from one caused by late scheduling.
+**
+*/
+#ifndef _period_mon_
+#define _period_mon_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** PERIOD_MON Class
+*/
+
+typedef struct
+{
+
+   uint32  NominalPeriod;      /* Microseconds */
+
+   bool    CycleStarted;       /* A previous cycle start is available */
+   uint64  CycleStart;         /* Nanoseconds */
+   uint32  ExeTime;            /* Microseconds, most recent cycle */
+
+   uint32  PeriodCnt;
+   uint32  MinPeriod;          /* Microseconds */
+   uint32  MaxPeriod;          /* Microseconds */
+   uint64  PeriodSum;          /* Microseconds */
+   uint32  MaxJitter;          /* Microseconds, absolute value */
+   uint32  OverrunCnt;
+   uint32  MissedCycleCnt;
+
+   uint32  WorstCnt;           /* Number of valid Worst[] entries */
+   uint32  LeastWorstIdx;      /* Entry replaced by the next worse event */
+   BC42_CTRL_PeriodEvent_t  Worst[PERIOD_MON_WORST_CNT];
+
+   BC42_CTRL_PeriodTlm_t  PeriodTlm;
+
+} PERIOD_MON_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PERIOD_MON_Constructor
+**
+** Initialize a PERIOD_MON object.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void PERIOD_MON_Constructor(PERIOD_MON_Class_t *PeriodMon, uint32 NominalPeriod,
+                            CFE_SB_MsgId_t PeriodTlmMid);
+
+
+/******************************************************************************
+** Function: PERIOD_MON_EndCycle
+**
+** Record the execution time of the cycle started by PERIOD_MON_StartCycle().
+**
+*/
+void PERIOD_MON_EndCycle(PERIOD_MON_Class_t *PeriodMon);
+
+
+/******************************************************************************
+** Function: PERIOD_MON_ResetStatus
+**
+** Clear the period statistics and worst events.
+**
+** Notes:
+**   1. The next cycle start doesn't produce a period so the time spent
+**      between the reset and the next cycle isn't counted.
+*/
+void PERIOD_MON_ResetStatus(PERIOD_MON_Class_t *PeriodMon);
+
+
+/******************************************************************************
+** Function: PERIOD_MON_SendTlm
+**
+*/
+void PERIOD_MON_SendTlm(PERIOD_MON_Class_t *PeriodMon);
+
+
+/******************************************************************************
+** Function: PERIOD_MON_StartCycle
+**
+** Measure the period since the previous cycle start.
+**
+*/
+void PERIOD_MON_StartCycle(PERIOD_MON_Class_t *PeriodMon);
+
+
+#endif /* _period_mon_ */
@@ -0,0 +1,237 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the sensor data message checks
+**
+**  Notes:
+**    1. The checks use integer compares and one time subtraction so they
+**       cost far less than a control cycle. See sensor_chk.h.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "sensor_chk.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *const ResultStr[] = { "accepted", "duplicate", "out of order", "stale" };
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint32 MsgAge(CFE_TIME_SysTime_t MsgTime);
+static bool   Resync(SENSOR_CHK_Class_t *SensorChk, CFE_TIME_SysTime_t MsgTime, CFE_TIME_Compare_t TimeOrder);
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_Constructor
+**
+*/
+void SENSOR_CHK_Constructor(SENSOR_CHK_Class_t *SensorChk, uint32 StaleLim,
+                            uint32 ResyncLim, uint32 ResyncJump)
+{
+
+   CFE_PSP_MemSet((void*)SensorChk, 0, sizeof(SENSOR_CHK_Class_t));
+
+   SensorChk->StaleLim   = StaleLim;
+   SensorChk->ResyncLim  = ResyncLim;
+   SensorChk->ResyncJump = ResyncJump;
+
+} /* End SENSOR_CHK_Constructor() */
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_Check
+**
+*/
+SENSOR_CHK_Result_t SENSOR_CHK_Check(SENSOR_CHK_Class_t *SensorChk, const CFE_MSG_Message_t *MsgPtr,
+                                     CFE_TIME_SysTime_t MsgTime)
+{
+
+   SENSOR_CHK_Result_t Result = SENSOR_CHK_ACCEPTED;
+   CFE_MSG_SequenceCount_t SeqCnt;
+   CFE_TIME_Compare_t TimeOrder = CFE_TIME_A_GT_B;
+   uint16 SeqDelta = 1;
+
+   CFE_MSG_GetSequenceCount(MsgPtr, &SeqCnt);
+
+   if (SensorChk->RefValid)
+   {
+
+      SeqDelta  = (SeqCnt - SensorChk->RefSeqCnt) & (SENSOR_CHK_SEQ_MOD - 1);
+      TimeOrder = CFE_TIME_Compare(MsgTime, SensorChk->RefTime);
+
+      if (SeqDelta == 0 || TimeOrder == CFE_TIME_EQUAL)
+      {
+         Result = SENSOR_CHK_DUPLICATE;
+      }
+      else if (SeqDelta >= SENSOR_CHK_SEQ_MOD/2 || TimeOrder == CFE_TIME_A_LT_B)
+      {
+         Result = SENSOR_CHK_OUT_OF_ORDER;
+      }
+
+      if (Result != SENSOR_CHK_ACCEPTED && Resync(SensorChk, MsgTime, TimeOrder))
+      {
+         Result   = SENSOR_CHK_ACCEPTED;
+         SeqDelta = 1;
+      }
+
+   } /* End if RefValid */
+
+   if (Result == SENSOR_CHK_DUPLICATE)
+   {
+      SensorChk->DuplicateCnt++;
+      SensorChk->RefRejectCnt++;
+   }
+   else if (Result == SENSOR_CHK_OUT_OF_ORDER)
+   {
+      SensorChk->OutOfOrderCnt++;
+      SensorChk->RefRejectCnt++;
+   }
+   else
+   {
+
+      if (SeqDelta > 1)
+      {
+         SensorChk->GapCnt++;
+         SensorChk->MissingCnt += SeqDelta - 1;
+         SensorChk->LastGap     = SeqDelta - 1;
+      }
+
+      SensorChk->RefValid     = true;
+      SensorChk->RefSeqCnt    = SeqCnt;
+      SensorChk->RefTime      = MsgTime;
+      SensorChk->RefRejectCnt = 0;
+
+      if (SensorChk->StaleLim > 0)
+      {
+         SensorChk->LastAge = MsgAge(MsgTime);
+         if (SensorChk->LastAge > SensorChk->StaleLim)
+         {
+            Result = SENSOR_CHK_STALE;
+            SensorChk->StaleCnt++;
+         }
+      }
+
+   } /* End if in order */
+
+   if (Result != SENSOR_CHK_ACCEPTED && !SensorChk->Rejecting)
+   {
+      CFE_EVS_SendEvent(SENSOR_CHK_REJECT_EID, CFE_EVS_EventType_ERROR,
+                        "Rejected %s sensor data, sequence count %u, time %u.%06u",
+                        ResultStr[Result], (unsigned int)SeqCnt,
+                        (unsigned int)MsgTime.Seconds, (unsigned int)CFE_TIME_Sub2MicroSecs(MsgTime.Subseconds));
+   }
+   SensorChk->Rejecting = (Result != SENSOR_CHK_ACCEPTED);
+
+   return Result;
+
+} /* End SENSOR_CHK_Check() */
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_ResetStatus
+**
+*/
+void SENSOR_CHK_ResetStatus(SENSOR_CHK_Class_t *SensorChk)
+{
+
+   SensorChk->DuplicateCnt  = 0;
+   SensorChk->OutOfOrderCnt = 0;
+   SensorChk->StaleCnt      = 0;
+   SensorChk->GapCnt        = 0;
+   SensorChk->MissingCnt    = 0;
+   SensorChk->LastGap       = 0;
+   SensorChk->LastAge       = 0;
+   SensorChk->ResyncCnt     = 0;
+
+   SensorChk->RefValid      = false;
+   SensorChk->Rejecting     = false;
+   SensorChk->RefRejectCnt  = 0;
+
+} /* End SENSOR_CHK_ResetStatus() */
+
+
+/******************************************************************************
+** Function: MsgAge
+**
+** Return the microseconds from MsgTime to the current time. A time stamp
+** in the future has an age of 0.
+**
+*/
+static uint32 MsgAge(CFE_TIME_SysTime_t MsgTime)
+{
+
+   CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+   CFE_TIME_SysTime_t Age;
+   uint64 AgeUs = 0;
+
+   if (CFE_TIME_Compare(Now, MsgTime) == CFE_TIME_A_GT_B)
+   {
+      Age   = CFE_TIME_Subtract(Now, MsgTime);
+      AgeUs = (uint64)Age.Seconds * 1000000 + CFE_TIME_Sub2MicroSecs(Age.Subseconds);
+   }
+
+   return (AgeUs > UINT32_MAX) ? UINT32_MAX : (uint32)AgeUs;
+
+} /* End MsgAge() */
+
+
+/******************************************************************************
+** Function: Resync
+**
+** Drop the reference when a rejected message meets a resync condition, see
+** sensor_chk.h. Returns true if the message should be treated as the first
+** message.
+**
+*/
+static bool Resync(SENSOR_CHK_Class_t *SensorChk, CFE_TIME_SysTime_t MsgTime, CFE_TIME_Compare_t TimeOrder)
+{
+
+   bool RetStatus = false;
+   CFE_TIME_SysTime_t Jump;
+
+   if (SensorChk->ResyncLim > 0 && SensorChk->RefRejectCnt >= SensorChk->ResyncLim)
+   {
+      RetStatus = true;
+   }
+   else if (SensorChk->ResyncJump > 0 && TimeOrder == CFE_TIME_A_LT_B)
+   {
+      Jump = CFE_TIME_Subtract(SensorChk->RefTime, MsgTime);
+      RetStatus = (Jump.Seconds >= SensorChk->ResyncJump);
+   }
+
+   if (RetStatus)
+   {
+      CFE_EVS_SendEvent(SENSOR_CHK_RESYNC_EID, CFE_EVS_EventType_INFORMATION,
+                        "Resynced sensor checks after %u rejected messages, reference time %u.%06u, new time %u.%06u",
+                        (unsigned int)SensorChk->RefRejectCnt,
+                        (unsigned int)SensorChk->RefTime.Seconds, (unsigned int)CFE_TIME_Sub2MicroSecs(SensorChk->RefTime.Subseconds),
+                        (unsigned int)MsgTime.Seconds, (unsigned int)CFE_TIME_Sub2MicroSecs(MsgTime.Subseconds));
+      SensorChk->ResyncCnt++;
+      SensorChk->RefValid = false;
+   }
+
+   return RetStatus;
+
+} /* End Resync() */
@@ -0,0 +1,166 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Check sensor data messages before they reach the controller
+**
+**  Notes:
+**    1. Each message's sequence count and time stamp are compared with the
+**       most recent in-order message:
+**       - Duplicate:    Same sequence count, or a new sequence count with
+**                       the same time stamp
+**       - Out of order: Sequence count older than the reference, i.e.
+**                       behind it by less than half the counter range, or
+**                       a time stamp earlier than the reference
+**       - Stale:        Time stamp older than the current time by more than
+**                       the stale limit. A limit of 0 disables the check.
+**       - Gap:          Sequence count ahead of the reference by more than
+**                       one. The message is accepted and the skipped counts
+**                       are counted as missing messages.
+**       Duplicate, out of order and stale messages are rejected.
+**    2. A stale message is in order so it becomes the reference. Rejected
+**       duplicates and out of order messages don't change it.
+**    3. The first message after construction or a status reset only sets
+**       the reference.
+**    4. A reference that every new message is compared against could lock
+**       out the controller, e.g. after 42 restarts with an earlier time,
+**       after a time stamp far in the future or after a sequence count jump
+**       of half the counter range. The checks resync, i.e. accept the
+**       message as the new reference without comparing it, when:
+**       - The previous ResyncLim messages were all rejected as duplicate or
+**         out of order
+**       - The message's time stamp is at least ResyncJump seconds earlier
+**         than the reference
+**       A resync is counted in ResyncCnt and sends an event. The message is
+**       still checked against the stale limit.
+**    5. The app checks every received message before its sensor backlog
+**       policy and before fault injection. GapCnt, MissingCnt and LastGap
+**       only cover messages that never reached the app. Messages discarded
+**       by the backlog policy are counted by the app's SensorDroppedCnt and
+**       messages dropped by fault injection by FaultDropCnt.
+**    6. An event is sent for the first rejection after an accepted message
+**       so a burst of bad messages produces one event.
+**
+*/
+#ifndef _sensor_chk_
+#define _sensor_chk_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SENSOR_CHK_REJECT_EID  (SENSOR_CHK_BASE_EID + 0)
+#define SENSOR_CHK_RESYNC_EID  (SENSOR_CHK_BASE_EID + 1)
+
+/*
+** CCSDS sequence counts are 14 bits
+*/
+#define SENSOR_CHK_SEQ_MOD  0x4000
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SENSOR_CHK_ACCEPTED     = 0,
+   SENSOR_CHK_DUPLICATE    = 1,
+   SENSOR_CHK_OUT_OF_ORDER = 2,
+   SENSOR_CHK_STALE        = 3
+
+} SENSOR_CHK_Result_t;
+
+
+/******************************************************************************
+** SENSOR_CHK Class
+*/
+
+typedef struct
+{
+
+   uint32  StaleLim;           /* Microseconds, 0 disables the stale check */
+   uint32  ResyncLim;          /* Consecutive duplicate or out of order messages, 0 disables */
+   uint32  ResyncJump;         /* Seconds, 0 disables */
+
+   bool    RefValid;           /* A reference message has been received */
+   bool    Rejecting;          /* Previous message was rejected */
+   uint32  RefRejectCnt;       /* Consecutive duplicate or out of order messages */
+   uint16  RefSeqCnt;
+   CFE_TIME_SysTime_t  RefTime;
+
+   uint32  DuplicateCnt;
+   uint32  OutOfOrderCnt;
+   uint32  StaleCnt;
+   uint32  GapCnt;             /* Accepted messages that followed a gap */
+   uint32  MissingCnt;         /* Sequence counts skipped by gaps, messages that never arrived */
+   uint16  LastGap;            /* Sequence counts skipped by the most recent gap */
+   uint32  LastAge;            /* Microseconds, most recent message */
+   uint32  ResyncCnt;
+
+} SENSOR_CHK_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_Constructor
+**
+** Initialize a SENSOR_CHK object.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void SENSOR_CHK_Constructor(SENSOR_CHK_Class_t *SensorChk, uint32 StaleLim,
+                            uint32 ResyncLim, uint32 ResyncJump);
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_Check
+**
+** Check a sensor data message time stamped MsgTime. The message should only
+** be used if SENSOR_CHK_ACCEPTED is returned.
+**
+*/
+SENSOR_CHK_Result_t SENSOR_CHK_Check(SENSOR_CHK_Class_t *SensorChk, const CFE_MSG_Message_t *MsgPtr,
+                                     CFE_TIME_SysTime_t MsgTime);
+
+
+/******************************************************************************
+** Function: SENSOR_CHK_ResetStatus
+**
+** Clear the counters and the reference message. The next message sets the
+** reference.
+**
+*/
+void SENSOR_CHK_ResetStatus(SENSOR_CHK_Class_t *SensorChk);
+
+
+#endif /* _sensor_chk_ */
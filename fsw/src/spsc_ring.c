@@ -0,0 +1,147 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the single producer single consumer record ring
+**
+**  Notes:
+**    1. The GCC atomic builtins are used because they're available to
+**       every toolchain this app is built with, regardless of the C
+**       language standard selected by the cFE build.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "spsc_ring.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LOAD_ACQUIRE(Var)       __atomic_load_n(&(Var), __ATOMIC_ACQUIRE)
+#define STORE_RELEASE(Var,Val)  __atomic_store_n(&(Var), (Val), __ATOMIC_RELEASE)
+
+
+/******************************************************************************
+** Function: SPSC_RING_Constructor
+**
+*/
+bool SPSC_RING_Constructor(SPSC_RING_Class_t *SpscRing, void *RecBuf,
+                           uint32 RecSize, uint32 RecCnt)
+{
+
+   bool RetStatus = false;
+
+   CFE_PSP_MemSet((void*)SpscRing, 0, sizeof(SPSC_RING_Class_t));
+
+   if (RecCnt > 0 && (RecCnt & (RecCnt - 1)) == 0)
+   {
+      SpscRing->RecBuf  = (uint8 *)RecBuf;
+      SpscRing->RecSize = RecSize;
+      SpscRing->RecCnt  = RecCnt;
+      SpscRing->IdxMask = RecCnt - 1;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End SPSC_RING_Constructor() */
+
+
+/******************************************************************************
+** Function: SPSC_RING_Count
+**
+*/
+uint32 SPSC_RING_Count(const SPSC_RING_Class_t *SpscRing)
+{
+
+   return LOAD_ACQUIRE(SpscRing->Head) - LOAD_ACQUIRE(SpscRing->Tail);
+
+} /* End SPSC_RING_Count() */
+
+
+/******************************************************************************
+** Function: SPSC_RING_GetReadSpan
+**
+*/
+uint32 SPSC_RING_GetReadSpan(SPSC_RING_Class_t *SpscRing, const void **Rec)
+{
+
+   uint32 Tail    = SpscRing->Tail;
+   uint32 Avail   = LOAD_ACQUIRE(SpscRing->Head) - Tail;
+   uint32 TailIdx = Tail & SpscRing->IdxMask;
+   uint32 SpanCnt = SpscRing->RecCnt - TailIdx;
+
+   *Rec = &SpscRing->RecBuf[TailIdx * SpscRing->RecSize];
+
+   return (Avail < SpanCnt) ? Avail : SpanCnt;
+
+} /* End SPSC_RING_GetReadSpan() */
+
+
+/******************************************************************************
+** Function: SPSC_RING_Push
+**
+*/
+bool SPSC_RING_Push(SPSC_RING_Class_t *SpscRing, const void *Rec)
+{
+
+   bool   RetStatus = false;
+   uint32 Head = SpscRing->Head;
+
+   if ((Head - LOAD_ACQUIRE(SpscRing->Tail)) < SpscRing->RecCnt)
+   {
+      memcpy(&SpscRing->RecBuf[(Head & SpscRing->IdxMask) * SpscRing->RecSize], Rec, SpscRing->RecSize);
+      STORE_RELEASE(SpscRing->Head, Head + 1);
+      RetStatus = true;
+   }
+   else
+   {
+      SpscRing->OverflowCnt++;
+   }
+
+   return RetStatus;
+
+} /* End SPSC_RING_Push() */
+
+
+/******************************************************************************
+** Function: SPSC_RING_Release
+**
+*/
+void SPSC_RING_Release(SPSC_RING_Class_t *SpscRing, uint32 RecCnt)
+{
+
+   STORE_RELEASE(SpscRing->Tail, SpscRing->Tail + RecCnt);
+
+} /* End SPSC_RING_Release() */
+
+
+/******************************************************************************
+** Function: SPSC_RING_Reset
+**
+*/
+void SPSC_RING_Reset(SPSC_RING_Class_t *SpscRing)
+{
+
+   STORE_RELEASE(SpscRing->Head, 0);
+   STORE_RELEASE(SpscRing->Tail, 0);
+   SpscRing->OverflowCnt = 0;
+
+} /* End SPSC_RING_Reset() */
@@ -0,0 +1,148 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Single producer single consumer ring of fixed-size records
+**
+**  Notes:
+**    1. One task may write records and one other task may read them
+**       without a lock. The head index is only written by the producer
+**       and the tail index only by the consumer. Each index is published
+**       with release semantics after the record data it covers.
+**    2. The caller supplies the record storage so rings can be statically
+**       allocated inside their owning objects. The record count must be a
+**       power of 2.
+**    3. The consumer reads records in place. SPSC_RING_GetReadSpan()
+**       returns the contiguous records up to the end of the storage so a
+**       consumer can write a span to a file with one call.
+**
+*/
+#ifndef _spsc_ring_
+#define _spsc_ring_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** SPSC_RING Class
+*/
+
+typedef struct
+{
+
+   uint8   *RecBuf;
+   uint32   RecSize;           /* Bytes */
+   uint32   RecCnt;            /* Power of 2 */
+   uint32   IdxMask;
+
+   uint32   Head;              /* Free running, written by producer */
+   uint32   Tail;              /* Free running, written by consumer */
+
+   uint32   OverflowCnt;       /* Written by producer */
+
+} SPSC_RING_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SPSC_RING_Constructor
+**
+** Initialize a ring to use caller supplied storage.
+**
+** Notes:
+**   1. Returns false if RecCnt isn't a non-zero power of 2.
+**
+*/
+bool SPSC_RING_Constructor(SPSC_RING_Class_t *SpscRing, void *RecBuf,
+                           uint32 RecSize, uint32 RecCnt);
+
+
+/******************************************************************************
+** Function: SPSC_RING_Count
+**
+** Return the number of records waiting to be read.
+**
+*/
+uint32 SPSC_RING_Count(const SPSC_RING_Class_t *SpscRing);
+
+
+/******************************************************************************
+** Function: SPSC_RING_GetReadSpan
+**
+** Return the number of contiguous records that can be read starting at
+** *Rec. Zero is returned when the ring is empty.
+**
+** Notes:
+**   1. Consumer only. Records stay valid until SPSC_RING_Release().
+**
+*/
+uint32 SPSC_RING_GetReadSpan(SPSC_RING_Class_t *SpscRing, const void **Rec);
+
+
+/******************************************************************************
+** Function: SPSC_RING_Push
+**
+** Copy a record into the ring.
+**
+** Notes:
+**   1. Producer only. Returns false and counts an overflow if the ring is
+**      full. The record is dropped rather than blocking the producer.
+**
+*/
+bool SPSC_RING_Push(SPSC_RING_Class_t *SpscRing, const void *Rec);
+
+
+/******************************************************************************
+** Function: SPSC_RING_Release
+**
+** Free records returned by SPSC_RING_GetReadSpan().
+**
+** Notes:
+**   1. Consumer only.
+**
+*/
+void SPSC_RING_Release(SPSC_RING_Class_t *SpscRing, uint32 RecCnt);
+
+
+/******************************************************************************
+** Function: SPSC_RING_Reset
+**
+** Discard all records and clear the overflow count.
+**
+** Notes:
+**   1. Only safe when neither the producer nor the consumer is using the
+**      ring.
+**
+*/
+void SPSC_RING_Reset(SPSC_RING_Class_t *SpscRing);
+
+
+#endif /* _spsc_ring_ */
@@ -0,0 +1,429 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the sensor data message trace recorder
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <string.h>
+#include "trace_rec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define GET_STATE(TraceRec)      __atomic_load_n(&((TraceRec)->State), __ATOMIC_ACQUIRE)
+#define SET_STATE(TraceRec,Val)  __atomic_store_n(&((TraceRec)->State), (Val), __ATOMIC_RELEASE)
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool  ChildTaskCallback(CHILDMGR_Class_t *ChildMgr);
+static void  DrainRing(void);
+static void  WriteChunk(void);
+static int32 WriteFileHdrs(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static TRACE_REC_Class_t *TraceRec = NULL;
+
+
+/******************************************************************************
+** Function: TRACE_REC_Constructor
+**
+*/
+void TRACE_REC_Constructor(TRACE_REC_Class_t *TraceRecObj, const INITBL_Class_t *IniTbl)
+{
+
+   int32 CfeStatus;
+   CHILDMGR_TaskInit_t ChildTaskInit;
+
+   TraceRec = TraceRecObj;
+
+   CFE_PSP_MemSet((void*)TraceRec, 0, sizeof(TRACE_REC_Class_t));
+
+   TraceRec->State       = TRACE_REC_IDLE;
+   TraceRec->FlushPeriod = INITBL_GetIntConfig(IniTbl, CFG_TRACE_REC_FLUSH_PERIOD);
+
+   strncpy(TraceRec->DefFilename, INITBL_GetStrConfig(IniTbl, CFG_TRACE_REC_FILE), OS_MAX_PATH_LEN);
+   TraceRec->DefFilename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SPSC_RING_Constructor(&TraceRec->Ring, TraceRec->RecBuf, sizeof(TRACE_REC_Rec_t), TRACE_REC_REC_CNT);
+
+   ChildTaskInit.TaskName  = INITBL_GetStrConfig(IniTbl, CFG_TRACE_REC_CHILD_NAME);
+   ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_TRACE_REC_CHILD_STACK_SIZE);
+   ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_TRACE_REC_CHILD_PRIORITY);
+   ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_TRACE_REC_CHILD_PERF_ID);
+
+   CfeStatus = CHILDMGR_Constructor(&TraceRec->ChildMgr, ChildMgr_TaskMainCallback,
+                                    ChildTaskCallback, &ChildTaskInit);
+
+   TraceRec->ChildTaskValid = (CfeStatus == CFE_SUCCESS);
+   if (!TraceRec->ChildTaskValid)
+   {
+      CFE_EVS_SendEvent(TRACE_REC_CHILD_TASK_EID, CFE_EVS_EventType_ERROR,
+                        "Sensor trace child task %s creation failed, status 0x%08X. Sensor tracing is unavailable",
+                        ChildTaskInit.TaskName, (unsigned int)CfeStatus);
+   }
+
+} /* End TRACE_REC_Constructor() */
+
+
+/******************************************************************************
+** Function: TRACE_REC_AddMsg
+**
+*/
+void TRACE_REC_AddMsg(TRACE_REC_Class_t *TraceRecObj, const BC42_INTF_SensorDataMsg_t *SensorDataMsg)
+{
+
+   TRACE_REC_Rec_t         Rec;
+   CFE_TIME_SysTime_t      Time;
+   CFE_MSG_SequenceCount_t MsgSeqCnt = 0;
+
+   if (GET_STATE(TraceRecObj) == TRACE_REC_ACTIVE)
+   {
+
+      Rec.Seq = TraceRecObj->Seq++;
+
+      CFE_MSG_GetMsgTime(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), &Time);
+      Rec.MsgSeconds    = Time.Seconds;
+      Rec.MsgSubseconds = Time.Subseconds;
+
+      Time = CFE_TIME_GetTime();
+      Rec.RecvSeconds    = Time.Seconds;
+      Rec.RecvSubseconds = Time.Subseconds;
+
+      CFE_MSG_GetSequenceCount(CFE_MSG_PTR(SensorDataMsg->TelemetryHeader), &MsgSeqCnt);
+      Rec.MsgSeqCnt = MsgSeqCnt;
+      Rec.Spare     = 0;
+
+      memcpy(&Rec.Payload, &SensorDataMsg->Payload, sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+
+      SPSC_RING_Push(&TraceRecObj->Ring, &Rec);
+
+   } /* End if active */
+
+} /* End TRACE_REC_AddMsg() */
+
+
+/******************************************************************************
+** Function: TRACE_REC_StartCmd
+**
+*/
+bool TRACE_REC_StartCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   TRACE_REC_Class_t *TraceRecObj = (TRACE_REC_Class_t *)ObjDataPtr;
+   const BC42_CTRL_StartSensorTrace_CmdPayload_t *Cmd = CMDMGR_PAYLOAD_PTR(MsgPtr, BC42_CTRL_StartSensorTrace_t);
+   bool          RetStatus = false;
+   int32         SysStatus;
+   os_err_name_t OsErrStr;
+
+   if (!TraceRecObj->ChildTaskValid)
+   {
+      CFE_EVS_SendEvent(TRACE_REC_START_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sensor trace command rejected, sensor trace child task not running");
+   }
+   else if (GET_STATE(TraceRecObj) != TRACE_REC_IDLE)
+   {
+      CFE_EVS_SendEvent(TRACE_REC_START_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "Start sensor trace command had no effect, trace already active or closing");
+   }
+   else
+   {
+
+      if (Cmd->Filename[0] == '\0')
+      {
+         strncpy(TraceRecObj->Filename, TraceRecObj->DefFilename, OS_MAX_PATH_LEN);
+      }
+      else
+      {
+         strncpy(TraceRecObj->Filename, Cmd->Filename, OS_MAX_PATH_LEN);
+      }
+      TraceRecObj->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+      SysStatus = OS_OpenCreate(&TraceRecObj->FileHandle, TraceRecObj->Filename,
+                                OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+      if (SysStatus == OS_SUCCESS)
+      {
+
+         SysStatus = WriteFileHdrs();
+
+         if (SysStatus == OS_SUCCESS)
+         {
+            TraceRecObj->Seq          = 0;
+            TraceRecObj->RecWriteCnt  = 0;
+            TraceRecObj->WriteErrCnt  = 0;
+            TraceRecObj->Chunk.Hdr.ChunkSeq = 0;
+            TraceRecObj->Chunk.Hdr.RecCnt   = 0;
+            SPSC_RING_Reset(&TraceRecObj->Ring);
+            SET_STATE(TraceRecObj, TRACE_REC_ACTIVE);
+
+            CFE_EVS_SendEvent(TRACE_REC_START_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                              "Created sensor trace file %s with %d byte records, %d records per chunk",
+                              TraceRecObj->Filename, (int)sizeof(TRACE_REC_Rec_t), TRACE_REC_CHUNK_REC_CNT);
+            RetStatus = true;
+         }
+         else
+         {
+            OS_close(TraceRecObj->FileHandle);
+            CFE_EVS_SendEvent(TRACE_REC_START_CMD_EID, CFE_EVS_EventType_ERROR,
+                              "Error writing sensor trace file %s headers", TraceRecObj->Filename);
+         }
+      }
+      else
+      {
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent(TRACE_REC_START_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Error creating sensor trace file %s. Status = %s", TraceRecObj->Filename, OsErrStr);
+
+      } /* End if error creating file */
+   } /* End if trace idle */
+
+   return RetStatus;
+
+} /* End TRACE_REC_StartCmd() */
+
+
+/******************************************************************************
+** Function: TRACE_REC_StopCmd
+**
+*/
+bool TRACE_REC_StopCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   TRACE_REC_Class_t *TraceRecObj = (TRACE_REC_Class_t *)ObjDataPtr;
+
+   if (GET_STATE(TraceRecObj) == TRACE_REC_ACTIVE)
+   {
+      SET_STATE(TraceRecObj, TRACE_REC_CLOSING);
+      CFE_EVS_SendEvent(TRACE_REC_STOP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Sensor trace file %s will be closed after the record buffer is flushed",
+                        TraceRecObj->Filename);
+   }
+   else
+   {
+      CFE_EVS_SendEvent(TRACE_REC_STOP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                        "Stop sensor trace command had no effect, trace not currently active");
+   }
+
+   return true;
+
+} /* End TRACE_REC_StopCmd() */
+
+
+/******************************************************************************
+** Function: ChildTaskCallback
+**
+** Notes:
+**   1. Called in a loop by the child task manager. Returning false would
+**      terminate the child task.
+**
+*/
+static bool ChildTaskCallback(CHILDMGR_Class_t *ChildMgr)
+{
+
+   uint32 State;
+
+   OS_TaskDelay(TraceRec->FlushPeriod);
+
+   State = GET_STATE(TraceRec);
+
+   if (State != TRACE_REC_IDLE)
+   {
+
+      DrainRing();
+
+      /*
+      ** A write error during the drain stops the trace so the state is read
+      ** again. Records the app task added after the stop are discarded when
+      ** the next trace starts.
+      */
+      State = GET_STATE(TraceRec);
+      if (State == TRACE_REC_CLOSING)
+      {
+
+         if (TraceRec->Chunk.Hdr.RecCnt > 0)
+         {
+            WriteChunk();
+         }
+
+         OS_close(TraceRec->FileHandle);
+
+         CFE_EVS_SendEvent(TRACE_REC_CLOSE_EID, CFE_EVS_EventType_INFORMATION,
+                           "Sensor trace file %s closed. Wrote %u records in %u chunks, dropped %u, %u write errors",
+                           TraceRec->Filename, (unsigned int)TraceRec->RecWriteCnt,
+                           (unsigned int)TraceRec->Chunk.Hdr.ChunkSeq,
+                           (unsigned int)TraceRec->Ring.OverflowCnt, (unsigned int)TraceRec->WriteErrCnt);
+
+         SET_STATE(TraceRec, TRACE_REC_IDLE);
+
+      }
+   } /* End if not idle */
+
+   return true;
+
+} /* End ChildTaskCallback() */
+
+
+/******************************************************************************
+** Function: DrainRing
+**
+** Move every record in the ring into the chunk buffer, writing each chunk
+** as it fills.
+**
+*/
+static void DrainRing(void)
+{
+
+   uint32 RecCnt;
+   uint32 CopyCnt;
+   const TRACE_REC_Rec_t *Rec;
+   TRACE_REC_Chunk_t     *Chunk = &TraceRec->Chunk;
+
+   RecCnt = SPSC_RING_GetReadSpan(&TraceRec->Ring, (const void **)&Rec);
+
+   while (RecCnt > 0)
+   {
+
+      CopyCnt = TRACE_REC_CHUNK_REC_CNT - Chunk->Hdr.RecCnt;
+      if (CopyCnt > RecCnt)
+      {
+         CopyCnt = RecCnt;
+      }
+
+      memcpy(&Chunk->Rec[Chunk->Hdr.RecCnt], Rec, CopyCnt * sizeof(TRACE_REC_Rec_t));
+      Chunk->Hdr.RecCnt += CopyCnt;
+      SPSC_RING_Release(&TraceRec->Ring, CopyCnt);
+
+      if (Chunk->Hdr.RecCnt == TRACE_REC_CHUNK_REC_CNT)
+      {
+         WriteChunk();
+      }
+
+      RecCnt = SPSC_RING_GetReadSpan(&TraceRec->Ring, (const void **)&Rec);
+
+   } /* End while records */
+
+} /* End DrainRing() */
+
+
+/******************************************************************************
+** Function: WriteChunk
+**
+** Complete the chunk header and write the chunk with one call.
+**
+** Notes:
+**   1. A failed or short write stops the trace. Chunk N must start at
+**      DataStart + N*ChunkSize for the time index, so no chunk is written
+**      after a partial one. A short write leaves a partial final chunk
+**      that readers ignore. Records drained after the error are discarded
+**      and the child task closes the file.
+*/
+static void WriteChunk(void)
+{
+
+   int32  SysStatus;
+   uint32 WriteLen;
+   uint32 ExpectedState;
+   TRACE_REC_Chunk_t *Chunk = &TraceRec->Chunk;
+
+   memcpy(Chunk->Hdr.Sync, TRACE_REC_CHUNK_SYNC, sizeof(Chunk->Hdr.Sync));
+   Chunk->Hdr.FirstSeconds    = Chunk->Rec[0].MsgSeconds;
+   Chunk->Hdr.FirstSubseconds = Chunk->Rec[0].MsgSubseconds;
+   Chunk->Hdr.LastSeconds     = Chunk->Rec[Chunk->Hdr.RecCnt-1].MsgSeconds;
+   Chunk->Hdr.LastSubseconds  = Chunk->Rec[Chunk->Hdr.RecCnt-1].MsgSubseconds;
+   Chunk->Hdr.Spare           = 0;
+
+   if (TraceRec->WriteErrCnt == 0)
+   {
+
+      WriteLen  = sizeof(TRACE_REC_ChunkHdr_t) + Chunk->Hdr.RecCnt * sizeof(TRACE_REC_Rec_t);
+      SysStatus = OS_write(TraceRec->FileHandle, Chunk, WriteLen);
+
+      if (SysStatus == (int32)WriteLen)
+      {
+         TraceRec->RecWriteCnt += Chunk->Hdr.RecCnt;
+         Chunk->Hdr.ChunkSeq++;
+      }
+      else
+      {
+         TraceRec->WriteErrCnt++;
+         ExpectedState = TRACE_REC_ACTIVE;
+         __atomic_compare_exchange_n(&TraceRec->State, &ExpectedState, TRACE_REC_CLOSING, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+         CFE_EVS_SendEvent(TRACE_REC_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                           "Sensor trace file %s write error, wrote %d of %u chunk bytes. Stopping the trace",
+                           TraceRec->Filename, (int)SysStatus, (unsigned int)WriteLen);
+      }
+   
+   } /* End if no write error */
+
+   Chunk->Hdr.RecCnt = 0;
+
+} /* End WriteChunk() */
+
+
+/******************************************************************************
+** Function: WriteFileHdrs
+**
+** Write the cFE file header and the trace file header.
+**
+*/
+static int32 WriteFileHdrs(void)
+{
+
+   int32 RetStatus = OS_ERROR;
+   CFE_FS_Header_t     CfeHdr;
+   TRACE_REC_FileHdr_t TraceHdr;
+
+   CFE_FS_InitHeader(&CfeHdr, "BC42_CTRL sensor trace", TRACE_REC_FS_SUBTYPE);
+
+   if (CFE_FS_WriteHeader(TraceRec->FileHandle, &CfeHdr) == sizeof(CFE_FS_Header_t))
+   {
+
+      memset(&TraceHdr, 0, sizeof(TRACE_REC_FileHdr_t));
+      memcpy(TraceHdr.FileId, TRACE_REC_FILE_ID, sizeof(TraceHdr.FileId));
+      TraceHdr.Version      = TRACE_REC_FILE_VERSION;
+      TraceHdr.ByteOrder    = 0x01020304;
+      TraceHdr.HdrSize      = sizeof(TRACE_REC_FileHdr_t);
+      TraceHdr.RecSize      = sizeof(TRACE_REC_Rec_t);
+      TraceHdr.ChunkHdrSize = sizeof(TRACE_REC_ChunkHdr_t);
+      TraceHdr.ChunkRecCnt  = TRACE_REC_CHUNK_REC_CNT;
+      TraceHdr.ChunkSize    = sizeof(TRACE_REC_ChunkHdr_t) + TRACE_REC_CHUNK_REC_CNT * sizeof(TRACE_REC_Rec_t);
+
+      if (OS_write(TraceRec->FileHandle, &TraceHdr, sizeof(TRACE_REC_FileHdr_t)) == sizeof(TRACE_REC_FileHdr_t))
+      {
+         RetStatus = OS_SUCCESS;
+      }
+   }
+
+   return RetStatus;
+
+} /* End WriteFileHdrs() */
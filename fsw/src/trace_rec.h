@@ -0,0 +1,249 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Record every received sensor data message to a chunked trace file
+**
+**  Notes:
+**    1. The app task copies each received sensor data message into a
+**       preallocated SPSC ring, including messages the sensor backlog
+**       policy drops. A low priority child task moves records from the
+**       ring into a chunk buffer and writes each chunk when it is full, so
+**       the app task never performs file I/O. Records are dropped and
+**       counted if the ring fills.
+**    2. The trace file starts with a cFE file header and a
+**       TRACE_REC_FileHdr_t followed by chunks. Every chunk except the
+**       last one holds TRACE_REC_CHUNK_REC_CNT records so chunk N starts at
+**       HdrSize + N*ChunkSize bytes after the cFE header. Each chunk header
+**       contains the first and last message times of its records, so the
+**       chunk headers are a time index that can be binary searched
+**       without reading any records.
+**    3. Records hold the message times and the raw sensor payload rather
+**       than the message so traces don't depend on the cFE header format.
+**       The payload is decoded with the BC42_INTF EDS.
+**    4. The child task owns the file while recording. The stop command
+**       only requests a stop and the child task writes the final partial
+**       chunk and closes the file. A file write error also stops the trace
+**       so later chunks can't be misaligned by a partial chunk.
+**
+*/
+#ifndef _trace_rec_
+#define _trace_rec_
+
+/*
+** Includes
+*/
+
+#include "bc42_intf_eds_typedefs.h"
+
+#include "app_cfg.h"
+#include "spsc_ring.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TRACE_REC_FILE_ID       "BC42STRC"
+#define TRACE_REC_FILE_VERSION  1
+#define TRACE_REC_FS_SUBTYPE    0x42535452  /* "BSTR" */
+#define TRACE_REC_CHUNK_SYNC    "CHNK"
+
+
+/*
+** Event Message IDs
+*/
+
+#define TRACE_REC_START_CMD_EID   (TRACE_REC_BASE_EID + 0)
+#define TRACE_REC_STOP_CMD_EID    (TRACE_REC_BASE_EID + 1)
+#define TRACE_REC_CHILD_TASK_EID  (TRACE_REC_BASE_EID + 2)
+#define TRACE_REC_WRITE_ERR_EID   (TRACE_REC_BASE_EID + 3)
+#define TRACE_REC_CLOSE_EID       (TRACE_REC_BASE_EID + 4)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   TRACE_REC_IDLE    = 0,    /* No file open                         */
+   TRACE_REC_ACTIVE  = 1,    /* App task adding records              */
+   TRACE_REC_CLOSING = 2     /* Child task flushing before closing   */
+
+} TRACE_REC_State_t;
+
+
+/******************************************************************************
+** Trace File Definitions
+** - Multi-byte values are written in the host's byte order. The file header
+**   ByteOrder field is 0x01020304 in that byte order.
+*/
+
+typedef struct
+{
+
+   uint32  Seq;                /* Received message count, detects dropped records */
+   uint32  MsgSeconds;         /* Sensor data message time */
+   uint32  MsgSubseconds;
+   uint32  RecvSeconds;        /* cFE time the app received the message */
+   uint32  RecvSubseconds;
+   uint16  MsgSeqCnt;          /* Message header sequence count */
+   uint16  Spare;
+
+   BC42_INTF_SensorDataMsg_Payload_t  Payload;
+
+} TRACE_REC_Rec_t;
+
+typedef struct
+{
+
+   char    Sync[4];            /* TRACE_REC_CHUNK_SYNC, not null terminated */
+   uint32  ChunkSeq;
+   uint32  RecCnt;
+   uint32  FirstSeconds;       /* Message time of the chunk's first record */
+   uint32  FirstSubseconds;
+   uint32  LastSeconds;        /* Message time of the chunk's last record */
+   uint32  LastSubseconds;
+   uint32  Spare;
+
+} TRACE_REC_ChunkHdr_t;
+
+typedef struct
+{
+
+   TRACE_REC_ChunkHdr_t  Hdr;
+   TRACE_REC_Rec_t       Rec[TRACE_REC_CHUNK_REC_CNT];
+
+} TRACE_REC_Chunk_t;
+
+typedef struct
+{
+
+   char    FileId[8];          /* TRACE_REC_FILE_ID, not null terminated */
+   uint16  Version;
+   uint16  Spare;
+   uint32  ByteOrder;
+   uint32  HdrSize;            /* Bytes, this header */
+   uint32  RecSize;            /* Bytes */
+   uint32  ChunkHdrSize;       /* Bytes */
+   uint32  ChunkRecCnt;        /* Records in every chunk except the last */
+   uint32  ChunkSize;          /* Bytes, a full chunk including its header */
+
+} TRACE_REC_FileHdr_t;
+
+
+/******************************************************************************
+** Command Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** Telemetry Packets
+** - See bc42_ctrl.xml EDS definitions
+*/
+
+/******************************************************************************
+** TRACE_REC Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Framework References
+   */
+
+   CHILDMGR_Class_t  ChildMgr;
+   bool              ChildTaskValid;
+
+   /*
+   ** Shared with the child task
+   */
+
+   uint32     State;           /* TRACE_REC_State_t, accessed atomically */
+   osal_id_t  FileHandle;
+   char       Filename[OS_MAX_PATH_LEN];
+   SPSC_RING_Class_t  Ring;
+   TRACE_REC_Rec_t    RecBuf[TRACE_REC_REC_CNT];
+
+   /*
+   ** App task data
+   */
+
+   uint32  Seq;
+   uint32  FlushPeriod;        /* Milliseconds */
+   char    DefFilename[OS_MAX_PATH_LEN];
+
+   /*
+   ** Child task data
+   */
+
+   TRACE_REC_Chunk_t  Chunk;
+   uint32  RecWriteCnt;
+   uint32  WriteErrCnt;
+
+} TRACE_REC_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: TRACE_REC_Constructor
+**
+** Initialize a TRACE_REC object and start its child task.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void TRACE_REC_Constructor(TRACE_REC_Class_t *TraceRec, const INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: TRACE_REC_AddMsg
+**
+** Add a sensor data message record if recording is active.
+**
+** Notes:
+**   1. Called by the app task for every received sensor data message. Only
+**      copies data into the ring.
+**
+*/
+void TRACE_REC_AddMsg(TRACE_REC_Class_t *TraceRec, const BC42_INTF_SensorDataMsg_t *SensorDataMsg);
+
+
+/******************************************************************************
+** Function: TRACE_REC_StartCmd
+**
+** Create the trace file, write its headers and start recording.
+**
+*/
+bool TRACE_REC_StartCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: TRACE_REC_StopCmd
+**
+** Stop recording. The child task flushes the ring and closes the file.
+**
+*/
+bool TRACE_REC_StopCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _trace_rec_ */
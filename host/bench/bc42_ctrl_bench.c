@@ -0,0 +1,262 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Benchmark the BC42_CTRL control cycle on a host
+**
+**  Notes:
+**    1. Runs CTRL42_Run42Fsw() back to back on synthetic slewing sensor
+**       data and reports throughput, the per-cycle latency distribution
+**       and the number of heap and software bus buffer allocations made
+**       inside the measured loop.
+**    2. Heap allocations are counted with the linker's --wrap option so
+**       only calls made by the flight sources and stubs are seen.
+**    3. Usage: bc42_ctrl_bench [-n cycles] [-w warmup cycles] [-v]
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "host_app.h"
+#include "mono_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_CYCLE_PERIOD  0.1    /* Seconds of simulation time per control cycle */
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static HOST_APP_Class_t HostApp;
+static BC42_INTF_SensorDataMsg_Payload_t SensorData;
+
+static uint64 HeapAllocCnt = 0;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void  LoadSensorData(uint32 Cycle, BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                            CFE_TIME_SysTime_t *SimTime);
+static int   CompareUint32(const void *A, const void *B);
+static uint32 Percentile(const uint32 *Sorted, uint32 Cnt, double Pct);
+
+
+/******************************************************************************
+** Heap allocation counters
+*/
+
+void *__real_malloc(size_t Size);
+void *__real_calloc(size_t Cnt, size_t Size);
+void *__real_realloc(void *Ptr, size_t Size);
+
+void *__wrap_malloc(size_t Size)
+{
+   __atomic_add_fetch(&HeapAllocCnt, 1, __ATOMIC_RELAXED);
+   return __real_malloc(Size);
+}
+
+void *__wrap_calloc(size_t Cnt, size_t Size)
+{
+   __atomic_add_fetch(&HeapAllocCnt, 1, __ATOMIC_RELAXED);
+   return __real_calloc(Cnt, Size);
+}
+
+void *__wrap_realloc(void *Ptr, size_t Size)
+{
+   __atomic_add_fetch(&HeapAllocCnt, 1, __ATOMIC_RELAXED);
+   return __real_realloc(Ptr, Size);
+}
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   uint32  CycleCnt  = 100000;
+   uint32  WarmupCnt = 1000;
+   uint32  Cycle;
+   CFE_TIME_SysTime_t SimTime;
+   uint32 *ExeTime;
+   uint64  StartNs, CycleNs, TotalNs = 0;
+   uint64  HeapAllocStart, SbAllocStart;
+   uint64  HeapAllocs, SbAllocs;
+   int     Opt;
+
+   while ((Opt = getopt(argc, argv, "n:w:v")) != -1)
+   {
+      switch (Opt)
+      {
+         case 'n': CycleCnt  = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'w': WarmupCnt = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'v': HOST_SetEventsVerbose(true); break;
+         default:
+            fprintf(stderr, "Usage: %s [-n cycles] [-w warmup cycles] [-v]\n", argv[0]);
+            return EXIT_FAILURE;
+      }
+   }
+
+   if (CycleCnt == 0)
+   {
+      fprintf(stderr, "Cycle count must be greater than zero\n");
+      return EXIT_FAILURE;
+   }
+
+   if (!HOST_APP_Constructor(&HostApp, NULL))
+   {
+      return EXIT_FAILURE;
+   }
+
+   ExeTime = malloc(CycleCnt * sizeof(uint32));
+   if (ExeTime == NULL)
+   {
+      fprintf(stderr, "Unable to allocate %u execution time samples\n", CycleCnt);
+      return EXIT_FAILURE;
+   }
+
+   for (Cycle=0; Cycle < WarmupCnt; Cycle++)
+   {
+      LoadSensorData(Cycle, &SensorData, &SimTime);
+      HOST_APP_RunCycle(&HostApp, &SensorData, SimTime);
+   }
+
+   HeapAllocStart = __atomic_load_n(&HeapAllocCnt, __ATOMIC_RELAXED);
+   SbAllocStart   = HOST_GetSbAllocCnt();
+
+   for (Cycle=0; Cycle < CycleCnt; Cycle++)
+   {
+      LoadSensorData(WarmupCnt + Cycle, &SensorData, &SimTime);
+      StartNs = MONO_TIME_GetNs();
+      HOST_APP_RunCycle(&HostApp, &SensorData, SimTime);
+      CycleNs = MONO_TIME_GetNs() - StartNs;
+      ExeTime[Cycle] = (CycleNs > UINT32_MAX) ? UINT32_MAX : (uint32)CycleNs;
+      TotalNs += CycleNs;
+   }
+
+   HeapAllocs = __atomic_load_n(&HeapAllocCnt, __ATOMIC_RELAXED) - HeapAllocStart;
+   SbAllocs   = HOST_GetSbAllocCnt() - SbAllocStart;
+
+   qsort(ExeTime, CycleCnt, sizeof(uint32), CompareUint32);
+
+   printf("BC42_CTRL control cycle benchmark\n");
+   printf("   Cycles:            %u (+%u warmup)\n", CycleCnt, WarmupCnt);
+   printf("   Controller runs:   %u\n", HostApp.Ctrl42.CtrlExeCnt);
+   printf("   Throughput:        %.0f cycles/s\n", (double)CycleCnt * 1.0E9 / (double)TotalNs);
+   printf("   Latency (ns):      mean %.0f, p50 %u, p90 %u, p99 %u, p99.9 %u, max %u\n",
+          (double)TotalNs / CycleCnt,
+          Percentile(ExeTime, CycleCnt, 50.0), Percentile(ExeTime, CycleCnt, 90.0),
+          Percentile(ExeTime, CycleCnt, 99.0), Percentile(ExeTime, CycleCnt, 99.9),
+          ExeTime[CycleCnt-1]);
+   printf("   Heap allocations:  %llu (%.3f/cycle)\n", (unsigned long long)HeapAllocs,
+          (double)HeapAllocs / CycleCnt);
+   printf("   SB buffer allocs:  %llu (%.3f/cycle)\n", (unsigned long long)SbAllocs,
+          (double)SbAllocs / CycleCnt);
+   printf("   SB transmits:      %llu\n", (unsigned long long)HOST_GetSbTransmitCnt());
+
+   free(ExeTime);
+
+   return EXIT_SUCCESS;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: LoadSensorData
+**
+** Synthesize a damped slew about a fixed axis with a rotating magnetic field
+** so every controller path is exercised with changing inputs.
+*/
+static void LoadSensorData(uint32 Cycle, BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                           CFE_TIME_SysTime_t *SimTime)
+{
+
+   static const double Axis[3] = { 0.48, 0.60, 0.64 };
+   double Time  = Cycle * BENCH_CYCLE_PERIOD;
+   double Angle = 0.2*exp(-Time/600.0)*cos(0.01*Time);
+   double Rate  = -0.2*exp(-Time/600.0)*(cos(0.01*Time)/600.0 + 0.01*sin(0.01*Time));
+   double SimSec = 1.0E6 + Time;
+   int i;
+
+   Sensor->Time = Time;
+   for (i=0; i < 3; i++)
+   {
+      Sensor->qbn[i] = Axis[i]*sin(Angle/2.0);
+      Sensor->wbn[i] = Axis[i]*Rate;
+      Sensor->Hw[i]  = 0.01*cos(0.001*Time + i);
+   }
+   Sensor->qbn[3] = cos(Angle/2.0);
+   Sensor->Hw[3]  = 0.0;
+
+   Sensor->svb[0] = 1.0;
+   Sensor->svb[1] = 0.0;
+   Sensor->svb[2] = 0.0;
+   Sensor->bvb[0] = 3.0E-5*cos(0.0011*Time);
+   Sensor->bvb[1] = 3.0E-5*sin(0.0011*Time);
+   Sensor->bvb[2] = 1.0E-5;
+
+   Sensor->GpsValid = 1;
+   Sensor->StValid  = 1;
+   Sensor->SunValid = 1;
+
+   SimTime->Seconds    = (uint32)SimSec;
+   SimTime->Subseconds = CFE_TIME_Micro2SubSecs((uint32)((SimSec - (uint32)SimSec)*1.0E6));
+
+} /* End LoadSensorData() */
+
+
+/******************************************************************************
+** Function: CompareUint32
+**
+*/
+static int CompareUint32(const void *A, const void *B)
+{
+
+   uint32 a = *(const uint32 *)A;
+   uint32 b = *(const uint32 *)B;
+
+   return (a > b) - (a < b);
+
+} /* End CompareUint32() */
+
+
+/******************************************************************************
+** Function: Percentile
+**
+** Nearest-rank percentile of a sorted sample array.
+*/
+static uint32 Percentile(const uint32 *Sorted, uint32 Cnt, double Pct)
+{
+
+   uint32 Rank = (uint32)ceil(Pct / 100.0 * Cnt);
+
+   if (Rank < 1) Rank = 1;
+   if (Rank > Cnt) Rank = Cnt;
+
+   return Sorted[Rank-1];
+
+} /* End Percentile() */
@@ -0,0 +1,236 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Benchmark the control laws in fsw/src/ctrl_law.c
+**
+**  Notes:
+**    1. BENCH_SAMPLE_CNT controller outputs are created by running
+**       BC42_RunController() on pseudo-random sensor data with small
+**       attitude and rate errors. Each law is run over the samples until
+**       about -n calls have been made.
+**    2. The table parameters are the defaults in cpu1_bc42_ctrl_prm.json
+**       and the gains are fixed so the BC42 and PD laws compute the same
+**       torque with the host controller stand-in.
+**    3. For each law the benchmark reports the time per call, the largest
+**       torque difference from the PD law over the samples and the
+**       fraction of calls that were limited. The laws are compiled for
+**       BC42_NWHL wheels in the precision selected by CTRL_LAW_DOUBLE.
+**    4. Usage: ctrl_law_bench [-n calls]
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "ctrl_law.h"
+#include "mono_time.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_SAMPLE_CNT  1024
+#define BENCH_DEF_CALLS   (16*1024*1024)
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *LawName[] = { "BC42", "PD", "PID", "SR_STEER" };
+
+static const CTRL_LAW_Cfg_t LawCfg =
+{
+   .Ki         = { 1.0, 1.0, 1.0 },
+   .IntLim     = 0.05,
+   .TcmdLim    = 1.0,
+   .WhlTcmdLim = 0.5,
+   .SrLambda   = 0.01
+};
+
+static const BC42_CtrlGains_t Gains =
+{
+   .Kp   = { 2.0, 1.5, 3.0 },
+   .Kr   = { 20.0, 15.0, 30.0 },
+   .Kunl = 1.0E6
+};
+
+static BC42_Ac_t Sample[BENCH_SAMPLE_CNT];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static double Rand(uint64 *Seed, double Min, double Max);
+static void   LoadSamples(void);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   uint32  Calls = BENCH_DEF_CALLS;
+   uint32  Reps, Rep, s, Law;
+   uint64  StartNs, RunNs;
+   double  PdTcmd[BENCH_SAMPLE_CNT][3];
+   double  Tcmd[3];
+   double  MaxDiff;
+   int     Opt, i;
+
+   CTRL_LAW_Class_t CtrlLaw;
+
+   while ((Opt = getopt(argc, argv, "n:")) != -1)
+   {
+      switch (Opt)
+      {
+         case 'n': Calls = (uint32)strtoul(optarg, NULL, 0); break;
+         default:
+            fprintf(stderr, "Usage: %s [-n calls]\n", argv[0]);
+            return EXIT_FAILURE;
+      }
+   }
+
+   Reps = Calls / BENCH_SAMPLE_CNT;
+   if (Reps == 0) Reps = 1;
+
+   LoadSamples();
+
+   CTRL_LAW_Constructor(&CtrlLaw, "PD", 0.1);
+   CTRL_LAW_SetGains(&CtrlLaw, &Gains);
+   CTRL_LAW_SetCfg(&CtrlLaw, &LawCfg);
+   for (s=0; s < BENCH_SAMPLE_CNT; s++)
+   {
+      CTRL_LAW_Run(&CtrlLaw, &Sample[s], PdTcmd[s]);
+   }
+
+   printf("BC42_CTRL control law benchmark\n");
+   printf("   Precision: %s, wheels: %d, calls per law: %u\n",
+          (sizeof(CTRL_LAW_Real_t) == sizeof(double)) ? "double" : "float", BC42_NWHL, Reps*BENCH_SAMPLE_CNT);
+   printf("   %-10s %10s %14s %10s\n", "Law", "ns/call", "Max diff PD", "Limited");
+
+   for (Law=0; Law < (sizeof(LawName)/sizeof(LawName[0])); Law++)
+   {
+
+      if (!CTRL_LAW_Constructor(&CtrlLaw, LawName[Law], 0.1))
+      {
+         return EXIT_FAILURE;
+      }
+      CTRL_LAW_SetGains(&CtrlLaw, &Gains);
+      CTRL_LAW_SetCfg(&CtrlLaw, &LawCfg);
+
+      MaxDiff = 0.0;
+      for (s=0; s < BENCH_SAMPLE_CNT; s++)
+      {
+         CTRL_LAW_Run(&CtrlLaw, &Sample[s], Tcmd);
+         for (i=0; i < 3; i++)
+         {
+            MaxDiff = fmax(MaxDiff, fabs(Tcmd[i] - PdTcmd[s][i]));
+         }
+      }
+
+      CTRL_LAW_Reset(&CtrlLaw);
+      StartNs = MONO_TIME_GetNs();
+      for (Rep=0; Rep < Reps; Rep++)
+      {
+         for (s=0; s < BENCH_SAMPLE_CNT; s++)
+         {
+            CTRL_LAW_Run(&CtrlLaw, &Sample[s], Tcmd);
+         }
+      }
+      RunNs = MONO_TIME_GetNs() - StartNs;
+
+      printf("   %-10s %10.2f %14.3e %9.1f%%\n", CtrlLaw.Name,
+             (double)RunNs / ((double)Reps*BENCH_SAMPLE_CNT), MaxDiff,
+             100.0 * CtrlLaw.State.LimitCnt / ((double)Reps*BENCH_SAMPLE_CNT));
+
+   }
+
+   return EXIT_SUCCESS;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: Rand
+**
+** Uniform value in [Min, Max) from a 64-bit LCG so runs are repeatable.
+*/
+static double Rand(uint64 *Seed, double Min, double Max)
+{
+
+   *Seed = *Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+   return Min + (Max - Min) * (double)(*Seed >> 11) / 9007199254740992.0;
+
+} /* End Rand() */
+
+
+/******************************************************************************
+** Function: LoadSamples
+**
+** Run the host controller stand-in on attitudes within about 0.1 rad and
+** rates within 0.02 rad/s of an inertial hold.
+*/
+static void LoadSamples(void)
+{
+
+   BC42_INTF_SensorDataMsg_Payload_t Sensor;
+   const BC42_Ac_t *Ac;
+   uint64 Seed = 42;
+   double Norm;
+   uint32 s;
+   int    i;
+
+   BC42_SetControlGains(&Gains);
+
+   for (s=0; s < BENCH_SAMPLE_CNT; s++)
+   {
+
+      memset(&Sensor, 0, sizeof(Sensor));
+
+      Norm = 1.0;
+      for (i=0; i < 3; i++)
+      {
+         Sensor.qbn[i] = Rand(&Seed, -0.05, 0.05);
+         Sensor.wbn[i] = Rand(&Seed, -0.02, 0.02);
+         Sensor.bvb[i] = Rand(&Seed, -5.0E-5, 5.0E-5);
+         Norm += Sensor.qbn[i]*Sensor.qbn[i];
+      }
+      Sensor.qbn[3] = 1.0;
+      Norm = sqrt(Norm);
+      for (i=0; i < 4; i++)
+      {
+         Sensor.qbn[i] /= Norm;
+         Sensor.Hw[i] = Rand(&Seed, -0.05, 0.05);
+      }
+      Sensor.StValid  = 1;
+      Sensor.SunValid = 1;
+
+      BC42_HOST_SetSensorData(&Sensor);
+      BC42_RunController(&Ac);
+      Sample[s] = *Ac;
+
+   }
+
+} /* End LoadSamples() */
@@ -0,0 +1,272 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the batched structure-of-arrays PD control law
+**
+**  Notes:
+**    1. The kernel loops take restrict qualified array parameters and
+**       have no function calls or branches so GCC and Clang vectorize them
+**       at -O3 or with -ftree-vectorize.
+**    2. The Mcmd zero field case is a single select of the divisor. A
+**       divisor of infinity makes the dipole a signed zero and adding 0.0
+**       turns -0.0 into +0.0, so a dipole component that is exactly -0.0
+**       because its cross product term is -0.0 becomes +0.0. Selecting the
+**       results instead lets GCC turn the loop back into branches that
+**       don't vectorize.
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <math.h>
+#include <string.h>
+#include "pd_batch.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PD_BATCH_MIN_B2  1.0E-30   /* Field magnitude squared below which Mcmd is zero */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static double *NextArray(uint8 **Storage, uint32 Cap);
+static void    RunMcmd(uint32 Cnt, const double *restrict Kunl,
+                       const double *restrict Hx, const double *restrict Hy, const double *restrict Hz,
+                       const double *restrict Bx, const double *restrict By, const double *restrict Bz,
+                       double *restrict Mx, double *restrict My, double *restrict Mz);
+static void    RunTcmd(uint32 Cnt, const double *restrict Kp, const double *restrict Kr,
+                       const double *restrict Therr, const double *restrict Werr,
+                       double *restrict Tcmd);
+
+
+/******************************************************************************
+** Function: PD_BATCH_Constructor
+**
+*/
+bool PD_BATCH_Constructor(PD_BATCH_Class_t *PdBatch, void *Storage,
+                          size_t StorageLen, uint32 Cap)
+{
+
+   bool   RetStatus = false;
+   uint8 *Array;
+   int    i;
+
+   CFE_PSP_MemSet((void*)PdBatch, 0, sizeof(PD_BATCH_Class_t));
+
+   if (Cap > 0 && StorageLen >= PD_BATCH_STORAGE_LEN(Cap))
+   {
+      memset(Storage, 0, PD_BATCH_STORAGE_LEN(Cap));
+
+      Array = (uint8 *)Storage + ((PD_BATCH_ALIGN - ((size_t)Storage % PD_BATCH_ALIGN)) % PD_BATCH_ALIGN);
+      for (i=0; i < 3; i++)
+      {
+         PdBatch->Kp[i]    = NextArray(&Array, Cap);
+         PdBatch->Kr[i]    = NextArray(&Array, Cap);
+         PdBatch->Therr[i] = NextArray(&Array, Cap);
+         PdBatch->Werr[i]  = NextArray(&Array, Cap);
+         PdBatch->Hvb[i]   = NextArray(&Array, Cap);
+         PdBatch->Bvb[i]   = NextArray(&Array, Cap);
+         PdBatch->Tcmd[i]  = NextArray(&Array, Cap);
+         PdBatch->Mcmd[i]  = NextArray(&Array, Cap);
+      }
+      PdBatch->Kunl = NextArray(&Array, Cap);
+
+      PdBatch->Cap = Cap;
+      PdBatch->Cnt = Cap;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End PD_BATCH_Constructor() */
+
+
+/******************************************************************************
+** Function: PD_BATCH_GetCmd
+**
+*/
+void PD_BATCH_GetCmd(const PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                     double Tcmd[3], double Mcmd[3])
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Tcmd[i] = PdBatch->Tcmd[i][Sc];
+      Mcmd[i] = PdBatch->Mcmd[i][Sc];
+   }
+
+} /* End PD_BATCH_GetCmd() */
+
+
+/******************************************************************************
+** Function: PD_BATCH_Run
+**
+** Notes:
+**   1. Each Tcmd component is its own loop so every loop streams four
+**      input arrays and one output array.
+**
+*/
+void PD_BATCH_Run(PD_BATCH_Class_t *PdBatch)
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      RunTcmd(PdBatch->Cnt, PdBatch->Kp[i], PdBatch->Kr[i], PdBatch->Therr[i],
+              PdBatch->Werr[i], PdBatch->Tcmd[i]);
+   }
+
+   RunMcmd(PdBatch->Cnt, PdBatch->Kunl,
+           PdBatch->Hvb[0], PdBatch->Hvb[1], PdBatch->Hvb[2],
+           PdBatch->Bvb[0], PdBatch->Bvb[1], PdBatch->Bvb[2],
+           PdBatch->Mcmd[0], PdBatch->Mcmd[1], PdBatch->Mcmd[2]);
+
+} /* End PD_BATCH_Run() */
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetCnt
+**
+*/
+bool PD_BATCH_SetCnt(PD_BATCH_Class_t *PdBatch, uint32 Cnt)
+{
+
+   bool RetStatus = false;
+
+   if (Cnt <= PdBatch->Cap)
+   {
+      PdBatch->Cnt = Cnt;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End PD_BATCH_SetCnt() */
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetGains
+**
+*/
+void PD_BATCH_SetGains(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                       const BC42_CtrlGains_t *Gains)
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      PdBatch->Kp[i][Sc] = Gains->Kp[i];
+      PdBatch->Kr[i][Sc] = Gains->Kr[i];
+   }
+   PdBatch->Kunl[Sc] = Gains->Kunl;
+
+} /* End PD_BATCH_SetGains() */
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetState
+**
+*/
+void PD_BATCH_SetState(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                       const double Therr[3], const double Werr[3],
+                       const double Hvb[3], const double Bvb[3])
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      PdBatch->Therr[i][Sc] = Therr[i];
+      PdBatch->Werr[i][Sc]  = Werr[i];
+      PdBatch->Hvb[i][Sc]   = Hvb[i];
+      PdBatch->Bvb[i][Sc]   = Bvb[i];
+   }
+
+} /* End PD_BATCH_SetState() */
+
+
+/******************************************************************************
+** Function: NextArray
+**
+** Return the array at *Storage and advance *Storage past it.
+**
+*/
+static double *NextArray(uint8 **Storage, uint32 Cap)
+{
+
+   double *Array = (double *)*Storage;
+
+   *Storage += PD_BATCH_ARRAY_LEN(Cap);
+
+   return Array;
+
+} /* End NextArray() */
+
+
+/******************************************************************************
+** Function: RunMcmd
+**
+*/
+static void RunMcmd(uint32 Cnt, const double *restrict Kunl,
+                    const double *restrict Hx, const double *restrict Hy, const double *restrict Hz,
+                    const double *restrict Bx, const double *restrict By, const double *restrict Bz,
+                    double *restrict Mx, double *restrict My, double *restrict Mz)
+{
+
+   double B2, Den;
+   uint32 Sc;
+
+   for (Sc=0; Sc < Cnt; Sc++)
+   {
+      B2  = Bx[Sc]*Bx[Sc] + By[Sc]*By[Sc] + Bz[Sc]*Bz[Sc];
+      Den = (B2 > PD_BATCH_MIN_B2) ? B2 : INFINITY;
+      Mx[Sc] = Kunl[Sc]*(Hy[Sc]*Bz[Sc] - Hz[Sc]*By[Sc])/Den + 0.0;
+      My[Sc] = Kunl[Sc]*(Hz[Sc]*Bx[Sc] - Hx[Sc]*Bz[Sc])/Den + 0.0;
+      Mz[Sc] = Kunl[Sc]*(Hx[Sc]*By[Sc] - Hy[Sc]*Bx[Sc])/Den + 0.0;
+   }
+
+} /* End RunMcmd() */
+
+
+/******************************************************************************
+** Function: RunTcmd
+**
+** Compute one Tcmd component.
+**
+*/
+static void RunTcmd(uint32 Cnt, const double *restrict Kp, const double *restrict Kr,
+                    const double *restrict Therr, const double *restrict Werr,
+                    double *restrict Tcmd)
+{
+
+   uint32 Sc;
+
+   for (Sc=0; Sc < Cnt; Sc++)
+   {
+      Tcmd[Sc] = -Kp[Sc]*Therr[Sc] - Kr[Sc]*Werr[Sc];
+   }
+
+} /* End RunTcmd() */
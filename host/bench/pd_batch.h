@@ -0,0 +1,170 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Run a PD attitude control law for a batch of spacecraft
+**
+**  Notes:
+**    1. Per-spacecraft gains, attitude and rate errors, wheel momentum and
+**       magnetic field are stored in structure-of-arrays layout: one
+**       contiguous array per vector component. PD_BATCH_Run() computes
+**       Tcmd and Mcmd for every spacecraft in simple unit-stride loops
+**       the compiler can vectorize.
+**    2. This is a host benchmark kernel. The app doesn't use it. The law is
+**       the one the host BC42_LIB stand-in applies to one spacecraft:
+**          Tcmd = -Kp*therr - Kr*werr
+**          Mcmd = Kunl*(Hvb x bvb)/|bvb|^2, zero if |bvb|^2 <= 1.0E-30
+**       The float table gains are widened to double. The kernel hasn't been
+**       compared with flight BC42_LIB's control law and its results are only
+**       checked against the stand-in within a tolerance.
+**    3. Batching the app's controllers is deferred until the app runs more
+**       than one controller. The app has one controller instance so there's
+**       nothing to batch in flight software.
+**    4. The caller supplies the array storage so batches can be statically
+**       allocated. PD_BATCH_STORAGE_LEN() is the number of bytes needed for
+**       a capacity. Each array starts on a PD_BATCH_ALIGN byte boundary and
+**       is padded to a multiple of PD_BATCH_ALIGN bytes.
+**
+*/
+#ifndef _pd_batch_
+#define _pd_batch_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "bc42_lib.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PD_BATCH_ALIGN      64   /* Bytes, a cache line and the widest vector register */
+#define PD_BATCH_ARRAY_CNT  25   /* Kp[3], Kr[3], Kunl, Therr[3], Werr[3], Hvb[3], Bvb[3], Tcmd[3], Mcmd[3] */
+
+#define PD_BATCH_ARRAY_LEN(Cap)    ((((Cap)*sizeof(double)) + PD_BATCH_ALIGN - 1) & ~((size_t)PD_BATCH_ALIGN - 1))
+#define PD_BATCH_STORAGE_LEN(Cap)  (PD_BATCH_ARRAY_CNT*PD_BATCH_ARRAY_LEN(Cap) + PD_BATCH_ALIGN)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** PD_BATCH Class
+*/
+
+typedef struct
+{
+
+   uint32  Cap;                /* Spacecraft storage capacity */
+   uint32  Cnt;                /* Spacecraft run by PD_BATCH_Run() */
+
+   /*
+   ** Inputs
+   */
+
+   double  *Kp[3];
+   double  *Kr[3];
+   double  *Kunl;
+   double  *Therr[3];          /* Attitude error, rad */
+   double  *Werr[3];           /* Rate error, rad/s */
+   double  *Hvb[3];            /* Wheel momentum in the body frame, Nms */
+   double  *Bvb[3];            /* Magnetic field in the body frame, T */
+
+   /*
+   ** Outputs
+   */
+
+   double  *Tcmd[3];           /* Nm */
+   double  *Mcmd[3];           /* Am^2 */
+
+} PD_BATCH_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PD_BATCH_Constructor
+**
+** Initialize a batch to use caller supplied storage.
+**
+** Notes:
+**   1. StorageLen must be at least PD_BATCH_STORAGE_LEN(Cap). Returns false
+**      if it isn't or Cap is zero.
+**   2. The batch starts with Cap spacecraft and every input zeroed.
+**
+*/
+bool PD_BATCH_Constructor(PD_BATCH_Class_t *PdBatch, void *Storage,
+                          size_t StorageLen, uint32 Cap);
+
+
+/******************************************************************************
+** Function: PD_BATCH_GetCmd
+**
+** Copy one spacecraft's torque and magnetic dipole commands.
+**
+*/
+void PD_BATCH_GetCmd(const PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                     double Tcmd[3], double Mcmd[3]);
+
+
+/******************************************************************************
+** Function: PD_BATCH_Run
+**
+** Compute Tcmd and Mcmd for spacecraft 0 to Cnt-1.
+**
+*/
+void PD_BATCH_Run(PD_BATCH_Class_t *PdBatch);
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetCnt
+**
+** Set the number of spacecraft run by PD_BATCH_Run().
+**
+** Notes:
+**   1. Returns false if Cnt exceeds the capacity.
+**
+*/
+bool PD_BATCH_SetCnt(PD_BATCH_Class_t *PdBatch, uint32 Cnt);
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetGains
+**
+** Load one spacecraft's control gains.
+**
+*/
+void PD_BATCH_SetGains(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                       const BC42_CtrlGains_t *Gains);
+
+
+/******************************************************************************
+** Function: PD_BATCH_SetState
+**
+** Load one spacecraft's control errors, wheel momentum and magnetic field.
+**
+*/
+void PD_BATCH_SetState(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                       const double Therr[3], const double Werr[3],
+                       const double Hvb[3], const double Bvb[3]);
+
+
+#endif /* _pd_batch_ */
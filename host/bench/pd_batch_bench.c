@@ -0,0 +1,296 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Benchmark the batched PD control law against the scalar controller
+**    stand-in
+**
+**  Notes:
+**    1. For each batch size N every spacecraft gets its own pseudo-random
+**       gains and sensor data. The scalar path runs the host BC42_LIB
+**       stand-in's BC42_RunController() once per spacecraft after loading
+**       its gains and sensor data. The batched path runs PD_BATCH_Run() on the same spacecraft, with the
+**       attitude error, rate error and wheel momentum formed the way the
+**       host controller stand-in forms them.
+**    2. Every batched command is checked against the scalar command. A
+**       component passes if it differs by no more than the relative
+**       tolerance times max(1, |scalar|). The number of bit-identical
+**       components is also reported because fused multiply-add
+**       contraction can change the last bits of either path.
+**    3. Times are per spacecraft, averaged over enough repetitions that
+**       each batch size runs about 4M spacecraft. The batched time only
+**       covers PD_BATCH_Run() since batch inputs stay resident between
+**       control cycles.
+**    4. Usage: pd_batch_bench [-m max spacecraft] [-t tolerance]
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bc42_lib.h"
+#include "mono_time.h"
+#include "pd_batch.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_SC_EVALS    (4*1024*1024)   /* Spacecraft evaluations per batch size */
+#define BENCH_MIN_REPS    3
+#define BENCH_DEF_MAX_SC  65536
+#define BENCH_DEF_TOL     1.0E-12
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static double Rand(uint64 *Seed, double Min, double Max);
+static void   LoadSpacecraft(uint64 *Seed, BC42_CtrlGains_t *Gains,
+                             BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+static void   LoadBatchState(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                             const BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   uint32  MaxSc = BENCH_DEF_MAX_SC;
+   double  Tol   = BENCH_DEF_TOL;
+   uint32  N, Sc, Rep, Reps;
+   uint64  Seed = 42;
+   uint64  StartNs, ScalarNs, BatchNs;
+   uint32  BitExact, Failed;
+   double  Err, MaxErr;
+   double  Tcmd[3], Mcmd[3];
+   double *ScalarCmd;
+   void   *Storage;
+   bool    Pass = true;
+   int     Opt, i;
+
+   BC42_CtrlGains_t *Gains;
+   BC42_INTF_SensorDataMsg_Payload_t *Sensor;
+   const BC42_Ac_t *Ac;
+   PD_BATCH_Class_t PdBatch;
+
+   while ((Opt = getopt(argc, argv, "m:t:")) != -1)
+   {
+      switch (Opt)
+      {
+         case 'm': MaxSc = (uint32)strtoul(optarg, NULL, 0); break;
+         case 't': Tol   = strtod(optarg, NULL); break;
+         default:
+            fprintf(stderr, "Usage: %s [-m max spacecraft] [-t tolerance]\n", argv[0]);
+            return EXIT_FAILURE;
+      }
+   }
+
+   if (MaxSc == 0)
+   {
+      fprintf(stderr, "Max spacecraft must be greater than zero\n");
+      return EXIT_FAILURE;
+   }
+
+   Gains     = malloc(MaxSc * sizeof(BC42_CtrlGains_t));
+   Sensor    = malloc(MaxSc * sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+   ScalarCmd = malloc(MaxSc * 6 * sizeof(double));
+   Storage   = malloc(PD_BATCH_STORAGE_LEN(MaxSc));
+   if (Gains == NULL || Sensor == NULL || ScalarCmd == NULL || Storage == NULL)
+   {
+      fprintf(stderr, "Unable to allocate %u spacecraft\n", MaxSc);
+      return EXIT_FAILURE;
+   }
+
+   PD_BATCH_Constructor(&PdBatch, Storage, PD_BATCH_STORAGE_LEN(MaxSc), MaxSc);
+   for (Sc=0; Sc < MaxSc; Sc++)
+   {
+      LoadSpacecraft(&Seed, &Gains[Sc], &Sensor[Sc]);
+      PD_BATCH_SetGains(&PdBatch, Sc, &Gains[Sc]);
+      LoadBatchState(&PdBatch, Sc, &Sensor[Sc]);
+   }
+
+   printf("BC42_CTRL batched PD control law benchmark\n");
+   printf("   Tolerance: %.1e relative\n", Tol);
+   printf("   %8s %12s %12s %9s %12s %10s %s\n", "N", "Scalar ns/sc", "Batch ns/sc",
+          "Speedup", "Bit-exact", "Max err", "Check");
+
+   for (N=1; N <= MaxSc; N = (N < MaxSc && N*4 > MaxSc) ? MaxSc : N*4)
+   {
+
+      Reps = BENCH_SC_EVALS / N;
+      if (Reps < BENCH_MIN_REPS) Reps = BENCH_MIN_REPS;
+
+      StartNs = MONO_TIME_GetNs();
+      for (Rep=0; Rep < Reps; Rep++)
+      {
+         for (Sc=0; Sc < N; Sc++)
+         {
+            BC42_SetControlGains(&Gains[Sc]);
+            BC42_HOST_SetSensorData(&Sensor[Sc]);
+            BC42_RunController(&Ac);
+            for (i=0; i < 3; i++)
+            {
+               ScalarCmd[6*Sc+i]   = Ac->Tcmd[i];
+               ScalarCmd[6*Sc+3+i] = Ac->Mcmd[i];
+            }
+         }
+      }
+      ScalarNs = MONO_TIME_GetNs() - StartNs;
+
+      PD_BATCH_SetCnt(&PdBatch, N);
+      StartNs = MONO_TIME_GetNs();
+      for (Rep=0; Rep < Reps; Rep++)
+      {
+         PD_BATCH_Run(&PdBatch);
+      }
+      BatchNs = MONO_TIME_GetNs() - StartNs;
+
+      BitExact = 0;
+      Failed   = 0;
+      MaxErr   = 0.0;
+      for (Sc=0; Sc < N; Sc++)
+      {
+         PD_BATCH_GetCmd(&PdBatch, Sc, Tcmd, Mcmd);
+         for (i=0; i < 6; i++)
+         {
+            double Batch  = (i < 3) ? Tcmd[i] : Mcmd[i-3];
+            double Scalar = ScalarCmd[6*Sc+i];
+
+            if (memcmp(&Batch, &Scalar, sizeof(double)) == 0)
+            {
+               BitExact++;
+            }
+            Err = fabs(Batch - Scalar) / fmax(1.0, fabs(Scalar));
+            if (Err > MaxErr) MaxErr = Err;
+            if (!(Err <= Tol)) Failed++;
+         }
+      }
+      Pass &= (Failed == 0);
+
+      printf("   %8u %12.2f %12.2f %8.1fx %5u/%-6u %10.2e %s\n", N,
+             (double)ScalarNs / ((double)Reps*N), (double)BatchNs / ((double)Reps*N),
+             (BatchNs > 0) ? (double)ScalarNs / (double)BatchNs : 0.0,
+             BitExact, 6*N, MaxErr, (Failed == 0) ? "pass" : "FAIL");
+
+      if (N == MaxSc) break;
+
+   }
+
+   free(Storage);
+   free(ScalarCmd);
+   free(Sensor);
+   free(Gains);
+
+   return Pass ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: Rand
+**
+** Uniform value in [Min, Max) from a 64-bit LCG so runs are repeatable.
+*/
+static double Rand(uint64 *Seed, double Min, double Max)
+{
+
+   *Seed = *Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+   return Min + (Max - Min) * (double)(*Seed >> 11) / 9007199254740992.0;
+
+} /* End Rand() */
+
+
+/******************************************************************************
+** Function: LoadSpacecraft
+**
+** Pseudo-random gains and a pseudo-random attitude, rate, wheel momentum
+** and magnetic field. One spacecraft in 64 gets a zero field to exercise
+** the zero dipole case.
+*/
+static void LoadSpacecraft(uint64 *Seed, BC42_CtrlGains_t *Gains,
+                           BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   double Norm = 0.0;
+   int i;
+
+   memset(Sensor, 0, sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+
+   for (i=0; i < 3; i++)
+   {
+      Gains->Kp[i] = (float)Rand(Seed, 0.1, 10.0);
+      Gains->Kr[i] = (float)Rand(Seed, 1.0, 100.0);
+   }
+   Gains->Kunl = (float)Rand(Seed, 1.0E4, 1.0E6);
+
+   for (i=0; i < 4; i++)
+   {
+      Sensor->qbn[i] = Rand(Seed, -1.0, 1.0);
+      Norm += Sensor->qbn[i]*Sensor->qbn[i];
+   }
+   Norm = sqrt(Norm);
+   for (i=0; i < 4; i++)
+   {
+      Sensor->qbn[i] /= Norm;
+      Sensor->Hw[i] = Rand(Seed, -0.05, 0.05);
+   }
+
+   for (i=0; i < 3; i++)
+   {
+      Sensor->wbn[i] = Rand(Seed, -0.01, 0.01);
+      Sensor->bvb[i] = (Rand(Seed, 0.0, 1.0) < 1.0/64.0) ? 0.0 : Rand(Seed, -5.0E-5, 5.0E-5);
+   }
+
+   Sensor->StValid  = 1;
+   Sensor->SunValid = 1;
+
+} /* End LoadSpacecraft() */
+
+
+/******************************************************************************
+** Function: LoadBatchState
+**
+** Form the controller inputs from sensor data the same way the host
+** controller stand-in does for an inertial hold.
+*/
+static void LoadBatchState(PD_BATCH_Class_t *PdBatch, uint32 Sc,
+                           const BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   double Therr[3], Werr[3], Hvb[3], Bvb[3];
+   double Sign = (Sensor->qbn[3] < 0.0) ? -1.0 : 1.0;
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Therr[i] = 2.0*Sign*Sensor->qbn[i];
+      Werr[i]  = Sensor->wbn[i] - 0.0;
+      Hvb[i]   = Sensor->Hw[i] + Sensor->Hw[3]*0.57735;
+      Bvb[i]   = Sensor->bvb[i];
+   }
+
+   PD_BATCH_SetState(PdBatch, Sc, Therr, Werr, Hvb, Bvb);
+
+} /* End LoadBatchState() */
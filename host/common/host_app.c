@@ -0,0 +1,154 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Construct the CTRL42 object for host drivers
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "host_app.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+DEFINE_ENUM(Config,APP_CONFIG)
+
+
+/******************************************************************************
+** Function: HOST_APP_Constructor
+**
+*/
+bool HOST_APP_Constructor(HOST_APP_Class_t *HostApp, const char *TablesDir)
+{
+
+   bool RetStatus = false;
+
+   memset(HostApp, 0, sizeof(HOST_APP_Class_t));
+
+   if (TablesDir != NULL)
+   {
+      HOST_SetTablesDir(TablesDir);
+   }
+
+   if (INITBL_Constructor(&HostApp->IniTbl, HOST_APP_INI_FILE, &IniCfgEnum))
+   {
+      TBLMGR_Constructor(&HostApp->TblMgr, INITBL_GetStrConfig(&HostApp->IniTbl, CFG_APP_CFE_NAME));
+      DEBUG_LOG_Constructor(&HostApp->DebugLog, &HostApp->IniTbl);
+      CTRL42_Constructor(&HostApp->Ctrl42, &HostApp->IniTbl, &HostApp->TblMgr, &HostApp->DebugLog);
+      HostApp->FaultInjTblId = FAULT_INJ_Register(&HostApp->TblMgr,
+                                                  INITBL_GetStrConfig(&HostApp->IniTbl, CFG_FAULT_INJ_TBL_LOAD_FILE));
+      BC42_HOST_SetSensorSrc(&HostApp->Ctrl42.Sensor);
+
+      CFE_MSG_Init(CFE_MSG_PTR(HostApp->SensorDataMsg.TelemetryHeader),
+                   CFE_SB_ValueToMsgId(INITBL_GetIntConfig(&HostApp->IniTbl, CFG_BC42_INTF_SENSOR_DATA_MSG_TOPICID)),
+                   sizeof(BC42_INTF_SensorDataMsg_t));
+
+      RetStatus = HostApp->TblMgr.Tbl[HostApp->Ctrl42.Tbl.TblId].Loaded;
+      if (!RetStatus)
+      {
+         fprintf(stderr, "Control parameter table load failed\n");
+      }
+      else if (!HostApp->TblMgr.Tbl[HostApp->FaultInjTblId].Loaded)
+      {
+         fprintf(stderr, "Fault injection script load failed\n");
+         RetStatus = false;
+      }
+   }
+
+   return RetStatus;
+
+} /* End HOST_APP_Constructor() */
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadCtrlTbl
+**
+*/
+bool HOST_APP_LoadCtrlTbl(HOST_APP_Class_t *HostApp, const CTRL42_TBL_Data_t *TblData)
+{
+
+   bool RetStatus = CTRL42_TBL_LoadData(&HostApp->Ctrl42.Tbl, TblData);
+
+   CTRL42_ResetStatus(&HostApp->Ctrl42);
+   HostApp->Ctrl42.TakeSci = false;
+   HostApp->Ctrl42.TakeSciInitCycCtr  = 0;
+   HostApp->Ctrl42.TakeSciTransCycCtr = 0;
+
+   return RetStatus;
+
+} /* End HOST_APP_LoadCtrlTbl() */
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadCtrlTblFile
+**
+*/
+bool HOST_APP_LoadCtrlTblFile(HOST_APP_Class_t *HostApp, const char *Filename)
+{
+
+   const TBLMGR_Tbl_t *Tbl = &HostApp->TblMgr.Tbl[HostApp->Ctrl42.Tbl.TblId];
+
+   return (Tbl->LoadFuncPtr)(APP_C_FW_TblLoadOptions_REPLACE, Filename);
+
+} /* End HOST_APP_LoadCtrlTblFile() */
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadFaultScriptFile
+**
+*/
+bool HOST_APP_LoadFaultScriptFile(HOST_APP_Class_t *HostApp, const char *Filename)
+{
+
+   const TBLMGR_Tbl_t *Tbl = &HostApp->TblMgr.Tbl[HostApp->FaultInjTblId];
+
+   return (Tbl->LoadFuncPtr)(APP_C_FW_TblLoadOptions_REPLACE, Filename);
+
+} /* End HOST_APP_LoadFaultScriptFile() */
+
+
+/******************************************************************************
+** Function: HOST_APP_RunCycle
+**
+*/
+void HOST_APP_RunCycle(HOST_APP_Class_t *HostApp,
+                       const BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                       CFE_TIME_SysTime_t SensorTime)
+{
+
+   CFE_MSG_SequenceCount_t SeqCnt;
+
+   HostApp->SensorDataMsg.Payload = *Sensor;
+   CFE_MSG_SetMsgTime(CFE_MSG_PTR(HostApp->SensorDataMsg.TelemetryHeader), SensorTime);
+   CFE_MSG_GetSequenceCount(CFE_MSG_PTR(HostApp->SensorDataMsg.TelemetryHeader), &SeqCnt);
+   CFE_MSG_SetSequenceCount(CFE_MSG_PTR(HostApp->SensorDataMsg.TelemetryHeader), SeqCnt + 1);
+
+   HOST_SetSimTime(SensorTime);
+   BC42_HOST_SetSensorData(Sensor);
+
+   if (CTRL42_CheckSensorMsg(&HostApp->Ctrl42, &HostApp->SensorDataMsg))
+   {
+      CTRL42_Run42Fsw(&HostApp->Ctrl42, &HostApp->SensorDataMsg);
+   }
+
+} /* End HOST_APP_RunCycle() */
@@ -0,0 +1,135 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Construct the CTRL42 object for host drivers
+**
+**  Notes:
+**    1. Performs the parts of BC42_CTRL_AppMain() initialization that the
+**       controller needs: the INI table, the table manager, the debug log
+**       and the CTRL42 constructor, which loads the control parameter
+**       table, and the fault injection script.
+**    2. The INI file and parameter table are read from the host tables
+**       directory. See HOST_SetTablesDir().
+**    3. The BC42_LIB stand-in runs on the controller's ingested sensor
+**       data so injected faults reach the controller.
+**    4. The deadline watchdog task isn't created. Host drivers run cycles
+**       back to back so a wall-clock watchdog would only fire when the host
+**       preempts the driver and would make replays nondeterministic. Every
+**       actuator command claim succeeds and load shedding still runs.
+**
+*/
+#ifndef _host_app_
+#define _host_app_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "ctrl42.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define HOST_APP_INI_FILE  "/cf/bc42_ctrl_ini.json"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   INITBL_Class_t  IniTbl;
+   TBLMGR_Class_t  TblMgr;
+   DEBUG_LOG_Class_t  DebugLog;
+   CTRL42_Class_t  Ctrl42;
+   uint8           FaultInjTblId;
+
+   BC42_INTF_SensorDataMsg_t  SensorDataMsg;
+
+} HOST_APP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: HOST_APP_Constructor
+**
+** Returns false if the INI file, the control parameter table or the fault
+** injection script can't be loaded.
+*/
+bool HOST_APP_Constructor(HOST_APP_Class_t *HostApp, const char *TablesDir);
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadCtrlTbl
+**
+** Load control parameters the way a table load does and restart the
+** controller. Returns false if the controller rejects the parameters.
+** Accepted parameters are committed at the start of the next cycle.
+**
+** Notes:
+**   1. The controller's status counters, take science state and sensor
+**      check reference are returned to their constructed values so each
+**      load starts an independent run without constructing the app again.
+*/
+bool HOST_APP_LoadCtrlTbl(HOST_APP_Class_t *HostApp, const CTRL42_TBL_Data_t *TblData);
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadCtrlTblFile
+**
+** Load a control parameter table file the way a Load Table command does.
+** Returns false if the file is rejected.
+**
+*/
+bool HOST_APP_LoadCtrlTblFile(HOST_APP_Class_t *HostApp, const char *Filename);
+
+
+/******************************************************************************
+** Function: HOST_APP_LoadFaultScriptFile
+**
+** Load a fault injection script file the way a Load Table command does.
+** Returns false if the file is rejected. The script starts at the next
+** cycle.
+**
+*/
+bool HOST_APP_LoadFaultScriptFile(HOST_APP_Class_t *HostApp, const char *Filename);
+
+
+/******************************************************************************
+** Function: HOST_APP_RunCycle
+**
+** Run one control cycle on a sensor data payload time stamped with
+** SensorTime.
+**
+** Notes:
+**   1. The simulated cFE time is set to SensorTime before the cycle so
+**      sensor-to-actuator latencies are the cycle's own execution time.
+**   2. The sensor data message's sequence count is incremented each cycle
+**      the way the software bus does when the message is sent.
+*/
+void HOST_APP_RunCycle(HOST_APP_Class_t *HostApp,
+                       const BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                       CFE_TIME_SysTime_t SensorTime);
+
+
+#endif /* _host_app_ */
@@ -0,0 +1,296 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Replay a recorded sensor trace through the controller faster than
+**    real time
+**
+**  Notes:
+**    1. Each trace record is run through CTRL42_Run42Fsw() back to back
+**       with the simulated cFE time set to the record's time stamp. The
+**       actuator command and controller telemetry transmitted during the
+**       cycle are written as one REPLAY_Rec_t to the output file.
+**    2. The output file is a REPLAY_FileHdr_t followed by fixed-size
+**       records in the host's byte order. Cycles that didn't send a message
+**       have the message's Valid flag cleared, e.g. when controller
+**       telemetry is decimated.
+**    3. Speedup is the trace's sim time span divided by the wall-clock time
+**       of the replay, including trace reads and output writes.
+**    4. The trace can be a TRACE_REC sensor trace or a DEBUG_LOG file. The -s
+**       option starts the replay at the first record at or after a cFE
+**       time in seconds, using a sensor trace's chunk time index.
+**    5. The -f option loads a fault injection script before the replay
+**       starts. A cycle whose sensor message is dropped has no outputs.
+**    6. Usage: bc42_ctrl_replay [-t tables dir] [-o output file] [-s start time]
+**                               [-f fault script] [-v] trace
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "host_app.h"
+#include "mono_time.h"
+#include "sensor_trace.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define REPLAY_FILE_ID       "BC42RPLY"
+#define REPLAY_FILE_VERSION  1
+#define REPLAY_DEF_OUT_FILE  "bc42_ctrl_replay.dat"
+#define REPLAY_OUT_BUF_LEN   (1024*1024)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   char    FileId[8];          /* REPLAY_FILE_ID, not null terminated */
+   uint16  Version;
+   uint16  Spare;
+   uint32  ByteOrder;          /* 0x01020304 in the writer's byte order */
+   uint32  RecSize;
+
+} REPLAY_FileHdr_t;
+
+typedef struct
+{
+
+   uint32  Cycle;              /* Trace record index */
+   uint32  SensorSeconds;
+   uint32  SensorSubseconds;
+   uint8   ActuatorCmdValid;
+   uint8   ControllerTlmValid;
+   uint8   Spare[2];
+
+   BC42_INTF_ActuatorCmdMsg_Payload_t  ActuatorCmd;
+   BC42_CTRL_ControllerTlm_Payload_t   ControllerTlm;
+
+} REPLAY_Rec_t;
+
+typedef struct
+{
+
+   CFE_SB_MsgId_t  ActuatorCmdMid;
+   CFE_SB_MsgId_t  ControllerTlmMid;
+   REPLAY_Rec_t    Rec;
+
+} REPLAY_Capture_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static HOST_APP_Class_t      HostApp;
+static SENSOR_TRACE_Class_t  SensorTrace;
+static REPLAY_Capture_t      Capture;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   CaptureMsg(const CFE_MSG_Message_t *MsgPtr, void *UserData);
+static double TimeToSeconds(CFE_TIME_SysTime_t Time);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   const char *TablesDir = NULL;
+   const char *OutFilename = REPLAY_DEF_OUT_FILE;
+   const char *FaultFilename = NULL;
+   FILE   *OutFile;
+   REPLAY_FileHdr_t OutHdr;
+   BC42_INTF_SensorDataMsg_Payload_t Sensor;
+   CFE_TIME_SysTime_t SensorTime;
+   CFE_TIME_SysTime_t FirstTime = { 0, 0 };
+   CFE_TIME_SysTime_t LastTime  = { 0, 0 };
+   uint32  Cycle = 0;
+   uint64  StartNs;
+   double  WallSec, SimSec;
+   double  StartSec = -1.0;
+   bool    WriteErr = false;
+   int     Opt;
+
+   while ((Opt = getopt(argc, argv, "t:o:s:f:v")) != -1)
+   {
+      switch (Opt)
+      {
+         case 't': TablesDir   = optarg; break;
+         case 'o': OutFilename = optarg; break;
+         case 's': StartSec    = strtod(optarg, NULL); break;
+         case 'f': FaultFilename = optarg; break;
+         case 'v': HOST_SetEventsVerbose(true); break;
+         default:  optind = argc + 1; break;
+      }
+   }
+
+   if (optind != argc - 1)
+   {
+      fprintf(stderr, "Usage: %s [-t tables dir] [-o output file] [-s start time] [-f fault script] [-v] trace\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   if (!HOST_APP_Constructor(&HostApp, TablesDir))
+   {
+      return EXIT_FAILURE;
+   }
+
+   if (FaultFilename != NULL && !HOST_APP_LoadFaultScriptFile(&HostApp, FaultFilename))
+   {
+      fprintf(stderr, "Fault injection script %s rejected\n", FaultFilename);
+      return EXIT_FAILURE;
+   }
+
+   if (!SENSOR_TRACE_Open(&SensorTrace, argv[optind]))
+   {
+      return EXIT_FAILURE;
+   }
+
+   if (StartSec >= 0.0)
+   {
+      SensorTime.Seconds    = (uint32)StartSec;
+      SensorTime.Subseconds = (uint32)((StartSec - SensorTime.Seconds) * 4294967296.0);
+      if (!SENSOR_TRACE_Seek(&SensorTrace, SensorTime))
+      {
+         fprintf(stderr, "%s has no records at or after %.6f s\n", argv[optind], StartSec);
+         return EXIT_FAILURE;
+      }
+   }
+
+   OutFile = fopen(OutFilename, "wb");
+   if (OutFile == NULL)
+   {
+      fprintf(stderr, "Error creating %s\n", OutFilename);
+      return EXIT_FAILURE;
+   }
+   setvbuf(OutFile, NULL, _IOFBF, REPLAY_OUT_BUF_LEN);
+
+   memset(&OutHdr, 0, sizeof(OutHdr));
+   memcpy(OutHdr.FileId, REPLAY_FILE_ID, sizeof(OutHdr.FileId));
+   OutHdr.Version   = REPLAY_FILE_VERSION;
+   OutHdr.ByteOrder = 0x01020304;
+   OutHdr.RecSize   = sizeof(REPLAY_Rec_t);
+   WriteErr = (fwrite(&OutHdr, sizeof(OutHdr), 1, OutFile) != 1);
+
+   Capture.ActuatorCmdMid   = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(&HostApp.IniTbl, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID));
+   Capture.ControllerTlmMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(&HostApp.IniTbl, CFG_BC42_CTRL_CONTROLLER_TLM_TOPICID));
+   HOST_SetSbHook(CaptureMsg, &Capture);
+
+   StartNs = MONO_TIME_GetNs();
+
+   while (!WriteErr && SENSOR_TRACE_Read(&SensorTrace, &Sensor, &SensorTime))
+   {
+      if (Cycle == 0)
+      {
+         FirstTime = SensorTime;
+      }
+      LastTime = SensorTime;
+
+      memset(&Capture.Rec, 0, sizeof(REPLAY_Rec_t));
+      Capture.Rec.Cycle            = Cycle;
+      Capture.Rec.SensorSeconds    = SensorTime.Seconds;
+      Capture.Rec.SensorSubseconds = SensorTime.Subseconds;
+
+      HOST_APP_RunCycle(&HostApp, &Sensor, SensorTime);
+
+      WriteErr = (fwrite(&Capture.Rec, sizeof(REPLAY_Rec_t), 1, OutFile) != 1);
+      Cycle++;
+   }
+
+   WriteErr |= (fclose(OutFile) != 0);
+   WallSec = (double)(MONO_TIME_GetNs() - StartNs) * 1.0E-9;
+   SimSec  = TimeToSeconds(LastTime) - TimeToSeconds(FirstTime);
+
+   SENSOR_TRACE_Close(&SensorTrace);
+
+   if (WriteErr)
+   {
+      fprintf(stderr, "Error writing %s\n", OutFilename);
+   }
+
+   printf("BC42_CTRL sensor trace replay\n");
+   printf("   Trace:            %s\n", argv[optind]);
+   printf("   Output:           %s\n", OutFilename);
+   printf("   Cycles:           %u\n", Cycle);
+   printf("   Controller runs:  %u\n", HostApp.Ctrl42.CtrlExeCnt);
+   if (FaultFilename != NULL)
+   {
+      printf("   Fault script:     %s, %u entries executed, %u messages dropped\n", FaultFilename,
+             HostApp.Ctrl42.FaultInj.ExeCnt, HostApp.Ctrl42.FaultInj.DroppedCnt);
+   }
+   printf("   Sim time span:    %.3f s\n", SimSec);
+   printf("   Wall-clock time:  %.3f s (%.0f cycles/s)\n", WallSec,
+          (WallSec > 0.0) ? Cycle / WallSec : 0.0);
+   printf("   Speedup:          %.1fx real time\n", (WallSec > 0.0) ? SimSec / WallSec : 0.0);
+
+   return WriteErr ? EXIT_FAILURE : EXIT_SUCCESS;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CaptureMsg
+**
+** Software bus hook that copies the control cycle outputs into the
+** current replay record.
+*/
+static void CaptureMsg(const CFE_MSG_Message_t *MsgPtr, void *UserData)
+{
+
+   REPLAY_Capture_t *Capture = (REPLAY_Capture_t *)UserData;
+   CFE_SB_MsgId_t    MsgId;
+
+   CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+
+   if (CFE_SB_MsgId_Equal(MsgId, Capture->ActuatorCmdMid))
+   {
+      Capture->Rec.ActuatorCmd = ((const BC42_INTF_ActuatorCmdMsg_t *)MsgPtr)->Payload;
+      Capture->Rec.ActuatorCmdValid = true;
+   }
+   else if (CFE_SB_MsgId_Equal(MsgId, Capture->ControllerTlmMid))
+   {
+      Capture->Rec.ControllerTlm = ((const BC42_CTRL_ControllerTlm_t *)MsgPtr)->Payload;
+      Capture->Rec.ControllerTlmValid = true;
+   }
+
+} /* End CaptureMsg() */
+
+
+/******************************************************************************
+** Function: TimeToSeconds
+**
+*/
+static double TimeToSeconds(CFE_TIME_SysTime_t Time)
+{
+
+   return (double)Time.Seconds + (double)Time.Subseconds / 4294967296.0;
+
+} /* End TimeToSeconds() */
@@ -0,0 +1,454 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Read recorded sensor data messages for offline replay
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+
+#include "sensor_trace.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static int  CompareTime(CFE_TIME_SysTime_t A, CFE_TIME_SysTime_t B);
+static bool FindField(const DEBUG_LOG_Field_t *Field, uint16 FieldCnt, const char *Name,
+                      uint16 Type, uint16 Cnt, uint32 *Offset);
+static bool OpenDebugLog(SENSOR_TRACE_Class_t *SensorTrace);
+static bool OpenTraceRec(SENSOR_TRACE_Class_t *SensorTrace);
+static bool ReadBlock(SENSOR_TRACE_Class_t *SensorTrace);
+static bool ReadChunkHdr(SENSOR_TRACE_Class_t *SensorTrace, uint32 Chunk, TRACE_REC_ChunkHdr_t *ChunkHdr);
+static void RecTime(const SENSOR_TRACE_Class_t *SensorTrace, uint32 RecIdx, CFE_TIME_SysTime_t *Time);
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Close
+**
+*/
+void SENSOR_TRACE_Close(SENSOR_TRACE_Class_t *SensorTrace)
+{
+
+   if (SensorTrace->File != NULL)
+   {
+      fclose(SensorTrace->File);
+      SensorTrace->File = NULL;
+   }
+
+} /* End SENSOR_TRACE_Close() */
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Open
+**
+*/
+bool SENSOR_TRACE_Open(SENSOR_TRACE_Class_t *SensorTrace, const char *Filename)
+{
+
+   bool RetStatus = false;
+   CFE_FS_Header_t FsHdr;
+
+   memset(SensorTrace, 0, offsetof(SENSOR_TRACE_Class_t, Block));
+   snprintf(SensorTrace->Filename, sizeof(SensorTrace->Filename), "%s", Filename);
+
+   SensorTrace->File = fopen(Filename, "rb");
+   if (SensorTrace->File == NULL)
+   {
+      fprintf(stderr, "Error opening sensor trace %s\n", Filename);
+   }
+   else if (fread(&FsHdr, sizeof(FsHdr), 1, SensorTrace->File) != 1)
+   {
+      fprintf(stderr, "%s is too short to be a sensor trace\n", Filename);
+   }
+   else if (FsHdr.SubType == TRACE_REC_FS_SUBTYPE)
+   {
+      RetStatus = OpenTraceRec(SensorTrace);
+   }
+   else if (FsHdr.SubType == DEBUG_LOG_FS_SUBTYPE)
+   {
+      RetStatus = OpenDebugLog(SensorTrace);
+   }
+   else
+   {
+      fprintf(stderr, "%s is not a BC42_CTRL sensor trace or debug log\n", Filename);
+   }
+
+   if (RetStatus)
+   {
+      SensorTrace->DataStart = ftell(SensorTrace->File);
+   }
+   else
+   {
+      SENSOR_TRACE_Close(SensorTrace);
+   }
+
+   return RetStatus;
+
+} /* End SENSOR_TRACE_Open() */
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Read
+**
+*/
+bool SENSOR_TRACE_Read(SENSOR_TRACE_Class_t *SensorTrace,
+                       BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                       CFE_TIME_SysTime_t *SensorTime)
+{
+
+   bool RetStatus = true;
+   const uint8 *Rec;
+
+   if (SensorTrace->BlockRecIdx >= SensorTrace->BlockRecCnt)
+   {
+      RetStatus = ReadBlock(SensorTrace);
+   }
+
+   if (RetStatus)
+   {
+      Rec = &SensorTrace->Block[SensorTrace->BlockRecStart + SensorTrace->BlockRecIdx*SensorTrace->RecSize];
+      memcpy(Sensor, &Rec[SensorTrace->SensorOffset], sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+      RecTime(SensorTrace, SensorTrace->BlockRecIdx, SensorTime);
+      SensorTrace->BlockRecIdx++;
+      SensorTrace->RecCnt++;
+   }
+
+   return RetStatus;
+
+} /* End SENSOR_TRACE_Read() */
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Seek
+**
+** Notes:
+**   1. For chunked traces the search finds the last chunk whose first
+**      record isn't after StartTime. The target record is in that chunk or
+**      is the first record of the next chunk, which the scan below handles
+**      by reading on.
+*/
+bool SENSOR_TRACE_Seek(SENSOR_TRACE_Class_t *SensorTrace, CFE_TIME_SysTime_t StartTime)
+{
+
+   bool   RetStatus = false;
+   bool   Found = false;
+   uint32 Lo, Hi, Mid, ChunkCnt;
+   long   FileLen;
+   CFE_TIME_SysTime_t   Time;
+   TRACE_REC_ChunkHdr_t ChunkHdr;
+
+   if (SensorTrace->File != NULL)
+   {
+
+      if (SensorTrace->Chunked)
+      {
+         fseek(SensorTrace->File, 0, SEEK_END);
+         FileLen  = ftell(SensorTrace->File);
+         ChunkCnt = (uint32)((FileLen - SensorTrace->DataStart + SensorTrace->ChunkSize - 1) / SensorTrace->ChunkSize);
+
+         Lo = 0;
+         Hi = ChunkCnt;
+         while (Lo + 1 < Hi)
+         {
+            Mid = Lo + (Hi - Lo)/2;
+            if (ReadChunkHdr(SensorTrace, Mid, &ChunkHdr))
+            {
+               Time.Seconds    = ChunkHdr.FirstSeconds;
+               Time.Subseconds = ChunkHdr.FirstSubseconds;
+               if (CompareTime(Time, StartTime) <= 0)
+               {
+                  Lo = Mid;
+               }
+               else
+               {
+                  Hi = Mid;
+               }
+            }
+            else
+            {
+               Hi = Mid;
+            }
+         }
+         fseek(SensorTrace->File, SensorTrace->DataStart + (long)Lo*SensorTrace->ChunkSize, SEEK_SET);
+      }
+      else
+      {
+         fseek(SensorTrace->File, SensorTrace->DataStart, SEEK_SET);
+      }
+
+      SensorTrace->BlockRecCnt = 0;
+      SensorTrace->BlockRecIdx = 0;
+
+      while (!Found && ReadBlock(SensorTrace))
+      {
+         for ( ; SensorTrace->BlockRecIdx < SensorTrace->BlockRecCnt; SensorTrace->BlockRecIdx++)
+         {
+            RecTime(SensorTrace, SensorTrace->BlockRecIdx, &Time);
+            if (CompareTime(Time, StartTime) >= 0)
+            {
+               Found = true;
+               break;
+            }
+         }
+      }
+
+      RetStatus = Found;
+
+   } /* End if file open */
+
+   return RetStatus;
+
+} /* End SENSOR_TRACE_Seek() */
+
+
+/******************************************************************************
+** Function: CompareTime
+**
+*/
+static int CompareTime(CFE_TIME_SysTime_t A, CFE_TIME_SysTime_t B)
+{
+
+   if (A.Seconds != B.Seconds)
+   {
+      return (A.Seconds > B.Seconds) ? 1 : -1;
+   }
+
+   return (A.Subseconds > B.Subseconds) - (A.Subseconds < B.Subseconds);
+
+} /* End CompareTime() */
+
+
+/******************************************************************************
+** Function: FindField
+**
+*/
+static bool FindField(const DEBUG_LOG_Field_t *Field, uint16 FieldCnt, const char *Name,
+                      uint16 Type, uint16 Cnt, uint32 *Offset)
+{
+
+   bool   RetStatus = false;
+   uint16 i;
+
+   for (i=0; i < FieldCnt && !RetStatus; i++)
+   {
+      if (strncmp(Field[i].Name, Name, DEBUG_LOG_FIELD_NAME_LEN) == 0)
+      {
+         RetStatus = (Field[i].Type == Type && Field[i].Cnt == Cnt);
+         *Offset = Field[i].Offset;
+      }
+   }
+
+   return RetStatus;
+
+} /* End FindField() */
+
+
+/******************************************************************************
+** Function: OpenDebugLog
+**
+** Read and validate the debug log header that follows the cFE file header.
+*/
+static bool OpenDebugLog(SENSOR_TRACE_Class_t *SensorTrace)
+{
+
+   bool RetStatus = false;
+   DEBUG_LOG_FileHdr_t  LogHdr;
+   DEBUG_LOG_Field_t   *Field = NULL;
+   size_t FixedHdrLen = offsetof(DEBUG_LOG_FileHdr_t, Field);
+   size_t FieldLen;
+   const char *Filename = SensorTrace->Filename;
+
+   if (fread(&LogHdr, FixedHdrLen, 1, SensorTrace->File) != 1)
+   {
+      fprintf(stderr, "%s is too short to be a sensor trace\n", Filename);
+   }
+   else if (strncmp(LogHdr.FileId, DEBUG_LOG_FILE_ID, sizeof(LogHdr.FileId)) != 0)
+   {
+      fprintf(stderr, "%s is not a BC42_CTRL debug log\n", Filename);
+   }
+   else if (LogHdr.ByteOrder != 0x01020304)
+   {
+      fprintf(stderr, "%s was written with a different byte order\n", Filename);
+   }
+   else if (LogHdr.RecSize == 0 || LogHdr.RecSize > SENSOR_TRACE_BLOCK_BYTES ||
+            LogHdr.HdrSize != FixedHdrLen + LogHdr.FieldCnt*sizeof(DEBUG_LOG_Field_t))
+   {
+      fprintf(stderr, "%s has an invalid header: HdrSize %u, RecSize %u, FieldCnt %u\n",
+              Filename, LogHdr.HdrSize, LogHdr.RecSize, LogHdr.FieldCnt);
+   }
+   else
+   {
+      FieldLen = LogHdr.FieldCnt*sizeof(DEBUG_LOG_Field_t);
+      Field = malloc(FieldLen);
+      if (Field != NULL && fread(Field, FieldLen, 1, SensorTrace->File) == 1)
+      {
+         RetStatus =
+            FindField(Field, LogHdr.FieldCnt, "SensorSeconds", DEBUG_LOG_FIELD_UINT32, 1, &SensorTrace->SecondsOffset) &&
+            FindField(Field, LogHdr.FieldCnt, "SensorSubseconds", DEBUG_LOG_FIELD_UINT32, 1, &SensorTrace->SubsecondsOffset) &&
+            FindField(Field, LogHdr.FieldCnt, "Sensor", DEBUG_LOG_FIELD_BYTES,
+                      sizeof(BC42_INTF_SensorDataMsg_Payload_t), &SensorTrace->SensorOffset);
+         if (!RetStatus)
+         {
+            fprintf(stderr, "%s doesn't contain a compatible sensor data payload\n", Filename);
+         }
+         SensorTrace->RecSize = LogHdr.RecSize;
+      }
+      else
+      {
+         fprintf(stderr, "%s has a truncated field table\n", Filename);
+      }
+      free(Field);
+   }
+
+   return RetStatus;
+
+} /* End OpenDebugLog() */
+
+
+/******************************************************************************
+** Function: OpenTraceRec
+**
+** Read and validate the sensor trace header that follows the cFE file header.
+** Records must match this build's TRACE_REC_Rec_t.
+*/
+static bool OpenTraceRec(SENSOR_TRACE_Class_t *SensorTrace)
+{
+
+   bool RetStatus = false;
+   TRACE_REC_FileHdr_t TraceHdr;
+   const char *Filename = SensorTrace->Filename;
+
+   if (fread(&TraceHdr, sizeof(TraceHdr), 1, SensorTrace->File) != 1)
+   {
+      fprintf(stderr, "%s is too short to be a sensor trace\n", Filename);
+   }
+   else if (strncmp(TraceHdr.FileId, TRACE_REC_FILE_ID, sizeof(TraceHdr.FileId)) != 0)
+   {
+      fprintf(stderr, "%s is not a BC42_CTRL sensor trace\n", Filename);
+   }
+   else if (TraceHdr.ByteOrder != 0x01020304)
+   {
+      fprintf(stderr, "%s was written with a different byte order\n", Filename);
+   }
+   else if (TraceHdr.HdrSize != sizeof(TRACE_REC_FileHdr_t) ||
+            TraceHdr.RecSize != sizeof(TRACE_REC_Rec_t) ||
+            TraceHdr.ChunkHdrSize != sizeof(TRACE_REC_ChunkHdr_t) ||
+            TraceHdr.ChunkRecCnt == 0 ||
+            TraceHdr.ChunkSize != TraceHdr.ChunkHdrSize + TraceHdr.ChunkRecCnt*TraceHdr.RecSize ||
+            TraceHdr.ChunkSize > SENSOR_TRACE_BLOCK_BYTES)
+   {
+      fprintf(stderr, "%s has an incompatible header: HdrSize %u, RecSize %u, ChunkRecCnt %u\n",
+              Filename, TraceHdr.HdrSize, TraceHdr.RecSize, TraceHdr.ChunkRecCnt);
+   }
+   else
+   {
+      SensorTrace->Chunked          = true;
+      SensorTrace->ChunkSize        = TraceHdr.ChunkSize;
+      SensorTrace->ChunkHdrSize     = TraceHdr.ChunkHdrSize;
+      SensorTrace->RecSize          = TraceHdr.RecSize;
+      SensorTrace->SensorOffset     = offsetof(TRACE_REC_Rec_t, Payload);
+      SensorTrace->SecondsOffset    = offsetof(TRACE_REC_Rec_t, MsgSeconds);
+      SensorTrace->SubsecondsOffset = offsetof(TRACE_REC_Rec_t, MsgSubseconds);
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+} /* End OpenTraceRec() */
+
+
+/******************************************************************************
+** Function: ReadBlock
+**
+** Notes:
+**   1. A debug log block is as many whole records as fit. A partial record
+**      at the end of the file is ignored. It is the record the debug log
+**      child task was writing when the file was copied.
+**   2. A trace block is one chunk. A chunk with a bad sync pattern or a
+**      record count that doesn't match the bytes read ends the trace.
+*/
+static bool ReadBlock(SENSOR_TRACE_Class_t *SensorTrace)
+{
+
+   size_t RecCnt = 0;
+   size_t ReadLen;
+   const TRACE_REC_ChunkHdr_t *ChunkHdr = (const TRACE_REC_ChunkHdr_t *)SensorTrace->Block;
+
+   if (SensorTrace->File != NULL)
+   {
+      if (SensorTrace->Chunked)
+      {
+         ReadLen = fread(SensorTrace->Block, 1, SensorTrace->ChunkSize, SensorTrace->File);
+         if (ReadLen >= SensorTrace->ChunkHdrSize &&
+             memcmp(ChunkHdr->Sync, TRACE_REC_CHUNK_SYNC, sizeof(ChunkHdr->Sync)) == 0 &&
+             ChunkHdr->RecCnt <= (ReadLen - SensorTrace->ChunkHdrSize)/SensorTrace->RecSize)
+         {
+            RecCnt = ChunkHdr->RecCnt;
+         }
+         SensorTrace->BlockRecStart = SensorTrace->ChunkHdrSize;
+      }
+      else
+      {
+         RecCnt = fread(SensorTrace->Block, SensorTrace->RecSize,
+                        SENSOR_TRACE_BLOCK_BYTES/SensorTrace->RecSize, SensorTrace->File);
+         SensorTrace->BlockRecStart = 0;
+      }
+   }
+
+   SensorTrace->BlockRecCnt = (uint32)RecCnt;
+   SensorTrace->BlockRecIdx = 0;
+
+   return (RecCnt > 0);
+
+} /* End ReadBlock() */
+
+
+/******************************************************************************
+** Function: ReadChunkHdr
+**
+*/
+static bool ReadChunkHdr(SENSOR_TRACE_Class_t *SensorTrace, uint32 Chunk, TRACE_REC_ChunkHdr_t *ChunkHdr)
+{
+
+   return (fseek(SensorTrace->File, SensorTrace->DataStart + (long)Chunk*SensorTrace->ChunkSize, SEEK_SET) == 0 &&
+           fread(ChunkHdr, sizeof(TRACE_REC_ChunkHdr_t), 1, SensorTrace->File) == 1 &&
+           memcmp(ChunkHdr->Sync, TRACE_REC_CHUNK_SYNC, sizeof(ChunkHdr->Sync)) == 0 &&
+           ChunkHdr->RecCnt > 0);
+
+} /* End ReadChunkHdr() */
+
+
+/******************************************************************************
+** Function: RecTime
+**
+*/
+static void RecTime(const SENSOR_TRACE_Class_t *SensorTrace, uint32 RecIdx, CFE_TIME_SysTime_t *Time)
+{
+
+   const uint8 *Rec = &SensorTrace->Block[SensorTrace->BlockRecStart + RecIdx*SensorTrace->RecSize];
+
+   memcpy(&Time->Seconds, &Rec[SensorTrace->SecondsOffset], sizeof(uint32));
+   memcpy(&Time->Subseconds, &Rec[SensorTrace->SubsecondsOffset], sizeof(uint32));
+
+} /* End RecTime() */
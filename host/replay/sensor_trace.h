@@ -0,0 +1,122 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Read recorded sensor data messages for offline replay
+**
+**  Notes:
+**    1. Two file types are sensor traces and are identified by their cFE
+**       file header subtype:
+**       - TRACE_REC files hold every sensor data message the app received.
+**         Records are read a chunk at a time.
+**       - DEBUG_LOG files hold the raw sensor data message payload and time
+**         stamp of each control cycle. The reader locates those fields using
+**         the file's field table rather than DEBUG_LOG_Rec_t so logs written
+**         by other versions can be read as long as the sensor payload
+**         definition matches.
+**    2. Records are read in blocks so file I/O doesn't dominate replays.
+**    3. SENSOR_TRACE_Seek() binary searches the chunk headers of a TRACE_REC
+**       file so only O(log n) chunk headers are read. DEBUG_LOG files have
+**       no index and are scanned.
+**
+*/
+#ifndef _sensor_trace_
+#define _sensor_trace_
+
+/*
+** Includes
+*/
+
+#include "debug_log.h"
+#include "trace_rec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SENSOR_TRACE_BLOCK_BYTES  (64*1024)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   FILE   *File;
+   char    Filename[OS_MAX_PATH_LEN*2];
+
+   bool    Chunked;          /* TRACE_REC file */
+   long    DataStart;        /* File offset of the first record or chunk */
+   uint32  ChunkSize;
+   uint32  ChunkHdrSize;
+
+   uint32  RecSize;
+   uint32  SensorOffset;
+   uint32  SecondsOffset;
+   uint32  SubsecondsOffset;
+
+   uint32  BlockRecCnt;
+   uint32  BlockRecIdx;
+   uint32  BlockRecStart;    /* Offset of the first record in Block */
+   uint64  RecCnt;           /* Records returned */
+
+   uint8   Block[SENSOR_TRACE_BLOCK_BYTES];
+
+} SENSOR_TRACE_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Open
+**
+** Open a trace file and validate its header. Errors are reported on stderr.
+*/
+bool SENSOR_TRACE_Open(SENSOR_TRACE_Class_t *SensorTrace, const char *Filename);
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Read
+**
+** Load the next recorded sensor data payload and time stamp. Returns false
+** at the end of the trace.
+*/
+bool SENSOR_TRACE_Read(SENSOR_TRACE_Class_t *SensorTrace,
+                       BC42_INTF_SensorDataMsg_Payload_t *Sensor,
+                       CFE_TIME_SysTime_t *SensorTime);
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Seek
+**
+** Position the trace so the next read returns the first record with a time
+** stamp at or after StartTime. Assumes time stamps are nondecreasing.
+** Returns false if no such record exists.
+*/
+bool SENSOR_TRACE_Seek(SENSOR_TRACE_Class_t *SensorTrace, CFE_TIME_SysTime_t StartTime);
+
+
+/******************************************************************************
+** Function: SENSOR_TRACE_Close
+**
+*/
+void SENSOR_TRACE_Close(SENSOR_TRACE_Class_t *SensorTrace);
+
+
+#endif /* _sensor_trace_ */
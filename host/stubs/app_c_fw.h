@@ -0,0 +1,463 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the cFE, OSAL, PSP and app_c_fw interfaces used by
+**    the BC42_CTRL flight sources
+**
+**  Notes:
+**    1. Only the subset of each API referenced by fsw/src is declared. The
+**       signatures mirror the real cFS APIs so the flight sources compile
+**       unchanged.
+**    2. Software bus traffic is not routed anywhere. Transmitted messages are
+**       counted and handed to an optional host hook so drivers can capture
+**       actuator commands and telemetry.
+**    3. Software bus buffer allocations are counted so benchmarks can
+**       report allocations on the control path.
+**    4. Paths starting with /cf/ are mapped to host directories. Reads are
+**       served from the tables directory, using the cpu1_ prefixed name
+**       when the plain name doesn't exist. Writes go to the output
+**       directory.
+*/
+#ifndef _app_c_fw_
+#define _app_c_fw_
+
+/*
+** Includes
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+
+/******************************************************************************
+** Common types
+*/
+
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef uint64_t  uint64;
+typedef int8_t    int8;
+typedef int16_t   int16;
+typedef int32_t   int32;
+typedef int64_t   int64;
+
+typedef int32     CFE_Status_t;
+typedef uint32    osal_id_t;
+typedef char      os_err_name_t[35];
+
+#define CFE_SUCCESS                0
+#define OS_SUCCESS                 0
+#define OS_ERROR                  (-1)
+#define OS_MAX_PATH_LEN           64
+#define OS_MAX_API_NAME           20
+#define OS_OBJECT_ID_UNDEFINED    ((osal_id_t)0)
+
+#define OS_FILE_FLAG_NONE          0x00
+#define OS_FILE_FLAG_CREATE        0x01
+#define OS_FILE_FLAG_TRUNCATE      0x02
+#define OS_READ_ONLY               0
+#define OS_WRITE_ONLY              1
+#define OS_READ_WRITE              2
+#define OS_SEEK_SET                0
+#define OS_SEEK_CUR                1
+#define OS_SEEK_END                2
+
+
+/******************************************************************************
+** cFE ES
+*/
+
+typedef void (*CFE_ES_ChildTaskMainFuncPtr_t)(void);
+
+enum
+{
+   CFE_ES_RunStatus_UNDEFINED = 0,
+   CFE_ES_RunStatus_APP_RUN   = 1,
+   CFE_ES_RunStatus_APP_EXIT  = 2,
+   CFE_ES_RunStatus_APP_ERROR = 3
+};
+
+bool  CFE_ES_RunLoop(uint32 *RunStatus);
+void  CFE_ES_ExitApp(uint32 ExitStatus);
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...);
+void  CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit);
+
+#define CFE_ES_PerfLogEntry(id) (CFE_ES_PerfLogAdd(id, 0))
+#define CFE_ES_PerfLogExit(id)  (CFE_ES_PerfLogAdd(id, 1))
+
+
+/******************************************************************************
+** cFE EVS
+*/
+
+#define CFE_EVS_EventType_DEBUG        1
+#define CFE_EVS_EventType_INFORMATION  2
+#define CFE_EVS_EventType_ERROR        3
+#define CFE_EVS_EventType_CRITICAL     4
+#define CFE_EVS_DEBUG                  CFE_EVS_EventType_DEBUG
+#define CFE_EVS_INFORMATION            CFE_EVS_EventType_INFORMATION
+
+#define CFE_EVS_EventFilter_BINARY  0
+#define CFE_EVS_NO_FILTER           0x0000
+#define CFE_EVS_FIRST_64_STOP       0xFFC0
+
+typedef struct
+{
+   uint16 EventID;
+   uint16 Mask;
+} CFE_EVS_BinFilter_t;
+
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme);
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...);
+
+
+/******************************************************************************
+** cFE TIME
+*/
+
+typedef struct
+{
+   uint32 Seconds;
+   uint32 Subseconds;
+} CFE_TIME_SysTime_t;
+
+typedef enum
+{
+   CFE_TIME_A_LT_B = -1,
+   CFE_TIME_EQUAL  =  0,
+   CFE_TIME_A_GT_B =  1
+} CFE_TIME_Compare_t;
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+CFE_TIME_SysTime_t CFE_TIME_Add(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2);
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2);
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB);
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds);
+uint32 CFE_TIME_Micro2SubSecs(uint32 MicroSeconds);
+
+
+/******************************************************************************
+** cFE MSG & SB
+*/
+
+typedef uint32  CFE_SB_MsgId_t;
+typedef uint32  CFE_SB_PipeId_t;
+typedef uint16  CFE_MSG_SequenceCount_t;
+typedef uint8   CFE_MSG_FcnCode_t;
+typedef size_t  CFE_MSG_Size_t;
+
+typedef struct
+{
+   uint8   StreamId[2];
+   uint16  Sequence;
+   uint16  Length;
+   CFE_SB_MsgId_t  MsgId;
+   CFE_MSG_Size_t  Size;
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+   CFE_MSG_Message_t   Msg;
+   CFE_MSG_FcnCode_t   FunctionCode;
+   uint8               Checksum;
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+   CFE_MSG_Message_t   Msg;
+   CFE_TIME_SysTime_t  Time;
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+   CFE_MSG_Message_t  Msg;
+   long long int      LongInt;
+   long double        LongDouble;
+} CFE_SB_Buffer_t;
+
+#define CFE_MSG_PTR(shdr)        (&((shdr).Msg))
+#define CFE_SB_INVALID_MSG_ID    ((CFE_SB_MsgId_t)0)
+#define CFE_SB_PEND_FOREVER      (-1)
+#define CFE_SB_POLL              0
+#define CFE_SB_NO_MESSAGE        ((CFE_Status_t)0xca00000e)
+#define CFE_SB_TIME_OUT          ((CFE_Status_t)0xca000001)
+#define CFE_SB_BUF_ALOC_ERR      ((CFE_Status_t)0xca00000c)
+
+#define CFE_SB_ValueToMsgId(v)       ((CFE_SB_MsgId_t)(v))
+#define CFE_SB_MsgIdToValue(m)       ((uint32)(m))
+#define CFE_SB_MsgId_Equal(m1,m2)    ((m1) == (m2))
+
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+CFE_Status_t CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time);
+CFE_Status_t CFE_MSG_SetMsgTime(CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t NewTime);
+CFE_Status_t CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt);
+CFE_Status_t CFE_MSG_SetSequenceCount(CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t SeqCnt);
+
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount);
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize);
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr);
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** PSP & OSAL
+*/
+
+void  CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size);
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode);
+int32 OS_close(osal_id_t filedes);
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes);
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes);
+int32 OS_lseek(osal_id_t filedes, int32 offset, uint32 whence);
+int32 OS_GetErrorName(int32 error_num, os_err_name_t *err_name);
+int32 OS_TaskDelay(uint32 millisecond);
+
+#define CFE_FS_HDR_DESC_MAX_LEN 32
+typedef struct
+{
+   uint32  ContentType;
+   uint32  SubType;
+   uint32  Length;
+   uint32  SpacecraftID;
+   uint32  ProcessorID;
+   uint32  ApplicationID;
+   uint32  TimeSeconds;
+   uint32  TimeSubSeconds;
+   char    Description[CFE_FS_HDR_DESC_MAX_LEN];
+} CFE_FS_Header_t;
+void  CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType);
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr);
+
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_BinSemGive(osal_id_t sem_id);
+int32 OS_BinSemTake(osal_id_t sem_id);
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs);
+#define OS_SEM_TIMEOUT  (-36)
+
+
+/******************************************************************************
+** app_c_fw: INITBL
+*/
+
+#define APP_C_FW_CFS_ERROR      ((int32)(-1))
+#define APP_C_FW_APP_BASE_EID   100
+
+typedef enum
+{
+   INITBL_CFG_INT = 0,
+   INITBL_CFG_STR = 1
+} INITBL_CfgType_t;
+
+typedef struct
+{
+   uint16            Cnt;
+   const char      **Name;
+   const char      **Type;
+} INITBL_CfgEnum_t;
+
+#define INITBL_CFG_ENUM_NAME(name,type)  name,
+#define INITBL_CFG_ENUM_STR(name,type)   #name,
+#define INITBL_CFG_ENUM_TYPE(name,type)  #type,
+
+#define DECLARE_ENUM(EnumType,ENUM_DEF) \
+   typedef enum { EnumType##_START = 0, ENUM_DEF(INITBL_CFG_ENUM_NAME) EnumType##_END } EnumType##_t;
+
+#define DEFINE_ENUM(EnumType,ENUM_DEF) \
+   static const char *IniCfgName[] = { "START", ENUM_DEF(INITBL_CFG_ENUM_STR) "END" }; \
+   static const char *IniCfgType[] = { "START", ENUM_DEF(INITBL_CFG_ENUM_TYPE) "END" }; \
+   static INITBL_CfgEnum_t IniCfgEnum = { EnumType##_END, IniCfgName, IniCfgType };
+
+#define INITBL_MAX_CFG_ITEMS  128
+#define INITBL_MAX_STR_LEN    OS_MAX_PATH_LEN
+
+typedef struct
+{
+   const INITBL_CfgEnum_t *CfgEnum;
+   uint32  IntVal[INITBL_MAX_CFG_ITEMS];
+   char    StrVal[INITBL_MAX_CFG_ITEMS][INITBL_MAX_STR_LEN];
+} INITBL_Class_t;
+
+bool        INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile, INITBL_CfgEnum_t *CfgEnum);
+uint32      INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+const char *INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param);
+
+
+/******************************************************************************
+** app_c_fw: CMDMGR
+*/
+
+typedef bool (*CMDMGR_CmdFuncPtr_t)(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+
+#define CMDMGR_CMD_FUNC_TOTAL  64
+
+typedef struct
+{
+   uint16  ValidCmdCnt;
+   uint16  InvalidCmdCnt;
+   void                *ObjDataPtr[CMDMGR_CMD_FUNC_TOTAL];
+   CMDMGR_CmdFuncPtr_t  FuncPtr[CMDMGR_CMD_FUNC_TOTAL];
+   uint16               UserDataLen[CMDMGR_CMD_FUNC_TOTAL];
+} CMDMGR_Class_t;
+
+#define CMDMGR_PAYLOAD_PTR(MsgPtr,CmdType) (&(((const CmdType *)(MsgPtr))->Payload))
+
+void CMDMGR_Constructor(CMDMGR_Class_t *CmdMgr);
+bool CMDMGR_RegisterFunc(CMDMGR_Class_t *CmdMgr, uint16 FuncCode, void *ObjDataPtr,
+                         CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen);
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t *CmdMgr, const CFE_MSG_Message_t *MsgPtr);
+void CMDMGR_ResetStatus(CMDMGR_Class_t *CmdMgr);
+
+
+/******************************************************************************
+** app_c_fw: CHILDMGR
+*/
+
+typedef struct CHILDMGR_Class CHILDMGR_Class_t;
+
+typedef bool (*CHILDMGR_CmdFuncPtr_t)(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+typedef bool (*CHILDMGR_TaskCallback_t)(CHILDMGR_Class_t *ChildMgr);
+
+typedef struct
+{
+   const char *TaskName;
+   uint32      StackSize;
+   uint32      Priority;
+   uint32      PerfId;
+} CHILDMGR_TaskInit_t;
+
+struct CHILDMGR_Class
+{
+   uint16  ValidCmdCnt;
+   uint16  InvalidCmdCnt;
+   uint32  TaskId;
+   CHILDMGR_TaskCallback_t  TaskCallback;
+   void                    *ObjDataPtr[CMDMGR_CMD_FUNC_TOTAL];
+   CHILDMGR_CmdFuncPtr_t    FuncPtr[CMDMGR_CMD_FUNC_TOTAL];
+};
+
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t *ChildMgr, CFE_ES_ChildTaskMainFuncPtr_t ChildTaskMainFunc,
+                           CHILDMGR_TaskCallback_t ChildTaskCallback, CHILDMGR_TaskInit_t *TaskInit);
+bool  CHILDMGR_RegisterFunc(CHILDMGR_Class_t *ChildMgr, uint16 FuncCode, void *ObjDataPtr,
+                            CHILDMGR_CmdFuncPtr_t ObjFuncPtr);
+bool  CHILDMGR_InvokeChildCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+void  CHILDMGR_ResetStatus(CHILDMGR_Class_t *ChildMgr);
+void  ChildMgr_TaskMainCallback(void);
+void  ChildMgr_TaskMainCmdDispatch(void);
+
+
+/******************************************************************************
+** app_c_fw: CJSON
+*/
+
+typedef enum
+{
+   JSONString = 0,
+   JSONNumber = 1
+} JSONTypes_t;
+
+typedef struct
+{
+   const char *Key;
+   size_t      KeyLen;
+} CJSON_Query_t;
+
+typedef struct
+{
+   void          *TblData;
+   size_t         TblDataLen;
+   bool           Updated;
+   JSONTypes_t    Type;
+   bool           Float;
+   CJSON_Query_t  Query;
+} CJSON_Obj_t;
+
+typedef bool (*CJSON_LoadJsonData_t)(size_t JsonFileLen);
+
+bool   CJSON_ProcessFile(const char *Filename, char *JsonBuf, size_t MaxJsonFileChar,
+                         CJSON_LoadJsonData_t LoadJsonData);
+size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, char *Buf, size_t BufLen);
+
+
+/******************************************************************************
+** app_c_fw: TBLMGR
+*/
+
+#include "app_c_fw_eds_typedefs.h"
+
+typedef bool (*TBLMGR_LoadTblFuncPtr_t)(APP_C_FW_TblLoadOptions_Enum_t LoadType, const char *Filename);
+typedef bool (*TBLMGR_DumpTblFuncPtr_t)(osal_id_t FileHandle);
+
+#define TBLMGR_MAX_TBL_PER_APP  4
+
+typedef struct
+{
+   uint8    Id;
+   bool     Loaded;
+   uint8    LastAction;
+   uint8    LastActionStatus;
+   char     Name[OS_MAX_API_NAME];
+   char     Filename[OS_MAX_PATH_LEN];
+   TBLMGR_LoadTblFuncPtr_t  LoadFuncPtr;
+   TBLMGR_DumpTblFuncPtr_t  DumpFuncPtr;
+} TBLMGR_Tbl_t;
+
+typedef struct
+{
+   uint8         NextAvailableId;
+   uint8         LastActionTblId;
+   TBLMGR_Tbl_t  Tbl[TBLMGR_MAX_TBL_PER_APP];
+} TBLMGR_Class_t;
+
+void  TBLMGR_Constructor(TBLMGR_Class_t *TblMgr, const char *AppName);
+uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t *TblMgr, const char *TblName,
+                                TBLMGR_LoadTblFuncPtr_t LoadFuncPtr,
+                                TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, const char *TblFilename);
+bool  TBLMGR_LoadTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+bool  TBLMGR_DumpTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+const TBLMGR_Tbl_t *TBLMGR_GetLastTblStatus(TBLMGR_Class_t *TblMgr);
+void  TBLMGR_ResetStatus(TBLMGR_Class_t *TblMgr);
+
+
+/******************************************************************************
+** Host hooks
+**
+** Not part of any cFS API. Host drivers use these to observe the software
+** bus and the heap behaviour of the code under test.
+*/
+
+typedef void (*HOST_SbHook_t)(const CFE_MSG_Message_t *MsgPtr, void *UserData);
+
+void   HOST_SetSbHook(HOST_SbHook_t Hook, void *UserData);
+void   HOST_SetSimTime(CFE_TIME_SysTime_t SimTime);
+void   HOST_SetEventsVerbose(bool Verbose);
+void   HOST_SetTablesDir(const char *TablesDir);
+void   HOST_SetOutputDir(const char *OutputDir);
+uint64 HOST_GetSbAllocCnt(void);
+uint64 HOST_GetSbTransmitCnt(void);
+uint64 HOST_GetEventCnt(void);
+
+#endif /* _app_c_fw_ */
@@ -0,0 +1,49 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the app_c_fw EDS generated type definitions
+**
+**  Notes:
+**    1. Only the types referenced by the BC42_CTRL sources are defined.
+*/
+#ifndef _app_c_fw_eds_typedefs_
+#define _app_c_fw_eds_typedefs_
+
+typedef uint8 APP_C_FW_BooleanUint8_t;
+
+typedef enum
+{
+   APP_C_FW_TblLoadOptions_REPLACE = 1,
+   APP_C_FW_TblLoadOptions_UPDATE  = 2
+} APP_C_FW_TblLoadOptions_Enum_t;
+
+typedef enum
+{
+   APP_C_FW_TblActions_UNDEF    = 0,
+   APP_C_FW_TblActions_REGISTER = 1,
+   APP_C_FW_TblActions_LOAD     = 2,
+   APP_C_FW_TblActions_DUMP     = 3
+} APP_C_FW_TblActions_Enum_t;
+
+typedef enum
+{
+   APP_C_FW_TblActionStatus_UNDEF   = 0,
+   APP_C_FW_TblActionStatus_INVALID = 1,
+   APP_C_FW_TblActionStatus_VALID   = 2
+} APP_C_FW_TblActionStatus_Enum_t;
+
+typedef char BASE_TYPES_PathName_t[OS_MAX_PATH_LEN];
+
+#endif /* _app_c_fw_eds_typedefs_ */
@@ -0,0 +1,513 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host implementation of the app_c_fw subset in app_c_fw.h
+**
+**  Notes:
+**    1. The JSON handling only supports the flat "config" object of the
+**       INI file and the two level "object.member" queries used by JSON
+**       tables. It is not a general JSON parser.
+**    2. Child tasks are detached pthreads that call the task callback until
+**       it returns false, like ChildMgr_TaskMainCallback().
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <ctype.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "app_c_fw.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static const char *FindKey(const char *Buf, const char *BufEnd, const char *Key, size_t KeyLen);
+static const char *FindMatchingBrace(const char *Obj, const char *BufEnd);
+static void *ChildTask(void *ChildMgr);
+static bool ReadFile(const char *Filename, char *Buf, size_t BufLen, size_t *FileLen);
+
+
+/******************************************************************************
+** INITBL
+*/
+
+bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile, INITBL_CfgEnum_t *CfgEnum)
+{
+
+   static char JsonBuf[16384];
+   bool   RetStatus = true;
+   size_t FileLen;
+   uint16 i;
+   const char *Value;
+   const char *ValueEnd;
+
+   memset(IniTbl, 0, sizeof(INITBL_Class_t));
+   IniTbl->CfgEnum = CfgEnum;
+
+   if (ReadFile(IniFile, JsonBuf, sizeof(JsonBuf), &FileLen))
+   {
+      for (i=1; i < CfgEnum->Cnt; i++)
+      {
+         Value = FindKey(JsonBuf, JsonBuf + FileLen, CfgEnum->Name[i], strlen(CfgEnum->Name[i]));
+         if (Value == NULL)
+         {
+            fprintf(stderr, "INITBL: %s missing from %s\n", CfgEnum->Name[i], IniFile);
+            RetStatus = false;
+         }
+         else if (*Value == '"')
+         {
+            ValueEnd = strchr(Value + 1, '"');
+            snprintf(IniTbl->StrVal[i], INITBL_MAX_STR_LEN, "%.*s", (int)(ValueEnd - Value - 1), Value + 1);
+         }
+         else
+         {
+            IniTbl->IntVal[i] = (uint32)strtoul(Value, NULL, 0);
+         }
+      }
+   }
+   else
+   {
+      fprintf(stderr, "INITBL: Error reading %s\n", IniFile);
+      RetStatus = false;
+   }
+
+   return RetStatus;
+
+}
+
+uint32 INITBL_GetIntConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   return IniTbl->IntVal[Param];
+}
+
+const char *INITBL_GetStrConfig(const INITBL_Class_t *IniTbl, uint16 Param)
+{
+   return IniTbl->StrVal[Param];
+}
+
+
+/******************************************************************************
+** CMDMGR
+*/
+
+void CMDMGR_Constructor(CMDMGR_Class_t *CmdMgr)
+{
+   memset(CmdMgr, 0, sizeof(CMDMGR_Class_t));
+}
+
+bool CMDMGR_RegisterFunc(CMDMGR_Class_t *CmdMgr, uint16 FuncCode, void *ObjDataPtr,
+                         CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen)
+{
+
+   bool RetStatus = false;
+
+   if (FuncCode < CMDMGR_CMD_FUNC_TOTAL)
+   {
+      CmdMgr->ObjDataPtr[FuncCode]  = ObjDataPtr;
+      CmdMgr->FuncPtr[FuncCode]     = ObjFuncPtr;
+      CmdMgr->UserDataLen[FuncCode] = UserDataLen;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+}
+
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t *CmdMgr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool RetStatus = false;
+   CFE_MSG_FcnCode_t FuncCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode;
+
+   if (FuncCode < CMDMGR_CMD_FUNC_TOTAL && CmdMgr->FuncPtr[FuncCode] != NULL)
+   {
+      RetStatus = CmdMgr->FuncPtr[FuncCode](CmdMgr->ObjDataPtr[FuncCode], MsgPtr);
+   }
+
+   if (RetStatus)
+   {
+      CmdMgr->ValidCmdCnt++;
+   }
+   else
+   {
+      CmdMgr->InvalidCmdCnt++;
+   }
+
+   return RetStatus;
+
+}
+
+void CMDMGR_ResetStatus(CMDMGR_Class_t *CmdMgr)
+{
+   CmdMgr->ValidCmdCnt   = 0;
+   CmdMgr->InvalidCmdCnt = 0;
+}
+
+
+/******************************************************************************
+** CHILDMGR
+*/
+
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t *ChildMgr, CFE_ES_ChildTaskMainFuncPtr_t ChildTaskMainFunc,
+                           CHILDMGR_TaskCallback_t ChildTaskCallback, CHILDMGR_TaskInit_t *TaskInit)
+{
+
+   int32     RetStatus = CFE_SUCCESS;
+   pthread_t Thread;
+
+   memset(ChildMgr, 0, sizeof(CHILDMGR_Class_t));
+   ChildMgr->TaskCallback = ChildTaskCallback;
+
+   if (ChildTaskCallback != NULL)
+   {
+      if (pthread_create(&Thread, NULL, ChildTask, ChildMgr) == 0)
+      {
+         pthread_detach(Thread);
+         ChildMgr->TaskId = 1;
+      }
+      else
+      {
+         RetStatus = APP_C_FW_CFS_ERROR;
+      }
+   }
+
+   return RetStatus;
+
+}
+
+bool CHILDMGR_RegisterFunc(CHILDMGR_Class_t *ChildMgr, uint16 FuncCode, void *ObjDataPtr,
+                           CHILDMGR_CmdFuncPtr_t ObjFuncPtr)
+{
+
+   bool RetStatus = false;
+
+   if (FuncCode < CMDMGR_CMD_FUNC_TOTAL)
+   {
+      ChildMgr->ObjDataPtr[FuncCode] = ObjDataPtr;
+      ChildMgr->FuncPtr[FuncCode]    = ObjFuncPtr;
+      RetStatus = true;
+   }
+
+   return RetStatus;
+
+}
+
+/*
+** Commands run synchronously on the caller's thread
+*/
+bool CHILDMGR_InvokeChildCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   bool RetStatus = false;
+   CHILDMGR_Class_t *ChildMgr = (CHILDMGR_Class_t *)ObjDataPtr;
+   CFE_MSG_FcnCode_t FuncCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode;
+
+   if (FuncCode < CMDMGR_CMD_FUNC_TOTAL && ChildMgr->FuncPtr[FuncCode] != NULL)
+   {
+      RetStatus = ChildMgr->FuncPtr[FuncCode](ChildMgr->ObjDataPtr[FuncCode], MsgPtr);
+   }
+
+   if (RetStatus)
+   {
+      ChildMgr->ValidCmdCnt++;
+   }
+   else
+   {
+      ChildMgr->InvalidCmdCnt++;
+   }
+
+   return RetStatus;
+
+}
+
+void CHILDMGR_ResetStatus(CHILDMGR_Class_t *ChildMgr)
+{
+   ChildMgr->ValidCmdCnt   = 0;
+   ChildMgr->InvalidCmdCnt = 0;
+}
+
+void ChildMgr_TaskMainCallback(void)
+{
+}
+
+void ChildMgr_TaskMainCmdDispatch(void)
+{
+}
+
+
+/******************************************************************************
+** CJSON
+*/
+
+bool CJSON_ProcessFile(const char *Filename, char *JsonBuf, size_t MaxJsonFileChar,
+                       CJSON_LoadJsonData_t LoadJsonData)
+{
+
+   bool   RetStatus = false;
+   size_t FileLen;
+
+   if (ReadFile(Filename, JsonBuf, MaxJsonFileChar, &FileLen) && FileLen > 0)
+   {
+      RetStatus = LoadJsonData(FileLen);
+   }
+
+   return RetStatus;
+
+}
+
+size_t CJSON_LoadObjArray(CJSON_Obj_t *Obj, size_t ObjCnt, char *Buf, size_t BufLen)
+{
+
+   size_t ObjLoadCnt = 0;
+   size_t i;
+   const char *BufEnd = Buf + BufLen;
+   const char *Dot;
+   const char *Parent;
+   const char *ParentEnd;
+   const char *Value;
+   double Number;
+
+   for (i=0; i < ObjCnt; i++)
+   {
+      Obj[i].Updated = false;
+      Dot = memchr(Obj[i].Query.Key, '.', Obj[i].Query.KeyLen);
+      if (Dot != NULL)
+      {
+         Parent = FindKey(Buf, BufEnd, Obj[i].Query.Key, Dot - Obj[i].Query.Key);
+         Value  = NULL;
+         if (Parent != NULL && *Parent == '{')
+         {
+            ParentEnd = FindMatchingBrace(Parent, BufEnd);
+            Value = FindKey(Parent, ParentEnd, Dot + 1, Obj[i].Query.KeyLen - (Dot - Obj[i].Query.Key) - 1);
+         }
+      }
+      else
+      {
+         Value = FindKey(Buf, BufEnd, Obj[i].Query.Key, Obj[i].Query.KeyLen);
+      }
+
+      if (Value != NULL)
+      {
+         if (Obj[i].Type == JSONString && *Value == '"')
+         {
+            const char *StrEnd = strchr(Value + 1, '"');
+            snprintf((char *)Obj[i].TblData, Obj[i].TblDataLen, "%.*s", (int)(StrEnd - Value - 1), Value + 1);
+            Obj[i].Updated = true;
+         }
+         else if (Obj[i].Type == JSONNumber)
+         {
+            Number = strtod(Value, NULL);
+            if (Obj[i].Float)
+            {
+               if (Obj[i].TblDataLen == sizeof(double))
+               {
+                  *(double *)Obj[i].TblData = Number;
+               }
+               else
+               {
+                  *(float *)Obj[i].TblData = (float)Number;
+               }
+            }
+            else
+            {
+               switch (Obj[i].TblDataLen)
+               {
+                  case 1: *(uint8 *)Obj[i].TblData  = (uint8)Number;  break;
+                  case 2: *(uint16 *)Obj[i].TblData = (uint16)Number; break;
+                  default: *(uint32 *)Obj[i].TblData = (uint32)Number; break;
+               }
+            }
+            Obj[i].Updated = true;
+         }
+      }
+
+      if (Obj[i].Updated)
+      {
+         ObjLoadCnt++;
+      }
+   }
+
+   return ObjLoadCnt;
+
+}
+
+
+/******************************************************************************
+** TBLMGR
+*/
+
+void TBLMGR_Constructor(TBLMGR_Class_t *TblMgr, const char *AppName)
+{
+   memset(TblMgr, 0, sizeof(TBLMGR_Class_t));
+}
+
+uint8 TBLMGR_RegisterTblWithDef(TBLMGR_Class_t *TblMgr, const char *TblName,
+                                TBLMGR_LoadTblFuncPtr_t LoadFuncPtr,
+                                TBLMGR_DumpTblFuncPtr_t DumpFuncPtr, const char *TblFilename)
+{
+
+   uint8 TblId = TblMgr->NextAvailableId;
+   TBLMGR_Tbl_t *Tbl;
+
+   if (TblId < TBLMGR_MAX_TBL_PER_APP)
+   {
+      Tbl = &TblMgr->Tbl[TblId];
+      Tbl->Id          = TblId;
+      Tbl->LoadFuncPtr = LoadFuncPtr;
+      Tbl->DumpFuncPtr = DumpFuncPtr;
+      snprintf(Tbl->Name, sizeof(Tbl->Name), "%s", TblName);
+      snprintf(Tbl->Filename, sizeof(Tbl->Filename), "%s", TblFilename);
+
+      Tbl->LastAction = APP_C_FW_TblActions_LOAD;
+      Tbl->Loaded = LoadFuncPtr(APP_C_FW_TblLoadOptions_REPLACE, TblFilename);
+      Tbl->LastActionStatus = Tbl->Loaded ? APP_C_FW_TblActionStatus_VALID : APP_C_FW_TblActionStatus_INVALID;
+
+      TblMgr->LastActionTblId = TblId;
+      TblMgr->NextAvailableId++;
+   }
+
+   return TblId;
+
+}
+
+bool TBLMGR_LoadTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   return false;
+}
+
+bool TBLMGR_DumpTblCmd(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+   return false;
+}
+
+const TBLMGR_Tbl_t *TBLMGR_GetLastTblStatus(TBLMGR_Class_t *TblMgr)
+{
+   return &TblMgr->Tbl[TblMgr->LastActionTblId];
+}
+
+void TBLMGR_ResetStatus(TBLMGR_Class_t *TblMgr)
+{
+}
+
+
+/******************************************************************************
+** Function: FindKey
+**
+** Return a pointer to the first non-space character of the value of "Key"
+** within [Buf, BufEnd), NULL if not found.
+*/
+static const char *FindKey(const char *Buf, const char *BufEnd, const char *Key, size_t KeyLen)
+{
+
+   const char *Value = NULL;
+   const char *Ptr   = Buf;
+
+   while (Value == NULL && Ptr != NULL && Ptr < BufEnd)
+   {
+      Ptr = memchr(Ptr, '"', BufEnd - Ptr);
+      if (Ptr != NULL)
+      {
+         if ((Ptr + KeyLen + 1) < BufEnd && strncmp(Ptr + 1, Key, KeyLen) == 0 && Ptr[KeyLen+1] == '"')
+         {
+            Ptr += KeyLen + 2;
+            while (Ptr < BufEnd && isspace((unsigned char)*Ptr)) Ptr++;
+            if (Ptr < BufEnd && *Ptr == ':')
+            {
+               Ptr++;
+               while (Ptr < BufEnd && isspace((unsigned char)*Ptr)) Ptr++;
+               Value = Ptr;
+            }
+         }
+         else
+         {
+            Ptr++;
+         }
+      }
+   }
+
+   return Value;
+
+}
+
+
+/******************************************************************************
+** Function: FindMatchingBrace
+**
+*/
+static const char *FindMatchingBrace(const char *Obj, const char *BufEnd)
+{
+
+   int Depth = 0;
+   const char *Ptr;
+
+   for (Ptr = Obj; Ptr < BufEnd; Ptr++)
+   {
+      if (*Ptr == '{') Depth++;
+      if (*Ptr == '}' && --Depth == 0) break;
+   }
+
+   return Ptr;
+
+}
+
+
+/******************************************************************************
+** Function: ChildTask
+**
+*/
+static void *ChildTask(void *ChildMgrPtr)
+{
+
+   CHILDMGR_Class_t *ChildMgr = (CHILDMGR_Class_t *)ChildMgrPtr;
+
+   while (ChildMgr->TaskCallback(ChildMgr));
+
+   return NULL;
+
+}
+
+
+/******************************************************************************
+** Function: ReadFile
+**
+*/
+static bool ReadFile(const char *Filename, char *Buf, size_t BufLen, size_t *FileLen)
+{
+
+   bool  RetStatus = false;
+   int32 ReadLen;
+   osal_id_t FileHandle;
+
+   if (OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_NONE, OS_READ_ONLY) == OS_SUCCESS)
+   {
+      ReadLen = OS_read(FileHandle, Buf, BufLen - 1);
+      OS_close(FileHandle);
+      if (ReadLen >= 0)
+      {
+         *FileLen = (size_t)ReadLen;
+         Buf[*FileLen] = '\0';
+         RetStatus = true;
+      }
+   }
+
+   return RetStatus;
+
+}
@@ -0,0 +1,40 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the BC42_CTRL EDS generated command codes
+**
+**  Notes:
+**    1. Must be kept consistent with eds/bc42_ctrl.xml.
+*/
+#ifndef _bc42_ctrl_eds_cc_
+#define _bc42_ctrl_eds_cc_
+
+#define BC42_CTRL_NOOP_CC                   0
+#define BC42_CTRL_RESET_CC                  1
+#define BC42_CTRL_LOAD_TBL_CC               2
+#define BC42_CTRL_DUMP_TBL_CC               3
+#define BC42_CTRL_SEND_CTRL_GAINS_TLM_CC   10
+#define BC42_CTRL_SET_CTRL_MODE_CC         11
+#define BC42_CTRL_SET_BOOL_OVR_STATE_CC    12
+#define BC42_CTRL_SET_WHEEL_TARGET_MOM_CC  13
+#define BC42_CTRL_ENABLE_DEBUG_LOG_CC      14
+#define BC42_CTRL_DISABLE_DEBUG_LOG_CC     15
+#define BC42_CTRL_RESET_LATENCY_STATS_CC   16
+#define BC42_CTRL_SEND_TIMING_TLM_CC       17
+#define BC42_CTRL_SET_CTRL_TLM_DECIM_CC    18
+#define BC42_CTRL_START_SENSOR_TRACE_CC    19
+#define BC42_CTRL_STOP_SENSOR_TRACE_CC     20
+
+#endif /* _bc42_ctrl_eds_cc_ */
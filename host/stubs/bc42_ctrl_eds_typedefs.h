@@ -0,0 +1,293 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the BC42_CTRL EDS generated type definitions
+**
+**  Notes:
+**    1. Must be kept consistent with eds/bc42_ctrl.xml. Names follow the
+**       EDS tool's <PACKAGE>_<Name>_t generation rules.
+*/
+#ifndef _bc42_ctrl_eds_typedefs_
+#define _bc42_ctrl_eds_typedefs_
+
+#include "app_c_fw.h"
+
+/*
+** Enumerations
+*/
+
+typedef enum
+{
+   BC42_CTRL_Bool42Id_Sun_VALID = 0,
+   BC42_CTRL_Bool42Id_St_VALID  = 1,
+   BC42_CTRL_Bool42Id_Gps_VALID = 2,
+   BC42_CTRL_Bool42Id_COUNT     = 3
+} BC42_CTRL_Bool42Id_Enum_t;
+#define BC42_CTRL_Bool42Id_Enum_t_MIN  BC42_CTRL_Bool42Id_Sun_VALID
+#define BC42_CTRL_Bool42Id_Enum_t_MAX  BC42_CTRL_Bool42Id_COUNT
+
+typedef enum
+{
+   BC42_CTRL_Bool42State_USE_SIM = 0,
+   BC42_CTRL_Bool42State_TRUE    = 1,
+   BC42_CTRL_Bool42State_FALSE   = 2,
+   BC42_CTRL_Bool42State_COUNT   = 3
+} BC42_CTRL_Bool42State_Enum_t;
+#define BC42_CTRL_Bool42State_Enum_t_MIN  BC42_CTRL_Bool42State_USE_SIM
+#define BC42_CTRL_Bool42State_Enum_t_MAX  BC42_CTRL_Bool42State_COUNT
+
+typedef enum
+{
+   BC42_CTRL_ControlMode_SAFE          = 0,
+   BC42_CTRL_ControlMode_SUN_POINT     = 1,
+   BC42_CTRL_ControlMode_INERTIAL_HOLD = 2,
+   BC42_CTRL_ControlMode_SCIENCE       = 3,
+   BC42_CTRL_ControlMode_COUNT         = 4
+} BC42_CTRL_ControlMode_Enum_t;
+#define BC42_CTRL_ControlMode_Enum_t_MIN  BC42_CTRL_ControlMode_SAFE
+#define BC42_CTRL_ControlMode_Enum_t_MAX  BC42_CTRL_ControlMode_COUNT
+
+typedef enum
+{
+   BC42_CTRL_SensorBacklogPolicy_PROCESS_ALL     = 0,
+   BC42_CTRL_SensorBacklogPolicy_NEWEST_ONLY     = 1,
+   BC42_CTRL_SensorBacklogPolicy_BOUNDED_CATCHUP = 2
+} BC42_CTRL_SensorBacklogPolicy_Enum_t;
+#define BC42_CTRL_SensorBacklogPolicy_Enum_t_MIN  BC42_CTRL_SensorBacklogPolicy_PROCESS_ALL
+#define BC42_CTRL_SensorBacklogPolicy_Enum_t_MAX  BC42_CTRL_SensorBacklogPolicy_BOUNDED_CATCHUP
+
+typedef enum
+{
+   BC42_CTRL_TblId_CONTROLLER = 0
+} BC42_CTRL_TblId_Enum_t;
+
+typedef float  BC42_CTRL_Vec3F_t[3];
+typedef double BC42_CTRL_Vec3D_t[3];
+typedef float  BC42_CTRL_Vec4F_t[4];
+typedef double BC42_CTRL_Vec4D_t[4];
+typedef uint32 BC42_CTRL_LatencyBins_t[16];
+
+
+/*
+** Command payloads
+*/
+
+typedef struct
+{
+   uint16                          Id;
+   APP_C_FW_TblLoadOptions_Enum_t  Type;
+   BASE_TYPES_PathName_t           Filename;
+} BC42_CTRL_LoadTbl_CmdPayload_t;
+
+typedef struct
+{
+   uint16                 Id;
+   BASE_TYPES_PathName_t  Filename;
+} BC42_CTRL_DumpTbl_CmdPayload_t;
+
+typedef struct
+{
+   uint8  NewMode;
+} BC42_CTRL_SetCtrlMode_CmdPayload_t;
+
+typedef struct
+{
+   uint8  Id;
+   uint8  State;
+} BC42_CTRL_SetBoolOvrState_CmdPayload_t;
+
+typedef struct
+{
+   BC42_CTRL_Vec4F_t  Wheel;
+} BC42_CTRL_SetWheelTargetMom_CmdPayload_t;
+
+
+/*
+** Telemetry payloads
+*/
+
+typedef struct
+{
+   uint16  ValidCmdCnt;
+   uint16  InvalidCmdCnt;
+   uint8   LastTblAction;
+   uint8   LastTblActionStatus;
+   uint32  ControlExecutionCnt;
+   uint8   ControlMode;
+   uint16  ModeTransitionCnt;
+   uint16  ModeRejectedCnt;
+   uint8   OverrideSunValid;
+   uint32  OverrideSetMask;
+   uint32  OverrideClearMask;
+   uint32  FaultExeCnt;
+   uint32  FaultDropCnt;
+   uint32  DeadlineMissCnt;
+   uint32  DeadlineLateCmdCnt;
+   uint32  ShedCycleCnt;
+   uint8   ShedLevel;
+   uint8   SensorBacklogPolicy;
+   uint32  SensorDroppedCnt;
+   uint32  SensorCoalescedCnt;
+   uint32  SensorDuplicateCnt;
+   uint32  SensorOutOfOrderCnt;
+   uint32  SensorStaleCnt;
+   uint32  SensorMissingCnt;
+   uint16  SensorLastGap;
+   uint32  SensorResyncCnt;
+   uint16  CtrlTlmDecim;
+} BC42_CTRL_StatusTlm_Payload_t;
+
+typedef struct
+{
+   BC42_CTRL_Vec3D_t  wbn;
+   BC42_CTRL_Vec3D_t  wln;
+   BC42_CTRL_Vec4D_t  qbr;
+   BC42_CTRL_Vec3D_t  therr;
+   BC42_CTRL_Vec3D_t  werr;
+   BC42_CTRL_Vec3D_t  Hvb;
+   BC42_CTRL_Vec3D_t  svb;
+   BC42_CTRL_Vec3D_t  Tcmd;
+   BC42_CTRL_Vec3D_t  Mcmd;
+   double  SaGcmd;
+   uint8   GpsValid;
+   uint8   StValid;
+   uint8   SunValid;
+   uint8   TakeSci;
+} BC42_CTRL_ControllerTlm_Payload_t;
+
+typedef struct
+{
+   BC42_CTRL_Vec3F_t  Kp;
+   BC42_CTRL_Vec3F_t  Kr;
+   float              Kunl;
+} BC42_CTRL_ControlGainsTlm_Payload_t;
+
+
+typedef struct
+{
+   BC42_CTRL_Vec3D_t  Mean;
+   BC42_CTRL_Vec3D_t  Min;
+   BC42_CTRL_Vec3D_t  Max;
+} BC42_CTRL_Vec3Stats_t;
+
+typedef struct
+{
+   uint16  DecimFactor;
+} BC42_CTRL_SetCtrlTlmDecim_CmdPayload_t;
+
+typedef struct
+{
+   BASE_TYPES_PathName_t  Filename;
+} BC42_CTRL_StartSensorTrace_CmdPayload_t;
+
+typedef struct
+{
+   uint16  DecimFactor;
+   uint16  SampleCnt;
+   BC42_CTRL_Vec3Stats_t  therr;
+   BC42_CTRL_Vec3Stats_t  werr;
+   BC42_CTRL_Vec3Stats_t  Tcmd;
+   BC42_CTRL_Vec3Stats_t  Hvb;
+} BC42_CTRL_ControllerStatsTlm_Payload_t;
+
+typedef struct
+{
+   uint32  Seconds;
+   uint32  Subseconds;
+   uint32  Period;
+   int32   Jitter;
+   uint32  PrevExeTime;
+} BC42_CTRL_PeriodEvent_t;
+
+typedef BC42_CTRL_PeriodEvent_t BC42_CTRL_PeriodEvents_t[4];
+
+typedef struct
+{
+   uint32  NominalPeriod;
+   uint32  PeriodCnt;
+   uint32  MinPeriod;
+   uint32  MaxPeriod;
+   uint32  MeanPeriod;
+   uint32  MaxJitter;
+   uint32  OverrunCnt;
+   uint32  MissedCycleCnt;
+   uint32  WorstCnt;
+   BC42_CTRL_PeriodEvents_t  Worst;
+} BC42_CTRL_PeriodTlm_Payload_t;
+
+typedef struct
+{
+   uint32  Cnt;
+   uint32  Min;
+   uint32  Max;
+   uint32  Mean;
+} BC42_CTRL_PhaseTiming_t;
+
+typedef struct
+{
+   BC42_CTRL_PhaseTiming_t  Cycle;
+   BC42_CTRL_PhaseTiming_t  RunController;
+   BC42_CTRL_PhaseTiming_t  SendControllerTlm;
+   BC42_CTRL_PhaseTiming_t  SendActuatorCmd;
+   BC42_CTRL_PhaseTiming_t  SetTakeSci;
+} BC42_CTRL_TimingTlm_Payload_t;
+
+typedef struct
+{
+   uint32  SampleCnt;
+   uint32  InvalidCnt;
+   uint32  Min;
+   uint32  Max;
+   uint32  Mean;
+   uint32  P99;
+   uint32  BinWidth;
+   BC42_CTRL_LatencyBins_t  Bin;
+} BC42_CTRL_LatencyTlm_Payload_t;
+
+
+/*
+** Command packets
+*/
+
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_Noop_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_Reset_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_LoadTbl_CmdPayload_t Payload; } BC42_CTRL_LoadTbl_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_DumpTbl_CmdPayload_t Payload; } BC42_CTRL_DumpTbl_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_SendCtrlGainsTlm_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_SetCtrlMode_CmdPayload_t Payload; } BC42_CTRL_SetCtrlMode_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_SetBoolOvrState_CmdPayload_t Payload; } BC42_CTRL_SetBoolOvrState_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_SetWheelTargetMom_CmdPayload_t Payload; } BC42_CTRL_SetWheelTargetMom_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_EnableDebugLog_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_DisableDebugLog_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_ResetLatencyStats_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_SendTimingTlm_t;
+
+
+/*
+** Telemetry packets
+*/
+
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_StatusTlm_Payload_t       Payload; } BC42_CTRL_StatusTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_ControllerTlm_Payload_t   Payload; } BC42_CTRL_ControllerTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_ControlGainsTlm_Payload_t Payload; } BC42_CTRL_ControlGainsTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_LatencyTlm_Payload_t      Payload; } BC42_CTRL_LatencyTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_TimingTlm_Payload_t       Payload; } BC42_CTRL_TimingTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_PeriodTlm_Payload_t       Payload; } BC42_CTRL_PeriodTlm_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; BC42_CTRL_ControllerStatsTlm_Payload_t Payload; } BC42_CTRL_ControllerStatsTlm_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_SetCtrlTlmDecim_CmdPayload_t Payload; } BC42_CTRL_SetCtrlTlmDecim_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; BC42_CTRL_StartSensorTrace_CmdPayload_t Payload; } BC42_CTRL_StartSensorTrace_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; } BC42_CTRL_StopSensorTrace_t;
+
+#endif /* _bc42_ctrl_eds_typedefs_ */
@@ -0,0 +1,60 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the BC42_INTF EDS generated message definitions
+**
+**  Notes:
+**    1. The flight sources treat the sensor payload as opaque. The fields
+**       below only need to carry what the host bc42_lib stand-in consumes.
+*/
+#ifndef _bc42_intf_eds_typedefs_
+#define _bc42_intf_eds_typedefs_
+
+#include "app_c_fw.h"
+
+typedef struct
+{
+   double  Time;
+   double  qbn[4];
+   double  wbn[3];
+   double  svb[3];
+   double  bvb[3];
+   double  Hw[4];
+   uint8   GpsValid;
+   uint8   StValid;
+   uint8   SunValid;
+   uint8   Spare;
+} BC42_INTF_SensorDataMsg_Payload_t;
+
+typedef struct
+{
+   CFE_MSG_TelemetryHeader_t          TelemetryHeader;
+   BC42_INTF_SensorDataMsg_Payload_t  Payload;
+} BC42_INTF_SensorDataMsg_t;
+
+typedef struct
+{
+   double  Tcmd[3];
+   double  Mcmd[3];
+   double  SaGcmd;
+} BC42_INTF_ActuatorCmdMsg_Payload_t;
+
+typedef struct
+{
+   CFE_MSG_TelemetryHeader_t           TelemetryHeader;
+   BC42_INTF_ActuatorCmdMsg_Payload_t  Payload;
+} BC42_INTF_ActuatorCmdMsg_t;
+
+#endif /* _bc42_intf_eds_typedefs_ */
@@ -0,0 +1,92 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the BC42_LIB controller interface
+**
+**  Notes:
+**    1. BC42_Ac_t only contains the 42 AcType members referenced by the
+**       BC42_CTRL sources plus the sensor inputs the stand-in law needs.
+**    2. The stand-in runs 42's PD attitude law with momentum unloading on
+**       the sensor data most recently passed to BC42_HOST_SetSensorData(),
+**       or on the sensor data at the address passed to
+**       BC42_HOST_SetSensorSrc() when one is set. A source lets host
+**       drivers run the controller on the controller's ingested sensor
+**       data, e.g. with injected faults.
+**       It is deterministic and cheap enough that adapter overhead remains
+**       visible in benchmarks.
+*/
+#ifndef _bc42_lib_
+#define _bc42_lib_
+
+#include "app_c_fw.h"
+#include "bc42_intf_eds_typedefs.h"
+
+typedef struct
+{
+   double therr[3];
+   double werr[3];
+   double Tcmd[3];
+} BC42_AcCmgCtrl_t;
+
+typedef struct
+{
+   double AngRate[3];
+} BC42_AcGCmd_t;
+
+typedef struct
+{
+   BC42_AcGCmd_t GCmd;
+} BC42_AcG_t;
+
+typedef struct
+{
+   double  Time;
+   double  qbn[4];
+   double  qbr[4];
+   double  wbn[3];
+   double  wln[3];
+   double  svb[3];
+   double  bvb[3];
+   double  Hvb[3];
+   double  Tcmd[3];
+   double  Mcmd[3];
+   long    StValid;
+   long    SunValid;
+   BC42_AcCmgCtrl_t CmgCtrl;
+   BC42_AcG_t       G[1];
+} BC42_Ac_t;
+
+typedef struct
+{
+   float Kp[3];
+   float Kr[3];
+   float Kunl;
+} BC42_CtrlGains_t;
+
+typedef struct
+{
+   BC42_Ac_t         Ac;
+   BC42_CtrlGains_t  Gains;
+} BC42_Class_t;
+
+bool BC42_RunController(const BC42_Ac_t **Ac42);
+void BC42_SetControlGains(const BC42_CtrlGains_t *CtrlGains);
+void BC42_GetControlGains(BC42_CtrlGains_t *CtrlGains);
+
+/* Host only */
+void BC42_HOST_SetSensorData(const BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+void BC42_HOST_SetSensorSrc(const BC42_INTF_SensorDataMsg_Payload_t *SensorSrc);
+
+#endif /* _bc42_lib_ */
@@ -0,0 +1,149 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host stand-in for the BC42_LIB controller
+**
+**  Notes:
+**    1. Holds an inertial reference attitude, so qbr = qbn and wln = 0.
+**    2. The attitude error is twice the vector part of qbr with the sign
+**       chosen for the short rotation, as in 42's AcFsw().
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "bc42_lib.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static BC42_Class_t Bc42;
+static BC42_INTF_SensorDataMsg_Payload_t Sensor;
+static const BC42_INTF_SensorDataMsg_Payload_t *SensorSrc = NULL;
+
+
+/******************************************************************************
+** Function: BC42_HOST_SetSensorData
+**
+*/
+void BC42_HOST_SetSensorData(const BC42_INTF_SensorDataMsg_Payload_t *SensorData)
+{
+
+   Sensor = *SensorData;
+
+} /* End BC42_HOST_SetSensorData() */
+
+
+/******************************************************************************
+** Function: BC42_HOST_SetSensorSrc
+**
+*/
+void BC42_HOST_SetSensorSrc(const BC42_INTF_SensorDataMsg_Payload_t *Src)
+{
+
+   SensorSrc = Src;
+
+} /* End BC42_HOST_SetSensorSrc() */
+
+
+/******************************************************************************
+** Function: BC42_RunController
+**
+*/
+bool BC42_RunController(const BC42_Ac_t **Ac42)
+{
+
+   BC42_Ac_t *Ac = &Bc42.Ac;
+   double Sign;
+   double HxB[3];
+   double B2;
+   int i;
+
+   if (SensorSrc != NULL)
+   {
+      Sensor = *SensorSrc;
+   }
+
+   Ac->Time = Sensor.Time;
+   for (i=0; i < 4; i++)
+   {
+      Ac->qbn[i] = Sensor.qbn[i];
+      Ac->qbr[i] = Sensor.qbn[i];
+   }
+
+   Ac->Hvb[0] = Sensor.Hw[0] + Sensor.Hw[3]*0.57735;
+   Ac->Hvb[1] = Sensor.Hw[1] + Sensor.Hw[3]*0.57735;
+   Ac->Hvb[2] = Sensor.Hw[2] + Sensor.Hw[3]*0.57735;
+
+   Sign = (Ac->qbr[3] < 0.0) ? -1.0 : 1.0;
+   for (i=0; i < 3; i++)
+   {
+      Ac->wbn[i] = Sensor.wbn[i];
+      Ac->wln[i] = 0.0;
+      Ac->svb[i] = Sensor.svb[i];
+      Ac->bvb[i] = Sensor.bvb[i];
+
+      Ac->CmgCtrl.therr[i] = 2.0*Sign*Ac->qbr[i];
+      Ac->CmgCtrl.werr[i]  = Ac->wbn[i] - Ac->wln[i];
+      Ac->Tcmd[i] = -Bc42.Gains.Kp[i]*Ac->CmgCtrl.therr[i] - Bc42.Gains.Kr[i]*Ac->CmgCtrl.werr[i];
+      Ac->CmgCtrl.Tcmd[i] = Ac->Tcmd[i];
+   }
+
+   HxB[0] = Ac->Hvb[1]*Ac->bvb[2] - Ac->Hvb[2]*Ac->bvb[1];
+   HxB[1] = Ac->Hvb[2]*Ac->bvb[0] - Ac->Hvb[0]*Ac->bvb[2];
+   HxB[2] = Ac->Hvb[0]*Ac->bvb[1] - Ac->Hvb[1]*Ac->bvb[0];
+   B2 = Ac->bvb[0]*Ac->bvb[0] + Ac->bvb[1]*Ac->bvb[1] + Ac->bvb[2]*Ac->bvb[2];
+   for (i=0; i < 3; i++)
+   {
+      Ac->Mcmd[i] = (B2 > 1.0E-30) ? Bc42.Gains.Kunl*HxB[i]/B2 : 0.0;
+   }
+
+   Ac->StValid  = Sensor.StValid;
+   Ac->SunValid = Sensor.SunValid;
+   Ac->G[0].GCmd.AngRate[0] = 0.0;
+
+   *Ac42 = Ac;
+
+   return true;
+
+} /* End BC42_RunController() */
+
+
+/******************************************************************************
+** Function: BC42_GetControlGains
+**
+*/
+void BC42_GetControlGains(BC42_CtrlGains_t *CtrlGains)
+{
+
+   *CtrlGains = Bc42.Gains;
+
+} /* End BC42_GetControlGains() */
+
+
+/******************************************************************************
+** Function: BC42_SetControlGains
+**
+*/
+void BC42_SetControlGains(const BC42_CtrlGains_t *CtrlGains)
+{
+
+   Bc42.Gains = *CtrlGains;
+
+} /* End BC42_SetControlGains() */
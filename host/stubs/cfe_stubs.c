@@ -0,0 +1,682 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host implementation of the cFE, OSAL and PSP subset in app_c_fw.h
+**
+**  Notes:
+**    1. cFE time is the simulation time set by the driver plus the
+**       monotonic time elapsed since it was set, so time stamps taken
+**       during a control cycle advance like they do on a target.
+**    2. Software bus buffers come from a small static pool, like the cFE
+**       SB memory pool, so buffer allocations never touch the heap.
+**
+*/
+
+/*
+** Includes
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app_c_fw.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SB_BUF_CNT      8
+#define SB_BUF_SIZE     4096
+#define CF_PREFIX       "/cf/"
+
+#ifndef HOST_TABLES_DIR
+#define HOST_TABLES_DIR "."
+#endif
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+   bool             InUse;
+   CFE_SB_Buffer_t  Buf;
+   uint8            Data[SB_BUF_SIZE];
+} SbBuf_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void MapPath(const char *Path, bool Write, char *HostPath, size_t HostPathLen);
+static uint64 MonoNs(void);
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static HOST_SbHook_t SbHook = NULL;
+static void  *SbHookData = NULL;
+static bool   EventsVerbose = false;
+static uint64 EventCnt = 0;
+static uint64 SbAllocCnt = 0;
+static uint64 SbTransmitCnt = 0;
+
+static CFE_TIME_SysTime_t SimTime;
+static uint64 SimTimeSetNs = 0;
+
+static char TablesDir[OS_MAX_PATH_LEN] = HOST_TABLES_DIR;
+static char OutputDir[OS_MAX_PATH_LEN] = ".";
+
+static SbBuf_t SbBufPool[SB_BUF_CNT];
+
+static pthread_mutex_t EventMutex = PTHREAD_MUTEX_INITIALIZER;
+
+
+/******************************************************************************
+** Host hooks
+*/
+
+void HOST_SetSbHook(HOST_SbHook_t Hook, void *UserData)
+{
+   SbHook     = Hook;
+   SbHookData = UserData;
+}
+
+void HOST_SetSimTime(CFE_TIME_SysTime_t NewSimTime)
+{
+   SimTime      = NewSimTime;
+   SimTimeSetNs = MonoNs();
+}
+
+void HOST_SetEventsVerbose(bool Verbose)
+{
+   EventsVerbose = Verbose;
+}
+
+void HOST_SetTablesDir(const char *Dir)
+{
+   snprintf(TablesDir, sizeof(TablesDir), "%s", Dir);
+}
+
+void HOST_SetOutputDir(const char *Dir)
+{
+   snprintf(OutputDir, sizeof(OutputDir), "%s", Dir);
+}
+
+uint64 HOST_GetSbAllocCnt(void)
+{
+   return SbAllocCnt;
+}
+
+uint64 HOST_GetSbTransmitCnt(void)
+{
+   return SbTransmitCnt;
+}
+
+uint64 HOST_GetEventCnt(void)
+{
+   return __atomic_load_n(&EventCnt, __ATOMIC_RELAXED);
+}
+
+
+/******************************************************************************
+** cFE ES
+*/
+
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+   return (*RunStatus == CFE_ES_RunStatus_APP_RUN);
+}
+
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+   exit((ExitStatus == CFE_ES_RunStatus_APP_EXIT) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+   va_list Args;
+
+   va_start(Args, SpecStringPtr);
+   vfprintf(stderr, SpecStringPtr, Args);
+   va_end(Args);
+
+   return CFE_SUCCESS;
+}
+
+void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
+{
+   (void)Marker;
+   (void)EntryExit;
+}
+
+
+/******************************************************************************
+** cFE EVS
+*/
+
+CFE_Status_t CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme)
+{
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+
+   va_list Args;
+
+   __atomic_add_fetch(&EventCnt, 1, __ATOMIC_RELAXED);
+
+   if (EventsVerbose || EventType >= CFE_EVS_EventType_ERROR)
+   {
+      pthread_mutex_lock(&EventMutex);
+      fprintf(stderr, "EVS %3u %u: ", EventID, EventType);
+      va_start(Args, Spec);
+      vfprintf(stderr, Spec, Args);
+      va_end(Args);
+      fputc('\n', stderr);
+      pthread_mutex_unlock(&EventMutex);
+   }
+
+   return CFE_SUCCESS;
+
+}
+
+
+/******************************************************************************
+** cFE TIME
+** - Subseconds are 2^-32 seconds
+*/
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+
+   uint64 ElapsedUs = (MonoNs() - SimTimeSetNs) / 1000;
+   CFE_TIME_SysTime_t Elapsed;
+
+   Elapsed.Seconds    = (uint32)(ElapsedUs / 1000000);
+   Elapsed.Subseconds = CFE_TIME_Micro2SubSecs((uint32)(ElapsedUs % 1000000));
+
+   return CFE_TIME_Add(SimTime, Elapsed);
+
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Add(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+
+   CFE_TIME_SysTime_t Result;
+
+   Result.Subseconds = Time1.Subseconds + Time2.Subseconds;
+   Result.Seconds    = Time1.Seconds + Time2.Seconds + ((Result.Subseconds < Time1.Subseconds) ? 1 : 0);
+
+   return Result;
+
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Subtract(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+
+   CFE_TIME_SysTime_t Result;
+
+   Result.Subseconds = Time1.Subseconds - Time2.Subseconds;
+   Result.Seconds    = Time1.Seconds - Time2.Seconds - ((Result.Subseconds > Time1.Subseconds) ? 1 : 0);
+
+   return Result;
+
+}
+
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB)
+{
+
+   CFE_TIME_Compare_t Result = CFE_TIME_EQUAL;
+
+   if (TimeA.Seconds != TimeB.Seconds)
+   {
+      Result = (TimeA.Seconds < TimeB.Seconds) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+   }
+   else if (TimeA.Subseconds != TimeB.Subseconds)
+   {
+      Result = (TimeA.Subseconds < TimeB.Subseconds) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+   }
+
+   return Result;
+
+}
+
+uint32 CFE_TIME_Sub2MicroSecs(uint32 SubSeconds)
+{
+   return (uint32)(((uint64)SubSeconds * 1000000) >> 32);
+}
+
+uint32 CFE_TIME_Micro2SubSecs(uint32 MicroSeconds)
+{
+   return (MicroSeconds >= 1000000) ? 0xFFFFFFFF : (uint32)(((uint64)MicroSeconds << 32) / 1000000);
+}
+
+
+/******************************************************************************
+** cFE MSG
+*/
+
+CFE_Status_t CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+
+   memset(MsgPtr, 0, Size);
+   MsgPtr->MsgId = MsgId;
+   MsgPtr->Size  = Size;
+
+   return CFE_SUCCESS;
+
+}
+
+CFE_Status_t CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+   *MsgId = MsgPtr->MsgId;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+   *Size = MsgPtr->Size;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetMsgTime(const CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t *Time)
+{
+   *Time = ((const CFE_MSG_TelemetryHeader_t *)MsgPtr)->Time;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetMsgTime(CFE_MSG_Message_t *MsgPtr, CFE_TIME_SysTime_t NewTime)
+{
+   ((CFE_MSG_TelemetryHeader_t *)MsgPtr)->Time = NewTime;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_GetSequenceCount(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t *SeqCnt)
+{
+   *SeqCnt = MsgPtr->Sequence;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_MSG_SetSequenceCount(CFE_MSG_Message_t *MsgPtr, CFE_MSG_SequenceCount_t SeqCnt)
+{
+   MsgPtr->Sequence = SeqCnt & 0x3FFF;
+   return CFE_SUCCESS;
+}
+
+
+/******************************************************************************
+** cFE SB
+** - Pipes never contain messages. Drivers call the app functions directly.
+*/
+
+CFE_Status_t CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+   static CFE_SB_PipeId_t NextPipeId = 1;
+   *PipeIdPtr = NextPipeId++;
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+   return CFE_SUCCESS;
+}
+
+CFE_Status_t CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+   *BufPtr = NULL;
+   return (TimeOut == CFE_SB_POLL) ? CFE_SB_NO_MESSAGE : CFE_SB_TIME_OUT;
+}
+
+CFE_Status_t CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+
+   SbTransmitCnt++;
+   if (IncrementSequenceCount)
+   {
+      ((CFE_MSG_Message_t *)MsgPtr)->Sequence = (MsgPtr->Sequence + 1) & 0x3FFF;
+   }
+   if (SbHook != NULL)
+   {
+      SbHook(MsgPtr, SbHookData);
+   }
+
+   return CFE_SUCCESS;
+
+}
+
+CFE_Status_t CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+
+   CFE_Status_t Status = CFE_SB_TransmitMsg(&BufPtr->Msg, IncrementSequenceCount);
+
+   CFE_SB_ReleaseMessageBuffer(BufPtr);
+
+   return Status;
+
+}
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+
+   int i;
+   CFE_SB_Buffer_t *Buf = NULL;
+
+   if (MsgSize <= SB_BUF_SIZE)
+   {
+      for (i=0; i < SB_BUF_CNT && Buf == NULL; i++)
+      {
+         if (!SbBufPool[i].InUse)
+         {
+            SbBufPool[i].InUse = true;
+            Buf = &SbBufPool[i].Buf;
+            SbAllocCnt++;
+         }
+      }
+   }
+
+   return Buf;
+
+}
+
+CFE_Status_t CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+
+   int i;
+
+   for (i=0; i < SB_BUF_CNT; i++)
+   {
+      if (&SbBufPool[i].Buf == BufPtr)
+      {
+         SbBufPool[i].InUse = false;
+      }
+   }
+
+   return CFE_SUCCESS;
+
+}
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+   CFE_MSG_SetMsgTime(MsgPtr, CFE_TIME_GetTime());
+}
+
+
+/******************************************************************************
+** PSP
+*/
+
+void CFE_PSP_MemSet(void *Dest, uint8 Value, uint32 Size)
+{
+   memset(Dest, Value, Size);
+}
+
+
+/******************************************************************************
+** OSAL
+** - File handles are the host file descriptor plus one so zero stays
+**   undefined
+*/
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode)
+{
+
+   int  Fd;
+   int  HostFlags;
+   char HostPath[2*OS_MAX_PATH_LEN];
+   bool Write = (access_mode != OS_READ_ONLY);
+
+   HostFlags  = (access_mode == OS_READ_ONLY) ? O_RDONLY : ((access_mode == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR);
+   HostFlags |= (flags & OS_FILE_FLAG_CREATE)   ? O_CREAT : 0;
+   HostFlags |= (flags & OS_FILE_FLAG_TRUNCATE) ? O_TRUNC : 0;
+
+   MapPath(path, Write, HostPath, sizeof(HostPath));
+   Fd = open(HostPath, HostFlags, 0644);
+
+   *filedes = (Fd >= 0) ? (osal_id_t)(Fd + 1) : OS_OBJECT_ID_UNDEFINED;
+
+   return (Fd >= 0) ? OS_SUCCESS : OS_ERROR;
+
+}
+
+int32 OS_close(osal_id_t filedes)
+{
+   return (close((int)filedes - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes)
+{
+   ssize_t Len = read((int)filedes - 1, buffer, nbytes);
+   return (Len >= 0) ? (int32)Len : OS_ERROR;
+}
+
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes)
+{
+   ssize_t Len = write((int)filedes - 1, buffer, nbytes);
+   return (Len >= 0) ? (int32)Len : OS_ERROR;
+}
+
+int32 OS_lseek(osal_id_t filedes, int32 offset, uint32 whence)
+{
+   off_t Pos = lseek((int)filedes - 1, offset, (whence == OS_SEEK_SET) ? SEEK_SET : ((whence == OS_SEEK_CUR) ? SEEK_CUR : SEEK_END));
+   return (Pos >= 0) ? (int32)Pos : OS_ERROR;
+}
+
+int32 OS_GetErrorName(int32 error_num, os_err_name_t *err_name)
+{
+   snprintf(*err_name, sizeof(os_err_name_t), "OS_ERROR(%d)", (int)error_num);
+   return OS_SUCCESS;
+}
+
+int32 OS_TaskDelay(uint32 millisecond)
+{
+
+   struct timespec Delay;
+
+   Delay.tv_sec  = millisecond / 1000;
+   Delay.tv_nsec = (long)(millisecond % 1000) * 1000000;
+   nanosleep(&Delay, NULL);
+
+   return OS_SUCCESS;
+
+}
+
+void CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType)
+{
+   memset(Hdr, 0, sizeof(CFE_FS_Header_t));
+   Hdr->ContentType = 0x63464531;   /* "cFE1" */
+   Hdr->SubType     = SubType;
+   Hdr->Length      = sizeof(CFE_FS_Header_t);
+   strncpy(Hdr->Description, Description, CFE_FS_HDR_DESC_MAX_LEN-1);
+}
+
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr)
+{
+   CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+   Hdr->TimeSeconds    = Now.Seconds;
+   Hdr->TimeSubSeconds = Now.Subseconds;
+   return OS_write(FileDes, Hdr, sizeof(CFE_FS_Header_t));
+}
+
+
+/******************************************************************************
+** OSAL binary semaphores
+*/
+
+typedef struct
+{
+   bool             Created;
+   uint32           Value;
+   pthread_mutex_t  Mutex;
+   pthread_cond_t   Cond;
+} BinSem_t;
+
+#define BIN_SEM_CNT  8
+static BinSem_t BinSem[BIN_SEM_CNT];
+static uint32   BinSemCnt = 0;
+
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options)
+{
+
+   int32 Status = OS_ERROR;
+   pthread_condattr_t CondAttr;
+
+   if (BinSemCnt < BIN_SEM_CNT)
+   {
+      BinSem_t *Sem = &BinSem[BinSemCnt];
+      pthread_mutex_init(&Sem->Mutex, NULL);
+      pthread_condattr_init(&CondAttr);
+      pthread_condattr_setclock(&CondAttr, CLOCK_MONOTONIC);
+      pthread_cond_init(&Sem->Cond, &CondAttr);
+      Sem->Value   = (sem_initial_value > 0) ? 1 : 0;
+      Sem->Created = true;
+      *sem_id = ++BinSemCnt;
+      Status = OS_SUCCESS;
+   }
+
+   return Status;
+
+}
+
+int32 OS_BinSemGive(osal_id_t sem_id)
+{
+
+   BinSem_t *Sem = &BinSem[sem_id - 1];
+
+   pthread_mutex_lock(&Sem->Mutex);
+   Sem->Value = 1;
+   pthread_cond_signal(&Sem->Cond);
+   pthread_mutex_unlock(&Sem->Mutex);
+
+   return OS_SUCCESS;
+
+}
+
+int32 OS_BinSemTake(osal_id_t sem_id)
+{
+
+   BinSem_t *Sem = &BinSem[sem_id - 1];
+
+   pthread_mutex_lock(&Sem->Mutex);
+   while (Sem->Value == 0)
+   {
+      pthread_cond_wait(&Sem->Cond, &Sem->Mutex);
+   }
+   Sem->Value = 0;
+   pthread_mutex_unlock(&Sem->Mutex);
+
+   return OS_SUCCESS;
+
+}
+
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs)
+{
+
+   int32 Status = OS_SUCCESS;
+   int   WaitStatus = 0;
+   BinSem_t *Sem = &BinSem[sem_id - 1];
+   struct timespec Deadline;
+
+   clock_gettime(CLOCK_MONOTONIC, &Deadline);
+   Deadline.tv_sec  += msecs / 1000;
+   Deadline.tv_nsec += (long)(msecs % 1000) * 1000000;
+   if (Deadline.tv_nsec >= 1000000000)
+   {
+      Deadline.tv_sec++;
+      Deadline.tv_nsec -= 1000000000;
+   }
+
+   pthread_mutex_lock(&Sem->Mutex);
+   while (Sem->Value == 0 && WaitStatus != ETIMEDOUT)
+   {
+      WaitStatus = pthread_cond_timedwait(&Sem->Cond, &Sem->Mutex, &Deadline);
+   }
+   if (Sem->Value != 0)
+   {
+      Sem->Value = 0;
+   }
+   else
+   {
+      Status = OS_SEM_TIMEOUT;
+   }
+   pthread_mutex_unlock(&Sem->Mutex);
+
+   return Status;
+
+}
+
+
+/******************************************************************************
+** Function: MapPath
+**
+** Map a /cf/ path to the host tables or output directory.
+*/
+static void MapPath(const char *Path, bool Write, char *HostPath, size_t HostPathLen)
+{
+
+   struct stat FileStat;
+   const char *Name;
+
+   if (strncmp(Path, CF_PREFIX, strlen(CF_PREFIX)) == 0)
+   {
+      Name = Path + strlen(CF_PREFIX);
+      if (Write)
+      {
+         snprintf(HostPath, HostPathLen, "%s/%s", OutputDir, Name);
+      }
+      else
+      {
+         snprintf(HostPath, HostPathLen, "%s/%s", TablesDir, Name);
+         if (stat(HostPath, &FileStat) != 0)
+         {
+            snprintf(HostPath, HostPathLen, "%s/cpu1_%s", TablesDir, Name);
+         }
+      }
+   }
+   else
+   {
+      snprintf(HostPath, HostPathLen, "%s", Path);
+   }
+
+}
+
+
+/******************************************************************************
+** Function: MonoNs
+**
+*/
+static uint64 MonoNs(void)
+{
+
+   struct timespec Now;
+
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+
+   return ((uint64)Now.tv_sec * 1000000000 + (uint64)Now.tv_nsec);
+
+}
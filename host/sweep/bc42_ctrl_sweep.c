@@ -0,0 +1,721 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Sweep control gain variants over a recorded sensor trace in parallel
+**
+**  Notes:
+**    1. Each variant scales the Kp, Kr and Kunl of the base parameter table
+**       in the tables directory, including every gain schedule breakpoint. Scale factors come from a geometric grid
+**       or from log-uniform random samples of each -p range.
+**    2. Every variant flies the controller closed loop against the rigid
+**       spacecraft model in sc_dyn.h, driven by the trace's cycle times and
+**       environment. See sc_dyn.h for why the recorded attitude can't be
+**       replayed open loop.
+**    3. The controller, its stand-ins and the cFE stand-ins keep process
+**       wide state, so variants run in forked worker processes rather than
+**       threads. Workers claim the next unclaimed variant from a counter in
+**       shared memory, so a worker that finishes early keeps taking work
+**       until none is left. Results are written to a shared array.
+**    4. Reported per variant:
+**       - RMS and maximum pointing error over the run
+**       - Settling time: time from the first cycle until the pointing error
+**         stays within the -e tolerance to the end of the run, -1 if it
+**         never does
+**       - Fraction of cycles with TakeSci set
+**    5. Usage: bc42_ctrl_sweep [-t tables dir] [-o csv file] [-j workers]
+**              [-p kp|kr|kunl=min:max[:n]]... [-r random count] [-S seed]
+**              [-I Ixx,Iyy,Izz] [-m max dipole] [-e settle tolerance] trace
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "host_app.h"
+#include "mono_time.h"
+#include "sc_dyn.h"
+#include "sensor_trace.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SWEEP_DEF_OUT_FILE     "bc42_ctrl_sweep.csv"
+#define SWEEP_DEF_GRID_CNT     5
+#define SWEEP_DEF_SETTLE_TOL   1.0E-3    /* rad */
+#define SWEEP_DEF_MAX_DIPOLE   100.0     /* A-m^2 */
+#define SWEEP_MAX_VARIANTS     10000000
+#define SWEEP_BEST_CNT         5
+#define SWEEP_PROGRESS_PERIOD  5.0       /* Seconds between progress reports */
+
+/* Default inertia: the default table gains are wn = 0.1 rad/s, zeta = 0.7 */
+#define SWEEP_DEF_INERTIA      { 2759.8, 2117.5, 3835.3 }
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SWEEP_KP   = 0,
+   SWEEP_KR   = 1,
+   SWEEP_KUNL = 2,
+   SWEEP_PARAM_CNT = 3
+
+} SWEEP_Param_t;
+
+typedef enum
+{
+
+   SWEEP_RESULT_PENDING  = 0,   /* Not run, e.g. its worker exited */
+   SWEEP_RESULT_OK       = 1,
+   SWEEP_RESULT_REJECTED = 2    /* Controller rejected the table */
+
+} SWEEP_ResultStatus_t;
+
+typedef struct
+{
+
+   double  Min;
+   double  Max;
+   uint32  Cnt;                /* Grid points */
+
+} SWEEP_Range_t;
+
+typedef struct
+{
+
+   double  Scale[SWEEP_PARAM_CNT];
+   CTRL42_TBL_Data_t Tbl;
+
+} SWEEP_Variant_t;
+
+typedef struct
+{
+
+   uint32  Status;             /* SWEEP_ResultStatus_t */
+   uint32  Worker;
+   double  RmsErr;             /* rad */
+   double  MaxErr;             /* rad */
+   double  SettleTime;         /* Seconds, -1 if never settled */
+   double  TakeSciFrac;
+
+} SWEEP_Result_t;
+
+typedef struct
+{
+
+   uint32  NextVariant;        /* Claimed by workers with an atomic increment */
+   uint32  DoneCnt;
+   SWEEP_Result_t Result[];
+
+} SWEEP_Shared_t;
+
+typedef struct
+{
+
+   uint32  RecCnt;
+   BC42_INTF_SensorDataMsg_Payload_t *Sensor;
+   CFE_TIME_SysTime_t *Time;
+
+} SWEEP_Trace_t;
+
+typedef struct
+{
+
+   CFE_SB_MsgId_t  ActuatorCmdMid;
+   bool            Valid;
+   BC42_INTF_ActuatorCmdMsg_Payload_t ActuatorCmd;
+
+} SWEEP_Capture_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const char *ParamName[SWEEP_PARAM_CNT] = { "kp", "kr", "kunl" };
+
+static HOST_APP_Class_t  HostApp;      /* One per worker process */
+static SWEEP_Capture_t   Capture;
+static SWEEP_Trace_t     Trace;
+
+static double Inertia[3]  = SWEEP_DEF_INERTIA;
+static double MaxDipole   = SWEEP_DEF_MAX_DIPOLE;
+static double SettleTol   = SWEEP_DEF_SETTLE_TOL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void   CaptureMsg(const CFE_MSG_Message_t *MsgPtr, void *UserData);
+static int    CompareRms(const void *A, const void *B);
+static bool   LoadTrace(const char *Filename);
+static bool   ParseRange(const char *Arg, SWEEP_Range_t Range[SWEEP_PARAM_CNT]);
+static double Rand(uint64 *Seed);
+static void   RunVariant(const SWEEP_Variant_t *Variant, SWEEP_Result_t *Result);
+static void   RunWorker(uint32 Worker, const char *TablesDir, const SWEEP_Variant_t *Variant,
+                        uint32 VariantCnt, SWEEP_Shared_t *Shared);
+static double TimeToSeconds(CFE_TIME_SysTime_t Time);
+static bool   WriteCsv(const char *Filename, const SWEEP_Variant_t *Variant,
+                       uint32 VariantCnt, const SWEEP_Shared_t *Shared);
+
+static const SWEEP_Shared_t *SortShared;   /* CompareRms() context */
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   const char *TablesDir   = NULL;
+   const char *OutFilename = SWEEP_DEF_OUT_FILE;
+   SWEEP_Range_t Range[SWEEP_PARAM_CNT] = { { 1.0, 1.0, 1 }, { 1.0, 1.0, 1 }, { 1.0, 1.0, 1 } };
+   SWEEP_Variant_t *Variant;
+   SWEEP_Shared_t  *Shared;
+   size_t  SharedLen;
+   uint32  VariantCnt = 1;
+   uint32  RandomCnt  = 0;
+   uint32  WorkerCnt  = (uint32)sysconf(_SC_NPROCESSORS_ONLN);
+   uint32  v, w, p, Pt, Idx, Alive, OkCnt, RejectedCnt;
+   CTRL42_TBL_Gains_t *Gains;
+   uint32 *Order;
+   uint64  Seed = 1;
+   uint64  StartNs, LastReportNs;
+   double  WallSec;
+   pid_t   Pid;
+   int     Opt, WaitStatus;
+
+   while ((Opt = getopt(argc, argv, "t:o:j:p:r:S:I:m:e:")) != -1)
+   {
+      switch (Opt)
+      {
+         case 't': TablesDir   = optarg; break;
+         case 'o': OutFilename = optarg; break;
+         case 'j': WorkerCnt   = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'r': RandomCnt   = (uint32)strtoul(optarg, NULL, 0); break;
+         case 'S': Seed        = strtoull(optarg, NULL, 0); break;
+         case 'm': MaxDipole   = strtod(optarg, NULL); break;
+         case 'e': SettleTol   = strtod(optarg, NULL); break;
+         case 'p':
+            if (!ParseRange(optarg, Range)) return EXIT_FAILURE;
+            break;
+         case 'I':
+            if (sscanf(optarg, "%lf,%lf,%lf", &Inertia[0], &Inertia[1], &Inertia[2]) != 3 ||
+                Inertia[0] <= 0.0 || Inertia[1] <= 0.0 || Inertia[2] <= 0.0)
+            {
+               fprintf(stderr, "Inertia must be three positive values: Ixx,Iyy,Izz\n");
+               return EXIT_FAILURE;
+            }
+            break;
+         default:  optind = argc + 1; break;
+      }
+   }
+
+   if (optind != argc - 1 || WorkerCnt == 0)
+   {
+      fprintf(stderr, "Usage: %s [-t tables dir] [-o csv file] [-j workers] [-p kp|kr|kunl=min:max[:n]]...\n"
+                      "          [-r random count] [-S seed] [-I Ixx,Iyy,Izz] [-m max dipole] [-e settle tolerance] trace\n",
+              argv[0]);
+      return EXIT_FAILURE;
+   }
+
+   if (!LoadTrace(argv[optind]))
+   {
+      return EXIT_FAILURE;
+   }
+
+   /* The base table is read by a constructor in this process before any fork */
+   if (!HOST_APP_Constructor(&HostApp, TablesDir))
+   {
+      return EXIT_FAILURE;
+   }
+
+   if (RandomCnt > 0)
+   {
+      VariantCnt = RandomCnt;
+   }
+   else
+   {
+      for (p=0; p < SWEEP_PARAM_CNT; p++)
+      {
+         if ((uint64)VariantCnt * Range[p].Cnt > SWEEP_MAX_VARIANTS)
+         {
+            fprintf(stderr, "Grid exceeds %u variants\n", SWEEP_MAX_VARIANTS);
+            return EXIT_FAILURE;
+         }
+         VariantCnt *= Range[p].Cnt;
+      }
+   }
+
+   Variant = malloc(VariantCnt * sizeof(SWEEP_Variant_t));
+   Order   = malloc(VariantCnt * sizeof(uint32));
+   SharedLen = sizeof(SWEEP_Shared_t) + VariantCnt * sizeof(SWEEP_Result_t);
+   Shared  = mmap(NULL, SharedLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+   if (Variant == NULL || Order == NULL || Shared == MAP_FAILED)
+   {
+      fprintf(stderr, "Unable to allocate %u variants\n", VariantCnt);
+      return EXIT_FAILURE;
+   }
+   memset(Shared, 0, SharedLen);
+
+   for (v=0; v < VariantCnt; v++)
+   {
+      Idx = v;
+      Variant[v].Tbl = *CTRL42_TBL_GetData(&HostApp.Ctrl42.Tbl);
+      for (p=0; p < SWEEP_PARAM_CNT; p++)
+      {
+         double Frac;
+         if (RandomCnt > 0)
+         {
+            Frac = Rand(&Seed);
+         }
+         else
+         {
+            Frac = (Range[p].Cnt > 1) ? (double)(Idx % Range[p].Cnt) / (Range[p].Cnt - 1) : 0.0;
+            Idx /= Range[p].Cnt;
+         }
+         Variant[v].Scale[p] = Range[p].Min * pow(Range[p].Max / Range[p].Min, Frac);
+      }
+      for (p=0; p < 3; p++)
+      {
+         Variant[v].Tbl.Kp[p] *= Variant[v].Scale[SWEEP_KP];
+         Variant[v].Tbl.Kr[p] *= Variant[v].Scale[SWEEP_KR];
+      }
+      Variant[v].Tbl.Kunl *= Variant[v].Scale[SWEEP_KUNL];
+      for (Pt=0; Pt < Variant[v].Tbl.GainSched.PtCnt; Pt++)
+      {
+         Gains = &Variant[v].Tbl.GainSched.Gains[Pt];
+         for (p=0; p < 3; p++)
+         {
+            Gains->Kp[p] *= Variant[v].Scale[SWEEP_KP];
+            Gains->Kr[p] *= Variant[v].Scale[SWEEP_KR];
+         }
+         Gains->Kunl *= Variant[v].Scale[SWEEP_KUNL];
+      }
+   }
+
+   if (WorkerCnt > VariantCnt) WorkerCnt = VariantCnt;
+
+   StartNs = MONO_TIME_GetNs();
+   LastReportNs = StartNs;
+
+   fflush(stdout);
+   for (w=0; w < WorkerCnt; w++)
+   {
+      Pid = fork();
+      if (Pid == 0)
+      {
+         RunWorker(w, TablesDir, Variant, VariantCnt, Shared);
+      }
+      else if (Pid < 0)
+      {
+         fprintf(stderr, "Unable to start worker %u\n", w);
+         WorkerCnt = w;
+      }
+   }
+
+   Alive = WorkerCnt;
+   while (Alive > 0)
+   {
+      Pid = waitpid(-1, &WaitStatus, WNOHANG);
+      if (Pid > 0)
+      {
+         if (!WIFEXITED(WaitStatus) || WEXITSTATUS(WaitStatus) != 0)
+         {
+            fprintf(stderr, "Worker process %d failed\n", (int)Pid);
+         }
+         Alive--;
+      }
+      else if (Pid == 0)
+      {
+         usleep(10000);
+         if ((MONO_TIME_GetNs() - LastReportNs) * 1.0E-9 >= SWEEP_PROGRESS_PERIOD)
+         {
+            LastReportNs = MONO_TIME_GetNs();
+            fprintf(stderr, "%u of %u variants done\n",
+                    __atomic_load_n(&Shared->DoneCnt, __ATOMIC_RELAXED), VariantCnt);
+         }
+      }
+      else
+      {
+         break;
+      }
+   }
+
+   WallSec = (double)(MONO_TIME_GetNs() - StartNs) * 1.0E-9;
+
+   OkCnt = 0;
+   RejectedCnt = 0;
+   for (v=0; v < VariantCnt; v++)
+   {
+      if (Shared->Result[v].Status == SWEEP_RESULT_OK)
+      {
+         Order[OkCnt++] = v;
+      }
+      else if (Shared->Result[v].Status == SWEEP_RESULT_REJECTED)
+      {
+         RejectedCnt++;
+      }
+   }
+   SortShared = Shared;
+   qsort(Order, OkCnt, sizeof(uint32), CompareRms);
+
+   if (!WriteCsv(OutFilename, Variant, VariantCnt, Shared))
+   {
+      fprintf(stderr, "Error writing %s\n", OutFilename);
+   }
+
+   printf("BC42_CTRL gain sweep\n");
+   printf("   Trace:            %s (%u cycles, %.3f s)\n", argv[optind], Trace.RecCnt,
+          TimeToSeconds(Trace.Time[Trace.RecCnt-1]) - TimeToSeconds(Trace.Time[0]));
+   printf("   Output:           %s\n", OutFilename);
+   printf("   Workers:          %u\n", WorkerCnt);
+   printf("   Variants:         %u run, %u rejected, %u not run\n", OkCnt, RejectedCnt,
+          VariantCnt - OkCnt - RejectedCnt);
+   printf("   Wall-clock time:  %.3f s (%.1f variants/s, %.0f cycles/s)\n", WallSec,
+          (WallSec > 0.0) ? OkCnt / WallSec : 0.0,
+          (WallSec > 0.0) ? (double)OkCnt * Trace.RecCnt / WallSec : 0.0);
+   printf("   Lowest RMS pointing error:\n");
+   printf("   %8s %8s %8s %8s %12s %12s %10s %8s\n", "Variant", "Kp x", "Kr x", "Kunl x",
+          "RMS (rad)", "Max (rad)", "Settle (s)", "TakeSci");
+   for (v=0; v < OkCnt && v < SWEEP_BEST_CNT; v++)
+   {
+      const SWEEP_Result_t *Result = &Shared->Result[Order[v]];
+      printf("   %8u %8.3f %8.3f %8.3f %12.4e %12.4e %10.2f %8.3f\n", Order[v],
+             Variant[Order[v]].Scale[SWEEP_KP], Variant[Order[v]].Scale[SWEEP_KR],
+             Variant[Order[v]].Scale[SWEEP_KUNL], Result->RmsErr, Result->MaxErr,
+             Result->SettleTime, Result->TakeSciFrac);
+   }
+
+   munmap(Shared, SharedLen);
+   free(Order);
+   free(Variant);
+
+   return (OkCnt + RejectedCnt == VariantCnt) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CaptureMsg
+**
+** Software bus hook that saves the cycle's actuator command.
+*/
+static void CaptureMsg(const CFE_MSG_Message_t *MsgPtr, void *UserData)
+{
+
+   SWEEP_Capture_t *Capture = (SWEEP_Capture_t *)UserData;
+   CFE_SB_MsgId_t   MsgId;
+
+   CFE_MSG_GetMsgId(MsgPtr, &MsgId);
+
+   if (CFE_SB_MsgId_Equal(MsgId, Capture->ActuatorCmdMid))
+   {
+      Capture->ActuatorCmd = ((const BC42_INTF_ActuatorCmdMsg_t *)MsgPtr)->Payload;
+      Capture->Valid = true;
+   }
+
+} /* End CaptureMsg() */
+
+
+/******************************************************************************
+** Function: CompareRms
+**
+*/
+static int CompareRms(const void *A, const void *B)
+{
+
+   double a = SortShared->Result[*(const uint32 *)A].RmsErr;
+   double b = SortShared->Result[*(const uint32 *)B].RmsErr;
+
+   return (a > b) - (a < b);
+
+} /* End CompareRms() */
+
+
+/******************************************************************************
+** Function: LoadTrace
+**
+** Read the entire trace into memory so forked workers share it.
+*/
+static bool LoadTrace(const char *Filename)
+{
+
+   SENSOR_TRACE_Class_t *SensorTrace = malloc(sizeof(SENSOR_TRACE_Class_t));
+   uint32 Cap = 0;
+   bool   RetStatus = false;
+   BC42_INTF_SensorDataMsg_Payload_t Sensor;
+   CFE_TIME_SysTime_t SensorTime;
+
+   if (SensorTrace != NULL && SENSOR_TRACE_Open(SensorTrace, Filename))
+   {
+      RetStatus = true;
+      while (RetStatus && SENSOR_TRACE_Read(SensorTrace, &Sensor, &SensorTime))
+      {
+         if (Trace.RecCnt == Cap)
+         {
+            Cap = (Cap == 0) ? 4096 : 2*Cap;
+            Trace.Sensor = realloc(Trace.Sensor, Cap * sizeof(BC42_INTF_SensorDataMsg_Payload_t));
+            Trace.Time   = realloc(Trace.Time, Cap * sizeof(CFE_TIME_SysTime_t));
+            RetStatus = (Trace.Sensor != NULL && Trace.Time != NULL);
+         }
+         if (RetStatus)
+         {
+            Trace.Sensor[Trace.RecCnt] = Sensor;
+            Trace.Time[Trace.RecCnt]   = SensorTime;
+            Trace.RecCnt++;
+         }
+      }
+      SENSOR_TRACE_Close(SensorTrace);
+
+      if (RetStatus && Trace.RecCnt == 0)
+      {
+         fprintf(stderr, "%s has no records\n", Filename);
+         RetStatus = false;
+      }
+   }
+
+   free(SensorTrace);
+
+   return RetStatus;
+
+} /* End LoadTrace() */
+
+
+/******************************************************************************
+** Function: ParseRange
+**
+** Parse name=min:max[:n]. Scale factors must be positive because they're
+** spaced geometrically.
+*/
+static bool ParseRange(const char *Arg, SWEEP_Range_t Range[SWEEP_PARAM_CNT])
+{
+
+   char   Name[16];
+   double Min, Max;
+   unsigned int Cnt = SWEEP_DEF_GRID_CNT;
+   int    FieldCnt, p;
+   bool   RetStatus = false;
+
+   FieldCnt = sscanf(Arg, "%15[^=]=%lf:%lf:%u", Name, &Min, &Max, &Cnt);
+
+   if (FieldCnt >= 3 && Min > 0.0 && Max > 0.0 && Cnt > 0)
+   {
+      for (p=0; p < SWEEP_PARAM_CNT; p++)
+      {
+         if (strcmp(Name, ParamName[p]) == 0)
+         {
+            Range[p].Min = Min;
+            Range[p].Max = Max;
+            Range[p].Cnt = (Min == Max) ? 1 : Cnt;
+            RetStatus = true;
+         }
+      }
+   }
+
+   if (!RetStatus)
+   {
+      fprintf(stderr, "Invalid range %s, expected kp|kr|kunl=min:max[:n] with positive scale factors\n", Arg);
+   }
+
+   return RetStatus;
+
+} /* End ParseRange() */
+
+
+/******************************************************************************
+** Function: Rand
+**
+** Uniform value in [0, 1) from a 64-bit LCG so sweeps are repeatable.
+*/
+static double Rand(uint64 *Seed)
+{
+
+   *Seed = *Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+   return (double)(*Seed >> 11) / 9007199254740992.0;
+
+} /* End Rand() */
+
+
+/******************************************************************************
+** Function: RunVariant
+**
+** Fly the controller over the trace with one variant's parameters.
+*/
+static void RunVariant(const SWEEP_Variant_t *Variant, SWEEP_Result_t *Result)
+{
+
+   static const double Zero[3] = { 0.0, 0.0, 0.0 };
+   SC_DYN_Class_t ScDyn;
+   BC42_INTF_SensorDataMsg_Payload_t Sensor;
+   double  StartSec, CycleSec, Err, SumSq = 0.0;
+   uint32  i, TakeSciCnt = 0;
+
+   if (!HOST_APP_LoadCtrlTbl(&HostApp, &Variant->Tbl))
+   {
+      Result->Status = SWEEP_RESULT_REJECTED;
+      return;
+   }
+
+   SC_DYN_Constructor(&ScDyn, Inertia, MaxDipole, &Trace.Sensor[0]);
+   StartSec = TimeToSeconds(Trace.Time[0]);
+
+   Result->MaxErr     = 0.0;
+   Result->SettleTime = -1.0;
+
+   for (i=0; i < Trace.RecCnt; i++)
+   {
+
+      Sensor = Trace.Sensor[i];
+      SC_DYN_LoadSensor(&ScDyn, &Sensor);
+
+      Capture.Valid = false;
+      HOST_APP_RunCycle(&HostApp, &Sensor, Trace.Time[i]);
+
+      CycleSec = TimeToSeconds(Trace.Time[i]) - StartSec;
+      Err = SC_DYN_PointingErr(&ScDyn);
+      SumSq += Err*Err;
+      if (Err > Result->MaxErr) Result->MaxErr = Err;
+      if (Err > SettleTol)
+      {
+         Result->SettleTime = -1.0;
+      }
+      else if (Result->SettleTime < 0.0)
+      {
+         Result->SettleTime = CycleSec;
+      }
+      if (HostApp.Ctrl42.TakeSci) TakeSciCnt++;
+
+      if (i + 1 < Trace.RecCnt)
+      {
+         SC_DYN_Propagate(&ScDyn, Capture.Valid ? Capture.ActuatorCmd.Tcmd : Zero,
+                          Capture.Valid ? Capture.ActuatorCmd.Mcmd : Zero, Sensor.bvb,
+                          TimeToSeconds(Trace.Time[i+1]) - TimeToSeconds(Trace.Time[i]));
+      }
+
+   }
+
+   Result->RmsErr      = sqrt(SumSq / Trace.RecCnt);
+   Result->TakeSciFrac = (double)TakeSciCnt / Trace.RecCnt;
+   Result->Status      = SWEEP_RESULT_OK;
+
+} /* End RunVariant() */
+
+
+/******************************************************************************
+** Function: RunWorker
+**
+** Worker process main loop. Never returns.
+*/
+static void RunWorker(uint32 Worker, const char *TablesDir, const SWEEP_Variant_t *Variant,
+                      uint32 VariantCnt, SWEEP_Shared_t *Shared)
+{
+
+   SWEEP_Result_t Result;
+   uint32 Idx;
+
+   /* The parent's child tasks weren't forked so construct a fresh app */
+   if (!HOST_APP_Constructor(&HostApp, TablesDir))
+   {
+      _exit(EXIT_FAILURE);
+   }
+
+   Capture.ActuatorCmdMid = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(&HostApp.IniTbl, CFG_BC42_INTF_ACTUATOR_CMD_MSG_TOPICID));
+   HOST_SetSbHook(CaptureMsg, &Capture);
+
+   while ((Idx = __atomic_fetch_add(&Shared->NextVariant, 1, __ATOMIC_RELAXED)) < VariantCnt)
+   {
+      memset(&Result, 0, sizeof(Result));
+      Result.Worker = Worker;
+      RunVariant(&Variant[Idx], &Result);
+      Shared->Result[Idx] = Result;
+      __atomic_add_fetch(&Shared->DoneCnt, 1, __ATOMIC_RELEASE);
+   }
+
+   _exit(EXIT_SUCCESS);
+
+} /* End RunWorker() */
+
+
+/******************************************************************************
+** Function: TimeToSeconds
+**
+*/
+static double TimeToSeconds(CFE_TIME_SysTime_t Time)
+{
+
+   return (double)Time.Seconds + (double)Time.Subseconds / 4294967296.0;
+
+} /* End TimeToSeconds() */
+
+
+/******************************************************************************
+** Function: WriteCsv
+**
+** One line per variant in variant order. Variants that weren't run have an
+** empty result.
+*/
+static bool WriteCsv(const char *Filename, const SWEEP_Variant_t *Variant,
+                     uint32 VariantCnt, const SWEEP_Shared_t *Shared)
+{
+
+   static const char *StatusStr[] = { "not_run", "ok", "rejected" };
+   FILE  *File = fopen(Filename, "w");
+   uint32 v;
+   bool   RetStatus = false;
+
+   if (File != NULL)
+   {
+      fprintf(File, "variant,kp_scale,kr_scale,kunl_scale,kp_x,kp_y,kp_z,kr_x,kr_y,kr_z,kunl,"
+                    "status,rms_err_rad,max_err_rad,settle_time_s,take_sci_frac,worker\n");
+      for (v=0; v < VariantCnt; v++)
+      {
+         const CTRL42_TBL_Data_t *Tbl = &Variant[v].Tbl;
+         const SWEEP_Result_t *Result = &Shared->Result[v];
+
+         fprintf(File, "%u,%.6g,%.6g,%.6g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%s", v,
+                 Variant[v].Scale[SWEEP_KP], Variant[v].Scale[SWEEP_KR], Variant[v].Scale[SWEEP_KUNL],
+                 Tbl->Kp[0], Tbl->Kp[1], Tbl->Kp[2], Tbl->Kr[0], Tbl->Kr[1], Tbl->Kr[2], Tbl->Kunl,
+                 StatusStr[Result->Status]);
+         if (Result->Status == SWEEP_RESULT_OK)
+         {
+            fprintf(File, ",%.9e,%.9e,%.3f,%.6f,%u\n", Result->RmsErr, Result->MaxErr,
+                    Result->SettleTime, Result->TakeSciFrac, Result->Worker);
+         }
+         else
+         {
+            fprintf(File, ",,,,,\n");
+         }
+      }
+      RetStatus = (fclose(File) == 0);
+   }
+
+   return RetStatus;
+
+} /* End WriteCsv() */
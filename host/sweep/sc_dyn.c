@@ -0,0 +1,215 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the rigid spacecraft model
+**
+**  Notes:
+**    None
+**
+*/
+
+/*
+** Includes
+*/
+
+#include "sc_dyn.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SC_DYN_STATE_LEN  10   /* qbn[4], wbn[3], Hvb[3] */
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void Derivative(const SC_DYN_Class_t *ScDyn, const double State[SC_DYN_STATE_LEN],
+                       const double Tcmd[3], const double Tmag[3], double Deriv[SC_DYN_STATE_LEN]);
+
+
+/******************************************************************************
+** Function: SC_DYN_Constructor
+**
+*/
+void SC_DYN_Constructor(SC_DYN_Class_t *ScDyn, const double Inertia[3], double MaxDipole,
+                        const BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   double Norm = 0.0;
+   int i;
+
+   memset(ScDyn, 0, sizeof(SC_DYN_Class_t));
+
+   ScDyn->MaxDipole = MaxDipole;
+
+   for (i=0; i < 4; i++)
+   {
+      Norm += Sensor->qbn[i]*Sensor->qbn[i];
+   }
+   Norm = (Norm > 0.0) ? sqrt(Norm) : 1.0;
+
+   for (i=0; i < 3; i++)
+   {
+      ScDyn->Inertia[i] = Inertia[i];
+      ScDyn->qbn[i] = Sensor->qbn[i] / Norm;
+      ScDyn->wbn[i] = Sensor->wbn[i];
+      ScDyn->Hvb[i] = Sensor->Hw[i] + Sensor->Hw[3]*0.57735;
+   }
+   ScDyn->qbn[3] = (Norm > 0.0) ? Sensor->qbn[3] / Norm : 1.0;
+
+} /* End SC_DYN_Constructor() */
+
+
+/******************************************************************************
+** Function: SC_DYN_LoadSensor
+**
+*/
+void SC_DYN_LoadSensor(const SC_DYN_Class_t *ScDyn, BC42_INTF_SensorDataMsg_Payload_t *Sensor)
+{
+
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Sensor->qbn[i] = ScDyn->qbn[i];
+      Sensor->wbn[i] = ScDyn->wbn[i];
+      Sensor->Hw[i]  = ScDyn->Hvb[i];
+   }
+   Sensor->qbn[3] = ScDyn->qbn[3];
+   Sensor->Hw[3]  = 0.0;
+
+} /* End SC_DYN_LoadSensor() */
+
+
+/******************************************************************************
+** Function: SC_DYN_PointingErr
+**
+*/
+double SC_DYN_PointingErr(const SC_DYN_Class_t *ScDyn)
+{
+
+   double VecMag = sqrt(ScDyn->qbn[0]*ScDyn->qbn[0] + ScDyn->qbn[1]*ScDyn->qbn[1] +
+                        ScDyn->qbn[2]*ScDyn->qbn[2]);
+
+   return 2.0*atan2(VecMag, fabs(ScDyn->qbn[3]));
+
+} /* End SC_DYN_PointingErr() */
+
+
+/******************************************************************************
+** Function: SC_DYN_Propagate
+**
+*/
+void SC_DYN_Propagate(SC_DYN_Class_t *ScDyn, const double Tcmd[3], const double Mcmd[3],
+                      const double Bvb[3], double Dt)
+{
+
+   static const double StageWeight[4] = { 1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0 };
+   static const double StageStep[3]   = { 0.5, 0.5, 1.0 };
+   double State[SC_DYN_STATE_LEN], Stage[SC_DYN_STATE_LEN], Deriv[SC_DYN_STATE_LEN];
+   double Sum[SC_DYN_STATE_LEN] = { 0.0 };
+   double Dipole[3], Tmag[3];
+   double Norm = 0.0;
+   int i, s;
+
+   if (Dt <= 0.0) return;
+
+   for (i=0; i < 3; i++)
+   {
+      Dipole[i] = fmax(-ScDyn->MaxDipole, fmin(ScDyn->MaxDipole, Mcmd[i]));
+   }
+   Tmag[0] = Dipole[1]*Bvb[2] - Dipole[2]*Bvb[1];
+   Tmag[1] = Dipole[2]*Bvb[0] - Dipole[0]*Bvb[2];
+   Tmag[2] = Dipole[0]*Bvb[1] - Dipole[1]*Bvb[0];
+
+   memcpy(&State[0], ScDyn->qbn, sizeof(ScDyn->qbn));
+   memcpy(&State[4], ScDyn->wbn, sizeof(ScDyn->wbn));
+   memcpy(&State[7], ScDyn->Hvb, sizeof(ScDyn->Hvb));
+   memcpy(Stage, State, sizeof(State));
+
+   for (s=0; s < 4; s++)
+   {
+      Derivative(ScDyn, Stage, Tcmd, Tmag, Deriv);
+      for (i=0; i < SC_DYN_STATE_LEN; i++)
+      {
+         Sum[i] += StageWeight[s]*Deriv[i];
+         if (s < 3)
+         {
+            Stage[i] = State[i] + StageStep[s]*Dt*Deriv[i];
+         }
+      }
+   }
+
+   for (i=0; i < SC_DYN_STATE_LEN; i++)
+   {
+      State[i] += Dt*Sum[i];
+   }
+
+   for (i=0; i < 4; i++)
+   {
+      Norm += State[i]*State[i];
+   }
+   Norm = sqrt(Norm);
+   for (i=0; i < 4; i++)
+   {
+      ScDyn->qbn[i] = State[i] / Norm;
+   }
+   memcpy(ScDyn->wbn, &State[4], sizeof(ScDyn->wbn));
+   memcpy(ScDyn->Hvb, &State[7], sizeof(ScDyn->Hvb));
+
+} /* End SC_DYN_Propagate() */
+
+
+/******************************************************************************
+** Function: Derivative
+**
+** Euler's equation with wheel momentum and the quaternion kinematics:
+**    I*dw/dt = Tcmd + Tmag - w x (I*w + Hvb)
+**    dHvb/dt = -Tcmd
+**    dq/dt   = 0.5*[ s*w + v x w ; -w.v ]
+*/
+static void Derivative(const SC_DYN_Class_t *ScDyn, const double State[SC_DYN_STATE_LEN],
+                       const double Tcmd[3], const double Tmag[3], double Deriv[SC_DYN_STATE_LEN])
+{
+
+   const double *q = &State[0];
+   const double *w = &State[4];
+   const double *H = &State[7];
+   double Htot[3];
+   int i;
+
+   for (i=0; i < 3; i++)
+   {
+      Htot[i] = ScDyn->Inertia[i]*w[i] + H[i];
+   }
+
+   Deriv[0] = 0.5*(q[3]*w[0] + q[1]*w[2] - q[2]*w[1]);
+   Deriv[1] = 0.5*(q[3]*w[1] + q[2]*w[0] - q[0]*w[2]);
+   Deriv[2] = 0.5*(q[3]*w[2] + q[0]*w[1] - q[1]*w[0]);
+   Deriv[3] = -0.5*(q[0]*w[0] + q[1]*w[1] + q[2]*w[2]);
+
+   Deriv[4] = (Tcmd[0] + Tmag[0] - (w[1]*Htot[2] - w[2]*Htot[1])) / ScDyn->Inertia[0];
+   Deriv[5] = (Tcmd[1] + Tmag[1] - (w[2]*Htot[0] - w[0]*Htot[2])) / ScDyn->Inertia[1];
+   Deriv[6] = (Tcmd[2] + Tmag[2] - (w[0]*Htot[1] - w[1]*Htot[0])) / ScDyn->Inertia[2];
+
+   for (i=0; i < 3; i++)
+   {
+      Deriv[7+i] = -Tcmd[i];
+   }
+
+} /* End Derivative() */
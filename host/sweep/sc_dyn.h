@@ -0,0 +1,115 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Propagate a rigid spacecraft with reaction wheels and magnetic torquers
+**    for closed-loop sweeps over recorded sensor traces
+**
+**  Notes:
+**    1. A recorded trace's attitude doesn't respond to a different set of
+**       gains, so sweeps fly the controller against this model instead.
+**       The trace supplies the initial attitude, rate and wheel momentum,
+**       the cycle times, and the magnetic field, sun vector and validity
+**       flags of every cycle.
+**    2. The wheels deliver Tcmd to the body exactly and absorb it, so the
+**       wheel momentum changes by -Tcmd. The torquer dipole is clipped to
+**       MaxDipole per axis and produces Mcmd x bvb on the body.
+**    3. The wheel momentum is kept as a body frame vector. It is returned
+**       in Hw[0..2] with Hw[3] zero so the host controller stand-in sees
+**       the same Hvb.
+**    4. Quaternions are [x y z s] with the scalar last like 42's qbn. The
+**       pointing error is the rotation angle of qbn since the stand-in
+**       holds the inertial reference attitude.
+**
+*/
+#ifndef _sc_dyn_
+#define _sc_dyn_
+
+/*
+** Includes
+*/
+
+#include "bc42_intf_eds_typedefs.h"
+
+#include "app_cfg.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/******************************************************************************
+** SC_DYN Class
+*/
+
+typedef struct
+{
+
+   double  Inertia[3];         /* Principal moments, kg-m^2 */
+   double  MaxDipole;          /* Per axis, A-m^2 */
+
+   double  qbn[4];
+   double  wbn[3];             /* rad/s */
+   double  Hvb[3];             /* Wheel momentum, Nms */
+
+} SC_DYN_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: SC_DYN_Constructor
+**
+** Initialize the state from a recorded sensor data payload.
+**
+*/
+void SC_DYN_Constructor(SC_DYN_Class_t *ScDyn, const double Inertia[3], double MaxDipole,
+                        const BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+
+
+/******************************************************************************
+** Function: SC_DYN_LoadSensor
+**
+** Replace a sensor data payload's attitude, rate and wheel momentum with
+** the model state.
+**
+*/
+void SC_DYN_LoadSensor(const SC_DYN_Class_t *ScDyn, BC42_INTF_SensorDataMsg_Payload_t *Sensor);
+
+
+/******************************************************************************
+** Function: SC_DYN_PointingErr
+**
+** Return the rotation angle from the reference attitude in radians.
+**
+*/
+double SC_DYN_PointingErr(const SC_DYN_Class_t *ScDyn);
+
+
+/******************************************************************************
+** Function: SC_DYN_Propagate
+**
+** Advance the state Dt seconds with the actuator commands held constant.
+**
+** Notes:
+**   1. One 4th order Runge-Kutta step per control cycle.
+**
+*/
+void SC_DYN_Propagate(SC_DYN_Class_t *ScDyn, const double Tcmd[3], const double Mcmd[3],
+                      const double Bvb[3], double Dt);
+
+
+#endif /* _sc_dyn_ */
@@ -0,0 +1,139 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Convert a JSON control parameter table to a binary table image
+**
+**  Notes:
+**    1. The JSON file is loaded with the flight table load callback so it
+**       goes through the same parsing and validation as a Load Table
+**       command. It must contain every table object.
+**    2. The image is loaded back through the same callback and its data is
+**       compared with the JSON load before the tool reports success.
+**    3. The image is written in the host's byte order. It can only be
+**       loaded by a processor with the same byte order.
+**    4. Usage: bc42_ctrl_tblimg [-t tables dir] [-o image file] [-v] json_file
+**
+*/
+
+/*
+** Includes
+*/
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "host_app.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define TBLIMG_DEF_OUT_FILE  "bc42_ctrl_prm.tbl"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static HOST_APP_Class_t  HostApp;
+static CTRL42_TBL_Img_t  Img;
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   const char *TablesDir = NULL;
+   const char *OutFilename = TBLIMG_DEF_OUT_FILE;
+   const char *JsonFilename;
+   CTRL42_TBL_Class_t *Tbl = &HostApp.Ctrl42.Tbl;
+   FILE   *OutFile;
+   bool    WriteErr;
+   int     Opt;
+
+   while ((Opt = getopt(argc, argv, "t:o:v")) != -1)
+   {
+      switch (Opt)
+      {
+         case 't': TablesDir   = optarg; break;
+         case 'o': OutFilename = optarg; break;
+         case 'v': HOST_SetEventsVerbose(true); break;
+         default:  optind = argc + 1; break;
+      }
+   }
+
+   if (optind != argc - 1)
+   {
+      fprintf(stderr, "Usage: %s [-t tables dir] [-o image file] [-v] json_file\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   JsonFilename = argv[optind];
+
+   if (!HOST_APP_Constructor(&HostApp, TablesDir))
+   {
+      return EXIT_FAILURE;
+   }
+
+   if (!HOST_APP_LoadCtrlTblFile(&HostApp, JsonFilename))
+   {
+      fprintf(stderr, "%s was rejected by the table load, run with -v for the reason\n", JsonFilename);
+      return EXIT_FAILURE;
+   }
+
+   if (Tbl->LastLoadCnt != Tbl->JsonObjCnt)
+   {
+      fprintf(stderr, "%s only contains %u of %u table objects\n", JsonFilename,
+              (unsigned int)Tbl->LastLoadCnt, (unsigned int)Tbl->JsonObjCnt);
+      return EXIT_FAILURE;
+   }
+
+   CTRL42_TBL_InitImg(&Img, CTRL42_TBL_GetNewestData(Tbl));
+
+   OutFile = fopen(OutFilename, "wb");
+   if (OutFile == NULL)
+   {
+      fprintf(stderr, "Error creating %s\n", OutFilename);
+      return EXIT_FAILURE;
+   }
+   WriteErr  = (fwrite(&Img, sizeof(CTRL42_TBL_Img_t), 1, OutFile) != 1);
+   WriteErr |= (fclose(OutFile) != 0);
+
+   if (WriteErr)
+   {
+      fprintf(stderr, "Error writing %s\n", OutFilename);
+      return EXIT_FAILURE;
+   }
+
+   if (!HOST_APP_LoadCtrlTblFile(&HostApp, OutFilename) ||
+       memcmp(CTRL42_TBL_GetNewestData(Tbl), &Img.Data, sizeof(CTRL42_TBL_Data_t)) != 0)
+   {
+      fprintf(stderr, "%s didn't load back to the JSON table data, run with -v for the reason\n", OutFilename);
+      return EXIT_FAILURE;
+   }
+
+   printf("BC42_CTRL binary table image\n");
+   printf("   JSON table:   %s\n", JsonFilename);
+   printf("   Image:        %s (%u bytes)\n", OutFilename, (unsigned int)sizeof(CTRL42_TBL_Img_t));
+   printf("   Version:      %u\n", (unsigned int)Img.Hdr.Version);
+   printf("   Schema hash:  0x%08X\n", (unsigned int)Img.Hdr.SchemaHash);
+   printf("   Data CRC:     0x%08X\n", (unsigned int)Img.Hdr.DataCrc);
+
+   return EXIT_SUCCESS;
+
+} /* End main() */